@@ -382,6 +382,17 @@ Handheld {
             closeButtonColor: Material.foreground
         }
 
+        Button {
+            anchors {
+                horizontalCenter: identifyResults.horizontalCenter
+                bottom: identifyResults.bottom
+                margins: 8 * scaleFactor
+            }
+            visible: identifyResults.visible && identifyController.canFetchMorePopups
+            text: "More Results"
+            onClicked: identifyController.fetchMorePopups();
+        }
+
         Drawer {
             id: drawer
             width: parent.width
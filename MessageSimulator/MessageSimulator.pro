@@ -25,6 +25,8 @@ INCLUDEPATH += \
     $$PWD/../Shared/utilities
 
 HEADERS += \
+    $$PWD/../Shared/utilities/DataCapture.h \
+    $$PWD/../Shared/utilities/DataCaptureReader.h \
     $$PWD/../Shared/utilities/DataSender.h \
     MessageSimulatorController.h \
     AbstractMessageParser.h \
@@ -34,6 +36,8 @@ HEADERS += \
     GeoMessageParser.h
 
 SOURCES += main.cpp \
+    $$PWD/../Shared/utilities/DataCapture.cpp \
+    $$PWD/../Shared/utilities/DataCaptureReader.cpp \
     $$PWD/../Shared/utilities/DataSender.cpp \
     AbstractMessageParser.cpp \
     CoTMessageParser.cpp \
@@ -18,6 +18,7 @@
 
 // example app headers
 #include "AbstractMessageParser.h"
+#include "DataCaptureReader.h"
 #include "DataSender.h"
 #include "SimulatedMessage.h"
 #include "SimulatedMessageListModel.h"
@@ -25,6 +26,9 @@
 // Qt headers
 #include <QSettings>
 
+// replayed datagrams sent before yielding to the event loop when running as fast as possible
+static const int s_replayBatchSize = 64;
+
 MessageSimulatorController::MessageSimulatorController(QObject* parent) :
   QObject(parent),
   m_dataSender(new Dsa::DataSender(this)),
@@ -87,6 +91,9 @@ MessageSimulatorController::MessageSimulatorController(QObject* parent) :
     m_messages->append(simulatedMessage);
   });
 
+  m_replayTimer.setSingleShot(true);
+  connect(&m_replayTimer, &QTimer::timeout, this, &MessageSimulatorController::replayDue);
+
   // load settings for the app if they exist
   loadSettings();
 }
@@ -127,6 +134,28 @@ int MessageSimulatorController::port() const
   return m_port;
 }
 
+QString MessageSimulatorController::multicastGroup() const
+{
+  return m_multicastGroup;
+}
+
+void MessageSimulatorController::setMulticastGroup(const QString& multicastGroup)
+{
+  if (m_multicastGroup == multicastGroup)
+    return;
+
+  m_multicastGroup = multicastGroup;
+
+  emit multicastGroupChanged();
+}
+
+// messages are sent to the multicast group if one is set, otherwise they are broadcast
+QHostAddress MessageSimulatorController::destinationAddress() const
+{
+  const QHostAddress multicastGroup(m_multicastGroup.trimmed());
+  return multicastGroup.isMulticast() ? multicastGroup : QHostAddress(QHostAddress::Broadcast);
+}
+
 void MessageSimulatorController::setMessageFrequency(float messageFrequency)
 {
   const auto previousMessageFrequency = m_messageFrequency;
@@ -137,7 +166,7 @@ void MessageSimulatorController::setMessageFrequency(float messageFrequency)
     if (m_timer.isActive())
       m_timer.stop();
 
-    if (m_simulationState == SimulationState::Running)
+    if (m_simulationState == SimulationState::Running && !m_replaying)
     {
       float messageFrequencyInSeconds = (timeUnitToSeconds(m_timeUnit) / messageFrequency);
       constexpr float millisecondsMultiplier = 1000.0f;
@@ -194,14 +223,58 @@ QAbstractListModel* MessageSimulatorController::messages() const
   return m_messages;
 }
 
+MessageSimulatorController::ReplayTiming MessageSimulatorController::replayTiming() const
+{
+  return m_replayTiming;
+}
+
+void MessageSimulatorController::setReplayTiming(ReplayTiming replayTiming)
+{
+  if (m_replayTiming == replayTiming)
+    return;
+
+  m_replayTiming = replayTiming;
+
+  // keep replaying from the current datagram with the new timing
+  if (m_replaying)
+    restartReplayClock();
+
+  emit replayTimingChanged();
+}
+
+float MessageSimulatorController::replaySpeed() const
+{
+  return m_replaySpeed;
+}
+
+void MessageSimulatorController::setReplaySpeed(float replaySpeed)
+{
+  if (replaySpeed <= 0 || m_replaySpeed == replaySpeed)
+    return;
+
+  m_replaySpeed = replaySpeed;
+
+  if (m_replaying)
+    restartReplayClock();
+
+  emit replaySpeedChanged();
+}
+
 void MessageSimulatorController::startSimulation(const QUrl& file)
 {
   // first stop the simulation if it was already running
   stopSimulation();
 
-  // create UDP connection to broadcast address with specified port
+  // captured traffic is replayed with its recorded timing and ports
+  if (Dsa::DataCaptureReader::isCaptureFile(file.toLocalFile()))
+  {
+    startReplay(file);
+    return;
+  }
+
+  // create UDP connection to broadcast address (or multicast group) with specified port
   m_udpSocket = new QUdpSocket(this);
-  m_udpSocket->connectToHost(QHostAddress::Broadcast, m_port, QIODevice::WriteOnly);
+  m_udpSocket->connectToHost(destinationAddress(), m_port, QIODevice::WriteOnly);
   m_dataSender->setDevice(m_udpSocket);
 
   if (m_messageParser)
@@ -241,6 +314,7 @@ void MessageSimulatorController::pauseSimulation()
 {
   m_simulationState = SimulationState::Paused;
   m_timer.stop();
+  m_replayTimer.stop();
 
   emit simulationStateChanged();
 }
@@ -248,7 +322,16 @@ void MessageSimulatorController::pauseSimulation()
 void MessageSimulatorController::resumeSimulation()
 {
   m_simulationState = SimulationState::Running;
-  setMessageFrequency(m_messageFrequency);
+  if (m_replaying)
+  {
+    // carry on from the next datagram rather than catching up on the pause
+    restartReplayClock();
+    m_replayTimer.start(0);
+  }
+  else
+  {
+    setMessageFrequency(m_messageFrequency);
+  }
 
   emit simulationStateChanged();
 }
@@ -260,8 +343,15 @@ void MessageSimulatorController::stopSimulation()
     return;
 
   m_timer.stop();
+  m_replayTimer.stop();
   m_simulationState = SimulationState::Stopped;
 
+  if (m_replaying)
+  {
+    m_captureReader->close();
+    m_replaying = false;
+  }
+
   if (m_udpSocket)
   {
     if (m_udpSocket->isOpen())
@@ -284,9 +374,12 @@ void MessageSimulatorController::saveSettings()
   QSettings settings;
   settings.setValue("simulationFile", m_simulationFile);
   settings.setValue("port", m_port);
+  settings.setValue("multicastGroup", m_multicastGroup);
   settings.setValue("messageFrequency", m_messageFrequency);
   settings.setValue("timeUnit", fromTimeUnit(m_timeUnit));
   settings.setValue("loop", m_simulationLooped);
+  settings.setValue("replayTiming", static_cast<int>(m_replayTiming));
+  settings.setValue("replaySpeed", m_replaySpeed);
 }
 
 void MessageSimulatorController::loadSettings()
@@ -294,9 +387,12 @@ void MessageSimulatorController::loadSettings()
   QSettings settings;
   setSimulationFile(settings.value("simulationFile", QUrl()).toUrl());
   setPort(settings.value("port", -1).toInt());
+  setMulticastGroup(settings.value("multicastGroup", QString()).toString());
   setMessageFrequency(settings.value("messageFrequency", 1.0f).toFloat());
   setTimeUnit(toTimeUnit(settings.value("timeUnit", "seconds").toString()));
   setSimulationLooped(settings.value("loop", true).toBool());
+  setReplayTiming(static_cast<ReplayTiming>(settings.value("replayTiming", static_cast<int>(ReplayTiming::Original)).toInt()));
+  setReplaySpeed(settings.value("replaySpeed", 1.0f).toFloat());
 }
 
 QString MessageSimulatorController::fromTimeUnit(TimeUnit timeUnit)
@@ -342,3 +438,103 @@ float MessageSimulatorController::timeUnitToSeconds(TimeUnit timeUnit)
 
   return 1.0f; // default to seconds
 }
+
+void MessageSimulatorController::startReplay(const QUrl& file)
+{
+  // the socket is not connected, as each datagram is sent to the port it was captured on
+  m_udpSocket = new QUdpSocket(this);
+  m_replayAddress = destinationAddress();
+
+  if (!m_captureReader)
+    m_captureReader = new Dsa::DataCaptureReader(this);
+
+  if (!m_captureReader->open(file.toLocalFile()) || !m_captureReader->readNext())
+  {
+    m_captureReader->close();
+    delete m_udpSocket;
+    m_udpSocket = nullptr;
+
+    emit errorOccurred(tr("Capture file contains no messages"));
+    return;
+  }
+
+  // replayed datagrams are not listed, as they may be far too many to show
+  m_messages->clear();
+
+  if (m_simulationFile != file)
+  {
+    m_simulationFile = file;
+
+    emit simulationFileChanged();
+  }
+
+  m_replaying = true;
+  m_simulationState = SimulationState::Running;
+  m_messagesSent = 0;
+  restartReplayClock();
+  m_replayTimer.start(0);
+
+  emit simulationStateChanged();
+
+  // save app settings for next time the app is launched
+  saveSettings();
+}
+
+void MessageSimulatorController::replayDue()
+{
+  int sent = 0;
+  while (m_simulationState == SimulationState::Running)
+  {
+    const qint64 delay = replayDelay();
+    if (delay > 0)
+    {
+      m_replayTimer.start(static_cast<int>(delay));
+      return;
+    }
+
+    if (m_udpSocket->writeDatagram(m_captureReader->data(), m_replayAddress, m_captureReader->port()) == -1)
+      emit errorOccurred(tr("Failed to send message"));
+    else
+      m_messagesSent++;
+
+    if (!m_captureReader->readNext())
+    {
+      // reached the end of the capture, so loop or end the replay
+      m_captureReader->reset();
+      if (!m_simulationLooped || !m_captureReader->readNext())
+      {
+        stopSimulation();
+        return;
+      }
+
+      restartReplayClock();
+    }
+
+    // yield to the event loop now and then so that the app stays responsive
+    if (++sent == s_replayBatchSize)
+    {
+      m_replayTimer.start(0);
+      return;
+    }
+  }
+}
+
+void MessageSimulatorController::restartReplayClock()
+{
+  // the current datagram is due now, and the following ones relative to it
+  m_replayOrigin = m_captureReader->timestamp();
+  m_replayClock.start();
+}
+
+qint64 MessageSimulatorController::replayDelay() const
+{
+  if (m_replayTiming == ReplayTiming::AsFastAsPossible)
+    return 0;
+
+  // timestamps are in microseconds since the capture started
+  const double speed = m_replayTiming == ReplayTiming::Scaled ? m_replaySpeed : 1.0;
+  const qint64 dueAt = static_cast<qint64>((m_captureReader->timestamp() - m_replayOrigin) / speed);
+  const qint64 now = m_replayClock.nsecsElapsed() / 1000;
+
+  return (dueAt - now) / 1000;
+}
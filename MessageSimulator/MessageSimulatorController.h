@@ -20,12 +20,14 @@
 
 // Qt headers
 #include <QAbstractListModel>
+#include <QElapsedTimer>
 #include <QObject>
 #include <QTimer>
 #include <QUdpSocket>
 #include <QUrl>
 
 namespace Dsa {
+class DataCaptureReader;
 class DataSender;
 }
 
@@ -39,10 +41,13 @@ class MessageSimulatorController : public QObject
   Q_PROPERTY(QUrl simulationFile READ simulationFile NOTIFY simulationFileChanged)
   Q_PROPERTY(SimulationState simulationState READ simulationState NOTIFY simulationStateChanged)
   Q_PROPERTY(int port READ port WRITE setPort NOTIFY portChanged)
+  Q_PROPERTY(QString multicastGroup READ multicastGroup WRITE setMulticastGroup NOTIFY multicastGroupChanged)
   Q_PROPERTY(bool simulationLooped READ isSimulationLooped WRITE setSimulationLooped NOTIFY simulationLoopedChanged)
   Q_PROPERTY(float messageFrequency READ messageFrequency WRITE setMessageFrequency NOTIFY messageFrequencyChanged)
   Q_PROPERTY(TimeUnit timeUnit READ timeUnit WRITE setTimeUnit NOTIFY timeUnitChanged)
   Q_PROPERTY(QAbstractListModel* messages READ messages NOTIFY messagesChanged)
+  Q_PROPERTY(ReplayTiming replayTiming READ replayTiming WRITE setReplayTiming NOTIFY replayTimingChanged)
+  Q_PROPERTY(float replaySpeed READ replaySpeed WRITE setReplaySpeed NOTIFY replaySpeedChanged)
 
 public:
   enum class TimeUnit
@@ -59,8 +64,16 @@ public:
     Paused = 2
   };
 
+  enum class ReplayTiming
+  {
+    Original = 0,
+    Scaled = 1,
+    AsFastAsPossible = 2
+  };
+
   Q_ENUM(TimeUnit)
   Q_ENUM(SimulationState)
+  Q_ENUM(ReplayTiming)
 
   explicit MessageSimulatorController(QObject* parent = nullptr);
   ~MessageSimulatorController();
@@ -71,6 +84,9 @@ public:
   void setPort(int port);
   int port() const;
 
+  QString multicastGroup() const;
+  void setMulticastGroup(const QString& multicastGroup);
+
   void setMessageFrequency(float messageFrequency);
   float messageFrequency() const;
 
@@ -84,6 +100,12 @@ public:
 
   QAbstractListModel* messages() const;
 
+  ReplayTiming replayTiming() const;
+  void setReplayTiming(ReplayTiming replayTiming);
+
+  float replaySpeed() const;
+  void setReplaySpeed(float replaySpeed);
+
   Q_INVOKABLE void startSimulation(const QUrl& file);
   Q_INVOKABLE void pauseSimulation();
   Q_INVOKABLE void resumeSimulation();
@@ -98,20 +120,29 @@ signals:
   void simulationFileChanged();
   void simulationStateChanged();
   void portChanged();
+  void multicastGroupChanged();
   void simulationLoopedChanged();
   void messageFrequencyChanged();
   void timeUnitChanged();
   void messagesChanged();
+  void replayTimingChanged();
+  void replaySpeedChanged();
   void errorOccurred(const QString& error);
 
 private:
   Q_DISABLE_COPY(MessageSimulatorController)
 
   void saveSettings();
+  QHostAddress destinationAddress() const;
   void loadSettings();
 
   static float timeUnitToSeconds(TimeUnit timeUnit);
 
+  void startReplay(const QUrl& file);
+  void replayDue();
+  void restartReplayClock();
+  qint64 replayDelay() const;
+
   Dsa::DataSender* m_dataSender = nullptr;
   AbstractMessageParser* m_messageParser = nullptr;
   SimulatedMessageListModel* m_messages = nullptr;
@@ -119,9 +150,19 @@ private:
   QUdpSocket* m_udpSocket = nullptr;
   QTimer m_timer;
 
+  Dsa::DataCaptureReader* m_captureReader = nullptr;
+  QTimer m_replayTimer;
+  QElapsedTimer m_replayClock;
+  qint64 m_replayOrigin = 0;
+  bool m_replaying = false;
+  QHostAddress m_replayAddress;
+  ReplayTiming m_replayTiming = ReplayTiming::Original;
+  float m_replaySpeed = 1.0f;
+
   QUrl m_simulationFile;
 
   int m_port = -1;
+  QString m_multicastGroup;
   float m_messageFrequency = 1;
   qint64 m_messagesSent = 0;
 
@@ -65,7 +65,7 @@ Rectangle {
                 }
                 height: chooseFileBtn.height
 
-                placeholderText: "please choose a message file (.xml)"
+                placeholderText: "please choose a message file (.xml) or capture file (.dsacap)"
                 text: loader.fileUrl.toString() !== "" ? loader.fileUrl : messageSimulatorController.simulationFile
                 readOnly: true
 
@@ -119,6 +119,49 @@ Rectangle {
             }
         }
 
+        Rectangle {
+            width: settingsPage.width
+            height: 50 * scaleFactor
+            color: "steelblue"
+            radius: 4 * scaleFactor
+
+            Label {
+                id: multicastGroupLabel
+                anchors {
+                    top: parent.top
+                    bottom: parent.bottom
+                    left: parent.left
+                    margins: 8 * scaleFactor
+                }
+                width: 64 * scaleFactor
+
+                text: "multicast\ngroup"
+                font.bold: true
+                color: "white"
+                horizontalAlignment: Text.AlignHCenter
+                verticalAlignment: Text.AlignVCenter
+            }
+
+            TextField {
+                id: multicastGroupEdit
+
+                anchors {
+                    top: parent.top
+                    left: multicastGroupLabel.right
+                    margins: 8 * scaleFactor
+                    right: parent.right
+                }
+                enabled: messageSimulatorController.simulationState === MessageSimulatorController.Stopped
+                text: messageSimulatorController.multicastGroup
+                placeholderText: "none (broadcast)"
+                height: multicastGroupLabel.height
+
+                onTextChanged: {
+                    messageSimulatorController.multicastGroup = text
+                }
+            }
+        }
+
         Rectangle {
             width: settingsPage.width
             height: 50 * scaleFactor
@@ -242,11 +285,93 @@ Rectangle {
                 }
             }
         }
+
+        Rectangle {
+            width: settingsPage.width
+            height: 50 * scaleFactor
+            color: "steelblue"
+            radius: 4 * scaleFactor
+
+            Label {
+                id: replayLabel
+                anchors {
+                    top: parent.top
+                    bottom: parent.bottom
+                    left: parent.left
+                    margins: 8 * scaleFactor
+                }
+                width: 64 * scaleFactor
+
+                text: "replay\ntiming"
+                font.bold: true
+                color: "white"
+                horizontalAlignment: Text.AlignHCenter
+                verticalAlignment: Text.AlignVCenter
+            }
+
+            ComboBox {
+                id: replayTimingOptions
+                anchors {
+                    left: replayLabel.right
+                    verticalCenter: parent.verticalCenter
+                    margins: 8 * scaleFactor
+                }
+                height: 30 * scaleFactor
+                width: 140 * scaleFactor
+                enabled: messageSimulatorController.simulationState === MessageSimulatorController.Stopped
+
+                // in the order of MessageSimulatorController.ReplayTiming
+                model: [qsTr("original"), qsTr("scaled"), qsTr("as fast as possible")]
+                currentIndex: messageSimulatorController.replayTiming
+
+                onActivated: {
+                    messageSimulatorController.replayTiming = index;
+                }
+            }
+
+            Slider {
+                id: replaySpeedSlider
+                anchors {
+                    left: replayTimingOptions.right
+                    right: replaySpeedLabel.left
+                    verticalCenter: parent.verticalCenter
+                    margins: 8 * scaleFactor
+                }
+                enabled: messageSimulatorController.replayTiming === MessageSimulatorController.Scaled
+                orientation: Qt.Horizontal
+                from: 0.25
+                to: 16
+                value: messageSimulatorController.replaySpeed
+                stepSize: 0.25
+                snapMode: Slider.SnapAlways
+
+                onValueChanged: {
+                    messageSimulatorController.replaySpeed = value;
+                }
+            }
+
+            Label {
+                id: replaySpeedLabel
+
+                anchors {
+                    right: parent.right
+                    verticalCenter: parent.verticalCenter
+                    margins: 8 * scaleFactor
+                }
+                width: 48 * scaleFactor
+
+                font.bold: true
+                color: "white"
+                text: qsTr("x") + replaySpeedSlider.value.toFixed(2)
+                horizontalAlignment: Text.AlignRight
+                verticalAlignment: Text.AlignVCenter
+            }
+        }
     }
 
     XmlLoader {
         id: loader
-        supportedExtensions: ["xml"]
+        supportedExtensions: ["xml", "dsacap"]
     }
 }
 
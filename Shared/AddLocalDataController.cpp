@@ -23,6 +23,7 @@
 // example app headers
 #include "DataItemListModel.h"
 #include "DsaUtility.h"
+#include "ElevationCache.h"
 #include "MarkupLayer.h"
 
 // toolkit headers
@@ -69,6 +70,8 @@ namespace Dsa
 
 const QString AddLocalDataController::LOCAL_DATAPATHS_PROPERTYNAME = "LocalDataPaths";
 const QString AddLocalDataController::DEFAULT_ELEVATION_PROPERTYNAME = "DefaultElevationSource";
+const QString AddLocalDataController::ELEVATION_CACHE_RESOLUTION_PROPERTYNAME = "ElevationCacheResolution";
+const QString AddLocalDataController::ELEVATION_CACHE_RESOLUTION_DEFAULT = "default";
 
 const QString AddLocalDataController::s_allData = QStringLiteral("All Data (*.geodatabase *.tpk *.shp *.gpkg *.slpk *.img *.tif *.tiff *.i1, *.dt0 *.dt1 *.dt2 *.tc2 *.geotiff *.hr1 *.jpg *.jpeg *.jp2 *.ntf *.png *.i21 *.ovr *.markup *.sid *.kml *.kmz)");
 const QString AddLocalDataController::s_rasterData = QStringLiteral("Raster Files (*.img *.tif *.tiff *.I1, *.dt0 *.dt1 *.dt2 *.tc2 *.geotiff *.hr1 *.jpg *.jpeg *.jp2 *.ntf *.png *.i21 *.ovr *.sid)");
@@ -250,9 +253,7 @@ void AddLocalDataController::createElevationSourceFromTpk(const QString& path)
 
       connect(source, &ArcGISTiledElevationSource::errorOccurred, this, &AddLocalDataController::errorOccurred);
 
-      auto scene = Toolkit::ToolResourceProvider::instance()->scene();
-      if (scene)
-        scene->baseSurface()->elevationSources()->append(source);
+      addElevationSourceToScene(source, tileCache->path());
 
       emit elevationSourceSelected(source);
       emit propertyChanged(DEFAULT_ELEVATION_PROPERTYNAME, tileCache->path());
@@ -271,13 +272,34 @@ void AddLocalDataController::createElevationSourceFromRasters(const QStringList&
 
   connect(source, &RasterElevationSource::errorOccurred, this, &AddLocalDataController::errorOccurred);
 
-  auto scene = Toolkit::ToolResourceProvider::instance()->scene();
-  if (scene)
-    scene->baseSurface()->elevationSources()->append(source);
+  addElevationSourceToScene(source, paths.isEmpty() ? QString() : paths.first());
 
   emit elevationSourceSelected(source);
 }
 
+/*!
+ \internal
+
+ Appends \a source to the Scene's base surface and invalidates the shared \l ElevationCache.
+
+ If a cache resolution has been configured for the data \a path, it is registered for the source.
+*/
+void AddLocalDataController::addElevationSourceToScene(ElevationSource* source, const QString& path)
+{
+  auto scene = Toolkit::ToolResourceProvider::instance()->scene();
+  if (!scene)
+    return;
+
+  scene->baseSurface()->elevationSources()->append(source);
+
+  // cached elevations may have been sampled from the old set of sources
+  const QVariant resolution = m_elevationCacheResolutions.value(path);
+  if (resolution.isValid())
+    ElevationCache::instance()->setSourceResolution(source, resolution.toDouble());
+  else
+    ElevationCache::instance()->invalidate();
+}
+
 /*!
  \brief Adds the the markup from the provided path as a MarkupLayer.
 
@@ -863,6 +885,12 @@ QString AddLocalDataController::toolName() const
 */
 void AddLocalDataController::setProperties(const QVariantMap& properties)
 {
+  // the elevation cache resolution (in meters) can be configured for each elevation data path
+  m_elevationCacheResolutions = properties.value(ELEVATION_CACHE_RESOLUTION_PROPERTYNAME).toMap();
+  const QVariant defaultResolution = m_elevationCacheResolutions.value(ELEVATION_CACHE_RESOLUTION_DEFAULT);
+  if (defaultResolution.isValid())
+    ElevationCache::instance()->setDefaultResolution(defaultResolution.toDouble());
+
   const QStringList filePaths = properties[LOCAL_DATAPATHS_PROPERTYNAME].toStringList();
   if (filePaths.empty())
     return;
@@ -83,6 +83,7 @@ signals:
 
 private:
   QStringList determineFileFilters(const QString& fileType);
+  void addElevationSourceToScene(Esri::ArcGISRuntime::ElevationSource* source, const QString& path);
   QStringList fileFilterList() const { return m_fileFilterList; }
   static const QString allData() { return s_allData; }
   static const QString rasterData() { return s_rasterData; }
@@ -99,6 +100,7 @@ private:
   DataItemListModel* m_localDataModel;
   QStringList m_dataPaths;
   QStringList m_fileFilterList;
+  QVariantMap m_elevationCacheResolutions;
   static const QString s_allData;
   static const QString s_rasterData;
   static const QString s_geodatabaseData;
@@ -111,6 +113,8 @@ private:
   static const QString s_kmlData;
   static const QString LOCAL_DATAPATHS_PROPERTYNAME;
   static const QString DEFAULT_ELEVATION_PROPERTYNAME;
+  static const QString ELEVATION_CACHE_RESOLUTION_PROPERTYNAME;
+  static const QString ELEVATION_CACHE_RESOLUTION_DEFAULT;
 };
 
 } // Dsa
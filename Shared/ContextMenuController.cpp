@@ -22,11 +22,13 @@
 
 // example app headers
 #include "ObservationReportController.h"
+#include "ElevationCache.h"
 #include "FollowPositionController.h"
 #include "GraphicsOverlaysResultsManager.h"
 #include "IdentifyController.h"
 #include "LayerResultsManager.h"
 #include "LineOfSightController.h"
+#include "MessagesPickIndex.h"
 #include "ViewshedController.h"
 #include "GeoElementUtils.h"
 
@@ -151,9 +153,9 @@ void ContextMenuController::onMousePressedAndHeld(QMouseEvent& event)
     qDeleteAll(feats);
   m_contextFeatures.clear();
 
-  for(const auto& graphics : qAsConst(m_contextGraphics))
-    qDeleteAll(graphics);
+  // the graphics belong to their overlays, so they are only forgotten
   m_contextGraphics.clear();
+  m_contextGraphicObjects.clear();
 
   GeoView* geoView = Toolkit::ToolResourceProvider::instance()->geoView();
   if (!geoView)
@@ -167,6 +169,9 @@ void ContextMenuController::onMousePressedAndHeld(QMouseEvent& event)
   {
     m_screenToLocationTask = sceneView->screenToLocation(m_contextScreenPosition.x(), m_contextScreenPosition.y());
     m_contextBaseSurfaceLocation = sceneView->screenToBaseSurface(m_contextScreenPosition.x(), m_contextScreenPosition.y());
+
+    // share the base surface sample with other users of the elevation cache
+    ElevationCache::instance()->insert(m_contextBaseSurfaceLocation, m_contextBaseSurfaceLocation.z());
   }
   else
   {
@@ -179,8 +184,24 @@ void ContextMenuController::onMousePressedAndHeld(QMouseEvent& event)
     }
   }
 
-  // start tasks to determine whether a GeoElement was clicked on
-  m_identifyGraphicsTask = geoView->identifyGraphicsOverlays(m_contextScreenPosition.x(), m_contextScreenPosition.y(), 5.0, false, 1);
+  // pick the message graphics under the position from the client-side index, unless
+  // some could not be placed exactly
+  MessagesPickIndex* pickIndex = MessagesPickIndex::instance();
+  QList<MessagesPickIndex::PickResult> pickResults;
+  if (!pickIndex->hasApproximatePlacement(geoView))
+    pickResults = pickIndex->pick(geoView, m_contextScreenPosition, 5.0, 1);
+
+  if (!pickResults.isEmpty())
+  {
+    const MessagesPickIndex::PickResult& nearest = pickResults.first();
+    addContextGraphics(nearest.graphicsOverlay->overlayId(), QList<GeoElement*>{nearest.graphic});
+  }
+
+  // start tasks to determine whether a GeoElement was clicked on. The graphics overlays
+  // only need to be identified if no message graphic was picked
+  if (pickResults.isEmpty())
+    m_identifyGraphicsTask = geoView->identifyGraphicsOverlays(m_contextScreenPosition.x(), m_contextScreenPosition.y(), 5.0, false, 1);
+
   m_identifyFeaturesTask = geoView->identifyLayers(m_contextScreenPosition.x(), m_contextScreenPosition.y(), 5.0, false, 1);
 
   // accept the event to prevent it being used by other tools etc.
@@ -247,18 +268,13 @@ void ContextMenuController::onIdentifyGraphicsOverlaysCompleted(const QUuid& tas
     if (graphics.isEmpty())
       continue;
 
+    // the graphics are the overlay's own instances, so they stay with their owner
     QList<GeoElement*> geoElements;
-    auto gIt = graphics.begin();
-    auto gEnd = graphics.end();
-    for(; gIt != gEnd; ++gIt)
-    {
-      GeoElement* geoElement = *gIt;
-      GeoElementUtils::setParent(geoElement, this); // set the GeoElements to be managed by the tool
-      geoElements.append(geoElement);
-    }
+    for (Graphic* graphic : graphics)
+      geoElements.append(graphic);
 
     // add the geoElements to the context hash using the overlay id as the key
-    m_contextGraphics.insert(res->graphicsOverlay()->overlayId(), geoElements);
+    addContextGraphics(res->graphicsOverlay()->overlayId(), geoElements);
   }
 
   processGeoElements();
@@ -403,14 +419,15 @@ void ContextMenuController::processGeoElements()
       (m_identifyGraphicsTask.isValid() && !m_identifyGraphicsTask.isDone()))
     return;
 
-  if (m_contextFeatures.isEmpty() && m_contextGraphics.isEmpty())
+  const QHash<QString, QList<GeoElement*>> graphicsByTitle = contextGraphics();
+  if (m_contextFeatures.isEmpty() && graphicsByTitle.isEmpty())
     return;
 
   // if we have at least 1 GeoElement, we can identify
   addOption(IDENTIFY_OPTION);
 
   int pointGraphicsCount = 0;
-  for (const auto& geoElements : qAsConst(m_contextGraphics))
+  for (const auto& geoElements : graphicsByTitle)
   {
     for (GeoElement* geoElement : geoElements)
     {
@@ -442,6 +459,47 @@ void ContextMenuController::processGeoElements()
   }
 }
 
+/*!
+  \internal
+
+  Adds \a graphics to the current context under \a title.
+
+  Graphics picked or identified from the graphics overlays are still owned by their
+  overlay and may be removed (e.g. when they expire) while the context is shown, so
+  each is tracked with a guard.
+ */
+void ContextMenuController::addContextGraphics(const QString& title, const QList<GeoElement*>& graphics)
+{
+  for (GeoElement* graphic : graphics)
+    m_contextGraphicObjects.insert(graphic, GeoElementUtils::toQObject(graphic));
+
+  m_contextGraphics.insert(title, graphics);
+}
+
+/*!
+  \internal
+
+  Returns the graphics of the current context which have not since been destroyed.
+ */
+QHash<QString, QList<GeoElement*>> ContextMenuController::contextGraphics() const
+{
+  QHash<QString, QList<GeoElement*>> graphicsByTitle;
+  for (auto it = m_contextGraphics.cbegin(); it != m_contextGraphics.cend(); ++it)
+  {
+    QList<GeoElement*> graphics;
+    for (GeoElement* graphic : it.value())
+    {
+      if (m_contextGraphicObjects.value(graphic))
+        graphics.append(graphic);
+    }
+
+    if (!graphics.isEmpty())
+      graphicsByTitle.insert(it.key(), graphics);
+  }
+
+  return graphicsByTitle;
+}
+
 /*!
   \brief Returns the geographic location for the current context.
  */
@@ -497,7 +555,7 @@ void ContextMenuController::selectOption(const QString& option)
     if (!identifyTool)
       return;
 
-    auto combinedGeoElementsByTitle = m_contextGraphics;
+    auto combinedGeoElementsByTitle = contextGraphics();
     combinedGeoElementsByTitle.unite(m_contextFeatures);
     identifyTool->showPopups(combinedGeoElementsByTitle);
   }
@@ -519,7 +577,8 @@ void ContextMenuController::selectOption(const QString& option)
       return;
 
     // follow the 1st point graphic (should be only 1)
-    for(const auto& geoElements : qAsConst(m_contextGraphics))
+    const QHash<QString, QList<GeoElement*>> graphicsByTitle = contextGraphics();
+    for(const auto& geoElements : graphicsByTitle)
     {
       for (GeoElement* geoElement : geoElements)
       {
@@ -565,7 +624,7 @@ void ContextMenuController::selectOption(const QString& option)
       }
     };
 
-    losFunc(m_contextGraphics);
+    losFunc(contextGraphics());
     losFunc(m_contextFeatures);
   }
   else if (option == OBSERVATION_REPORT_OPTION)
@@ -26,6 +26,7 @@
 
 // Qt headers
 #include <QMouseEvent>
+#include <QPointer>
 #include <QStringListModel>
 
 namespace Esri {
@@ -99,6 +100,8 @@ private:
   void cancelTasks();
   void cancelIdentifyTasks();
   void processGeoElements();
+  void addContextGraphics(const QString& title, const QList<Esri::ArcGISRuntime::GeoElement*>& graphics);
+  QHash<QString, QList<Esri::ArcGISRuntime::GeoElement*>> contextGraphics() const;
 
   bool m_contextActive = false;
   QPoint m_contextScreenPosition{0, 0};
@@ -112,6 +115,7 @@ private:
   Esri::ArcGISRuntime::TaskWatcher m_screenToLocationTask;
   QHash<QString, QList<Esri::ArcGISRuntime::GeoElement*>> m_contextFeatures;
   QHash<QString, QList<Esri::ArcGISRuntime::GeoElement*>> m_contextGraphics;
+  QHash<Esri::ArcGISRuntime::GeoElement*, QPointer<QObject>> m_contextGraphicObjects;
 };
 
 } // Dsa
@@ -354,6 +354,7 @@ void DsaController::writeDefaultMessageFeeds()
   friendlyTracksLandJson.insert(MessageFeedConstants::MESSAGE_FEEDS_RENDERER, QStringLiteral("mil2525c"));
   friendlyTracksLandJson.insert(MessageFeedConstants::MESSAGE_FEEDS_THUMBNAIL, QStringLiteral("friendlytracks.png"));
   friendlyTracksLandJson.insert(MessageFeedConstants::MESSAGE_FEEDS_PLACEMENT, QStringLiteral("draped"));
+  friendlyTracksLandJson.insert(MessageFeedConstants::MESSAGE_FEEDS_TRAIL_LENGTH, 20);
   messageFeedsJson.append(friendlyTracksLandJson);
 
   QJsonObject friendlyTracksAirJson;
@@ -362,6 +363,7 @@ void DsaController::writeDefaultMessageFeeds()
   friendlyTracksAirJson.insert(MessageFeedConstants::MESSAGE_FEEDS_RENDERER, QStringLiteral("mil2525c"));
   friendlyTracksAirJson.insert(MessageFeedConstants::MESSAGE_FEEDS_THUMBNAIL, QStringLiteral("friendlytracks-air.png"));
   friendlyTracksAirJson.insert(MessageFeedConstants::MESSAGE_FEEDS_PLACEMENT, QStringLiteral("absolute"));
+  friendlyTracksAirJson.insert(MessageFeedConstants::MESSAGE_FEEDS_TRAIL_LENGTH, 20);
   messageFeedsJson.append(friendlyTracksAirJson);
 
   QJsonObject spotRepJson;
@@ -436,6 +438,9 @@ void DsaController::createDefaultSettings()
   writeDefaultLocalDataPaths();
   m_dsaSettings["DefaultBasemap"] = QStringLiteral("topographic");
   m_dsaSettings["DefaultElevationSource"] = QString("%1/CaDEM.tpk").arg(m_dsaSettings["ElevationDirectory"].toString());
+  QJsonObject elevationCacheJson;
+  elevationCacheJson.insert(QStringLiteral("default"), 10.0);
+  m_dsaSettings[QStringLiteral("ElevationCacheResolution")] = elevationCacheJson;
   m_dsaSettings["GpxFile"] = QString("%1/MontereyMounted.gpx").arg(m_dsaSettings["SimulationDirectory"].toString());
   m_dsaSettings["SimulateLocation"] = QStringLiteral("true");
   writeDefaultMessageFeeds();
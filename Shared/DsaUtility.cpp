@@ -25,6 +25,9 @@
 #include <QStandardPaths>
 #include <QtMath>
 
+// STL headers
+#include <cmath>
+
 using namespace Esri::ArcGISRuntime;
 
 namespace Dsa {
@@ -65,19 +68,40 @@ Point DsaUtility::montereyCA()
   return Point(-121.9, 36.6, SpatialReference::wgs84());
 }
 
+// writes the Cartesian coordinates of the lat/long \a point, in double precision
+static void toCartesian(const Point& point, double& x, double& y, double& z)
+{
+  // convert degrees (lat/long) to radians
+  constexpr double degreesToRadians = M_PI/180.0;
+  const double xRadians = point.x() * degreesToRadians;
+  const double yRadians = point.y() * degreesToRadians;
+
+  // convert to cartesian coords
+  constexpr double earthRadius = 6378137.0;
+  const double radius = point.z() + earthRadius;
+  const double radCosLat = radius * std::cos(yRadians);
+
+  x = radCosLat * std::sin(xRadians);
+  y = radius * std::sin(yRadians);
+  z = radCosLat * std::cos(xRadians);
+}
+
 /*!
   \brief Returns the distance in meters between the \a from and \a to points.
 
+  The distance is computed in double precision; at the magnitude of the earth's
+  radius a \c float only resolves about half a meter.
+
   \note Assumes both points are in the same spatial reference.
  */
 double DsaUtility::distance3D(const Point& from, const Point& to)
 {
-  const QVector3D fromCartesian = toCartesianPoint(from);
-  const QVector3D toCartesian = toCartesianPoint(to);
-
-  const QVector3D result(fromCartesian - toCartesian);
+  double fromX = 0.0, fromY = 0.0, fromZ = 0.0;
+  double toX = 0.0, toY = 0.0, toZ = 0.0;
+  toCartesian(from, fromX, fromY, fromZ);
+  toCartesian(to, toX, toY, toZ);
 
-  return result.length();
+  return std::sqrt((fromX - toX) * (fromX - toX) + (fromY - toY) * (fromY - toY) + (fromZ - toZ) * (fromZ - toZ));
 }
 
 /*!
@@ -85,17 +109,10 @@ double DsaUtility::distance3D(const Point& from, const Point& to)
  */
 QVector3D DsaUtility::toCartesianPoint(const Point& point)
 {
-  // convert degrees (lat/long) to radians
-  constexpr double degreesToRadians = M_PI/180.0;
-  const double xRadians = point.x() * degreesToRadians;
-  const double yRadians = point.y() * degreesToRadians;
-
-  // convert to cartesian coords
-  constexpr double earthRadius = 6378137.0;
-  const double radius = point.z() + earthRadius;
-  const double radCosLat = radius * std::cos(yRadians);
+  double x = 0.0, y = 0.0, z = 0.0;
+  toCartesian(point, x, y, z);
 
-  return QVector3D(radCosLat * std::sin(xRadians), radius * std::sin(yRadians), radCosLat * std::cos(xRadians));
+  return QVector3D(x, y, z);
 }
 
 } // Dsa
@@ -0,0 +1,364 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+// PCH header
+#include "pch.hpp"
+
+#include "ElevationCache.h"
+
+// toolkit headers
+#include "ToolResourceProvider.h"
+
+// C++ API headers
+#include "ElevationSource.h"
+#include "ElevationSourceListModel.h"
+#include "GeometryEngine.h"
+#include "Point.h"
+#include "Scene.h"
+#include "Surface.h"
+
+// Qt headers
+#include <QtMath>
+
+// STL headers
+#include <algorithm>
+#include <cmath>
+
+using namespace Esri::ArcGISRuntime;
+
+namespace Dsa {
+
+/*!
+  \class Dsa::ElevationCache
+  \inmodule Dsa
+  \inherits QObject
+  \brief A shared cache of elevation values sampled from the Scene's base
+  \l Esri::ArcGISRuntime::Surface.
+
+  Locations are quantized onto a grid of square cells, so that nearby requests
+  (for example consecutive fixes from a slow moving vehicle) share a single
+  terrain sample. The size of a cell is the finest resolution registered for the
+  elevation sources of the surface, or \l defaultResolution if none are registered.
+
+  The least recently used cells are evicted once \l maxEntries is reached.
+
+  Callers should first test \l cachedElevation and only call \l requestElevation
+  on a miss. The result of a request is reported through \l elevationCompleted.
+ */
+
+/*!
+  \brief Static method to return a singleton instance of the cache.
+ */
+ElevationCache* ElevationCache::instance()
+{
+  static ElevationCache s_instance;
+
+  return &s_instance;
+}
+
+/*!
+  \brief Constructor taking an optional \a parent.
+ */
+ElevationCache::ElevationCache(QObject* parent):
+  QObject(parent),
+  m_cache(1024)
+{
+}
+
+/*!
+  \brief Destructor.
+ */
+ElevationCache::~ElevationCache()
+{
+}
+
+/*!
+  \brief Returns whether an elevation is cached for the cell containing \a location.
+
+  If found, the value is written to \a elevation. Every call updates the
+  hit/miss counters.
+ */
+bool ElevationCache::cachedElevation(const Point& location, double& elevation)
+{
+  if (!currentSurface() || location.isEmpty())
+    return false;
+
+  const double* cached = m_cache.object(cellKey(location));
+  if (!cached)
+  {
+    ++m_misses;
+    return false;
+  }
+
+  ++m_hits;
+  elevation = *cached;
+  return true;
+}
+
+/*!
+  \brief Returns whether an elevation is cached for the cell containing \a location,
+  without updating the hit/miss counters.
+
+  If found, the value is written to \a elevation. This is intended for callers which
+  sample many locations in bulk, so that they do not skew the counters.
+ */
+bool ElevationCache::peekElevation(const Point& location, double& elevation)
+{
+  if (!currentSurface() || location.isEmpty())
+    return false;
+
+  const double* cached = m_cache.object(cellKey(location));
+  if (!cached)
+    return false;
+
+  elevation = *cached;
+  return true;
+}
+
+/*!
+  \brief Requests the elevation of the base surface at \a location.
+
+  Returns the id of the task which will report the result via \l elevationCompleted.
+  If a request for the same cell is already in progress, its id is returned and no
+  new task is started. Returns a null QUuid if there is no surface to sample.
+ */
+QUuid ElevationCache::requestElevation(const Point& location)
+{
+  Surface* surface = currentSurface();
+  if (!surface || location.isEmpty())
+    return QUuid();
+
+  const quint64 key = cellKey(location);
+  auto pendingIt = m_pendingKeys.constFind(key);
+  if (pendingIt != m_pendingKeys.constEnd())
+    return pendingIt.value();
+
+  const QUuid taskId = surface->locationToElevation(location).taskId();
+  if (!taskId.isNull())
+  {
+    m_pendingTasks.insert(taskId, key);
+    m_pendingKeys.insert(key, taskId);
+  }
+
+  return taskId;
+}
+
+/*!
+  \brief Adds a known \a elevation for the cell containing \a location.
+
+  This allows an elevation obtained by other means (for example a base surface
+  hit-test) to be shared with other users of the cache.
+ */
+void ElevationCache::insert(const Point& location, double elevation)
+{
+  if (location.isEmpty() || std::isnan(elevation))
+    return;
+
+  m_cache.insert(cellKey(location), new double(elevation));
+}
+
+/*!
+  \brief Clears all of the cached elevations.
+
+  This should be called whenever the elevation sources of the surface change.
+  Results of requests which are still in progress are discarded.
+ */
+void ElevationCache::invalidate()
+{
+  m_cache.clear();
+  m_pendingTasks.clear();
+  m_pendingKeys.clear();
+  emit invalidated();
+}
+
+/*!
+  \brief Returns the cell size, in meters, used when no elevation source has a
+  registered resolution.
+ */
+double ElevationCache::defaultResolution() const
+{
+  return m_defaultResolution;
+}
+
+/*!
+  \brief Sets the cell size, in meters, used when no elevation source has a
+  registered resolution to \a resolution.
+ */
+void ElevationCache::setDefaultResolution(double resolution)
+{
+  if (resolution <= 0.0 || resolution == m_defaultResolution)
+    return;
+
+  m_defaultResolution = resolution;
+  invalidate();
+}
+
+/*!
+  \brief Sets the cell size, in meters, to use for the elevation \a source to \a resolution.
+ */
+void ElevationCache::setSourceResolution(ElevationSource* source, double resolution)
+{
+  if (!source || resolution <= 0.0)
+    return;
+
+  m_sourceResolutions.insert(source, resolution);
+
+  connect(source, &ElevationSource::destroyed, this, [this, source]()
+  {
+    m_sourceResolutions.remove(source);
+  });
+
+  invalidate();
+}
+
+/*!
+  \brief Returns the maximum number of cells held by the cache.
+ */
+int ElevationCache::maxEntries() const
+{
+  return m_cache.maxCost();
+}
+
+/*!
+  \brief Sets the maximum number of cells held by the cache to \a maxEntries.
+ */
+void ElevationCache::setMaxEntries(int maxEntries)
+{
+  m_cache.setMaxCost(maxEntries);
+}
+
+/*!
+  \brief Returns the number of lookups which were answered from the cache.
+ */
+quint64 ElevationCache::hits() const
+{
+  return m_hits;
+}
+
+/*!
+  \brief Returns the number of lookups which were not answered from the cache.
+ */
+quint64 ElevationCache::misses() const
+{
+  return m_misses;
+}
+
+/*!
+  \internal
+
+  Returns the base surface of the current Scene, connecting to it if it has changed.
+ */
+Surface* ElevationCache::currentSurface()
+{
+  Scene* scene = Toolkit::ToolResourceProvider::instance()->scene();
+  Surface* surface = scene ? scene->baseSurface() : nullptr;
+  if (surface == m_surface)
+    return surface;
+
+  if (m_surface)
+    disconnect(m_surface, &Surface::locationToElevationCompleted, this, nullptr);
+
+  m_surface = surface;
+  invalidate();
+
+  if (!m_surface)
+    return nullptr;
+
+  connect(m_surface, &Surface::locationToElevationCompleted, this, [this](QUuid taskId, double elevation)
+  {
+    // ignore requests made by other users of the surface
+    auto findIt = m_pendingTasks.find(taskId);
+    if (findIt == m_pendingTasks.end())
+      return;
+
+    const quint64 key = findIt.value();
+    m_pendingTasks.erase(findIt);
+    m_pendingKeys.remove(key);
+
+    if (!std::isnan(elevation))
+      m_cache.insert(key, new double(elevation));
+
+    emit elevationCompleted(taskId, elevation);
+  });
+
+  return m_surface;
+}
+
+/*!
+  \internal
+
+  Returns the finest registered resolution of the current elevation sources.
+ */
+double ElevationCache::resolution()
+{
+  if (!m_surface || m_sourceResolutions.isEmpty())
+    return m_defaultResolution;
+
+  ElevationSourceListModel* sources = m_surface->elevationSources();
+  if (!sources)
+    return m_defaultResolution;
+
+  double finest = 0.0;
+  for (int i = 0; i < sources->size(); ++i)
+  {
+    auto findIt = m_sourceResolutions.constFind(sources->at(i));
+    if (findIt == m_sourceResolutions.constEnd())
+      continue;
+
+    if (finest == 0.0 || findIt.value() < finest)
+      finest = findIt.value();
+  }
+
+  return finest > 0.0 ? finest : m_defaultResolution;
+}
+
+/*!
+  \internal
+
+  Returns the key of the grid cell containing \a location.
+ */
+quint64 ElevationCache::cellKey(const Point& location)
+{
+  const Point wgs84 = location.spatialReference() == SpatialReference::wgs84() ?
+        location : GeometryEngine::project(location, SpatialReference::wgs84());
+
+  // convert the cell size from meters to degrees of latitude and longitude
+  constexpr double metersPerDegree = 111320.0;
+  const double cellSize = resolution();
+  const double latStep = cellSize / metersPerDegree;
+  const int row = static_cast<int>(std::floor(wgs84.y() / latStep));
+
+  // use the latitude of the row so that every location in the row has the same longitude step
+  constexpr double degreesToRadians = M_PI / 180.0;
+  const double cosLat = std::max(std::cos((row + 0.5) * latStep * degreesToRadians), 0.01);
+  const double lonStep = cellSize / (metersPerDegree * cosLat);
+  const int column = static_cast<int>(std::floor(wgs84.x() / lonStep));
+
+  return (static_cast<quint64>(static_cast<quint32>(column)) << 32) | static_cast<quint32>(row);
+}
+
+} // Dsa
+
+// Signal Documentation
+/*!
+  \fn void ElevationCache::elevationCompleted(const QUuid& taskId, double elevation);
+  \brief Signal emitted when the request with \a taskId completes with the resulting \a elevation.
+ */
+
+/*!
+  \fn void ElevationCache::invalidated();
+  \brief Signal emitted when the cached elevations are cleared.
+ */
@@ -0,0 +1,86 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef ELEVATIONCACHE_H
+#define ELEVATIONCACHE_H
+
+// Qt headers
+#include <QCache>
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QUuid>
+
+namespace Esri {
+namespace ArcGISRuntime {
+class ElevationSource;
+class Point;
+class Surface;
+}
+}
+
+namespace Dsa {
+
+class ElevationCache : public QObject
+{
+  Q_OBJECT
+
+public:
+  static ElevationCache* instance();
+
+  ~ElevationCache();
+
+  bool cachedElevation(const Esri::ArcGISRuntime::Point& location, double& elevation);
+  bool peekElevation(const Esri::ArcGISRuntime::Point& location, double& elevation);
+  QUuid requestElevation(const Esri::ArcGISRuntime::Point& location);
+  void insert(const Esri::ArcGISRuntime::Point& location, double elevation);
+
+  void invalidate();
+
+  double defaultResolution() const;
+  void setDefaultResolution(double resolution);
+  void setSourceResolution(Esri::ArcGISRuntime::ElevationSource* source, double resolution);
+
+  int maxEntries() const;
+  void setMaxEntries(int maxEntries);
+
+  quint64 hits() const;
+  quint64 misses() const;
+
+signals:
+  void elevationCompleted(const QUuid& taskId, double elevation);
+  void invalidated();
+
+private:
+  ElevationCache(QObject* parent = nullptr);
+
+  Esri::ArcGISRuntime::Surface* currentSurface();
+  double resolution();
+  quint64 cellKey(const Esri::ArcGISRuntime::Point& location);
+
+  QPointer<Esri::ArcGISRuntime::Surface> m_surface;
+  QCache<quint64, double> m_cache;
+  QHash<QUuid, quint64> m_pendingTasks;
+  QHash<quint64, QUuid> m_pendingKeys;
+  QHash<Esri::ArcGISRuntime::ElevationSource*, double> m_sourceResolutions;
+  double m_defaultResolution = 10.0;
+  quint64 m_hits = 0;
+  quint64 m_misses = 0;
+};
+
+} // Dsa
+
+#endif // ELEVATIONCACHE_H
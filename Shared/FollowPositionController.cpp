@@ -25,20 +25,44 @@
 #include "ToolResourceProvider.h"
 
 // C++ API headers
+#include "AttributeListModel.h"
 #include "GlobeCameraController.h"
+#include "Graphic.h"
+#include "GraphicListModel.h"
+#include "GraphicsOverlay.h"
 #include "MapView.h"
 #include "OrbitGeoElementCameraController.h"
 #include "SceneView.h"
+#include "SimpleMarkerSceneSymbol.h"
+#include "SimpleRenderer.h"
+
+// Qt headers
+#include <QQuickItem>
+#include <QQuickWindow>
+
+// STL headers
+#include <algorithm>
 
 using namespace Esri::ArcGISRuntime;
 
 namespace Dsa {
 
+static const QString s_headingAttribute{"heading"};
+
 /*!
   \class Dsa::FollowPositionController
   \inmodule Dsa
   \inherits Toolkit::AbstractTool
   \brief Tool controller for managing the follow navigation modes.
+
+  When following the current location in a scene, the camera orbits a hidden proxy
+  graphic rather than the location graphic itself. The proxy is moved at most once
+  per frame rendered by the view's window, so fixes which arrive faster than frames
+  are coalesced. Between fixes, the proxy is moved along the track predicted from the
+  last two fixes, blending from its displayed position so the camera does not jump.
+
+  The counters \l positionUpdateCount, \l cameraUpdateCount and \l frameCount can be
+  used to check that the camera is never updated more often than frames are rendered.
  */
 
 /*!
@@ -48,6 +72,8 @@ namespace Dsa {
 FollowPositionController::FollowPositionController(QObject* parent) :
   Toolkit::AbstractTool(parent)
 {
+  m_clock.start();
+
   connect(Toolkit::ToolResourceProvider::instance(), &Toolkit::ToolResourceProvider::geoViewChanged, this,
           &FollowPositionController::updateGeoView);
 
@@ -68,7 +94,53 @@ FollowPositionController::~FollowPositionController()
  */
 void FollowPositionController::init(GeoView* geoView)
 {
-  m_geoView = geoView;
+  if (m_geoView != geoView)
+  {
+    // an overlay can only be displayed by one view at a time
+    if (m_geoView && m_cameraTargetOverlay)
+      m_geoView->graphicsOverlays()->removeOne(m_cameraTargetOverlay);
+
+    m_geoView = geoView;
+
+    if (!m_cameraTargetOverlay)
+    {
+      // an invisible symbol which carries the heading used by the orbit camera controller
+      SimpleMarkerSceneSymbol* targetSymbol = new SimpleMarkerSceneSymbol(
+            SimpleMarkerSceneSymbolStyle::Sphere, Qt::transparent, 0.1, 0.1, 0.1, SceneSymbolAnchorPosition::Center, this);
+      SimpleRenderer* targetRenderer = new SimpleRenderer(targetSymbol, this);
+      RendererSceneProperties renderProperties = targetRenderer->sceneProperties();
+      renderProperties.setHeadingExpression(QString("[%1]").arg(s_headingAttribute));
+      targetRenderer->setSceneProperties(renderProperties);
+
+      // the overlay is left without an id, so it is not offered as an alert target
+      m_cameraTargetOverlay = new GraphicsOverlay(this);
+      m_cameraTargetOverlay->setSceneProperties(LayerSceneProperties(SurfacePlacement::Relative));
+      m_cameraTargetOverlay->setRenderingMode(GraphicsRenderingMode::Dynamic);
+      m_cameraTargetOverlay->setRenderer(targetRenderer);
+
+      m_cameraTarget = new Graphic(this);
+      m_cameraTarget->attributes()->insertAttribute(s_headingAttribute, 0.0);
+      m_cameraTargetOverlay->graphics()->append(m_cameraTarget);
+    }
+
+    if (dynamic_cast<SceneView*>(m_geoView))
+      m_geoView->graphicsOverlays()->append(m_cameraTargetOverlay);
+
+    // camera updates are applied on the frame clock of the window displaying the view
+    if (m_windowChangedConnection)
+      disconnect(m_windowChangedConnection);
+
+    QQuickItem* viewItem = dynamic_cast<QQuickItem*>(m_geoView);
+    if (viewItem)
+    {
+      m_windowChangedConnection = connect(viewItem, &QQuickItem::windowChanged, this, &FollowPositionController::connectWindow);
+      connectWindow(viewItem->window());
+    }
+    else
+    {
+      connectWindow(nullptr);
+    }
+  }
 
   handleNewMode();
 }
@@ -115,6 +187,7 @@ void FollowPositionController::followGeoElement(GeoElement* elementToFollow)
     return;
 
   m_mode = FollowMode::TrackUp;
+  setLocationGraphic(nullptr);
 
   OrbitGeoElementCameraController* followController = new OrbitGeoElementCameraController(elementToFollow, 2000.0, this);
   sceneView->setCameraController(followController);
@@ -170,6 +243,7 @@ bool FollowPositionController::handleFollowInScene()
 
   if (m_mode == FollowMode::Disabled)
   {
+    setLocationGraphic(nullptr);
     sceneView->setCameraController(new GlobeCameraController(this));
   }
   else
@@ -182,7 +256,11 @@ bool FollowPositionController::handleFollowInScene()
     if (!locationGraphic)
       return true;
 
-    OrbitGeoElementCameraController* followController = new OrbitGeoElementCameraController(locationGraphic, 2000., this);
+    setLocationGraphic(locationGraphic);
+
+    // without a frame clock, follow the location graphic directly
+    GeoElement* target = m_window ? static_cast<GeoElement*>(m_cameraTarget) : static_cast<GeoElement*>(locationGraphic);
+    OrbitGeoElementCameraController* followController = new OrbitGeoElementCameraController(target, 2000., this);
 
     if (m_mode == FollowMode::NorthUp)
     {
@@ -224,6 +302,198 @@ GraphicListModel* FollowPositionController::locationGraphicsModel() const
   return nullptr;
 }
 
+/*!
+  \brief Returns the number of location updates received while following.
+ */
+quint64 FollowPositionController::positionUpdateCount() const
+{
+  return m_positionUpdateCount;
+}
+
+/*!
+  \brief Returns the number of times the camera target has been moved.
+ */
+quint64 FollowPositionController::cameraUpdateCount() const
+{
+  return m_cameraUpdateCount;
+}
+
+/*!
+  \brief Returns the number of frames rendered by the view's window.
+ */
+quint64 FollowPositionController::frameCount() const
+{
+  return m_frameCount;
+}
+
+/*!
+  \internal
+
+  Tracks changes to the \a locationGraphic which is being followed.
+ */
+void FollowPositionController::setLocationGraphic(Graphic* locationGraphic)
+{
+  if (m_locationGeometryConnection)
+    disconnect(m_locationGeometryConnection);
+
+  if (m_locationAttributesConnection)
+    disconnect(m_locationAttributesConnection);
+
+  m_locationGraphic = locationGraphic;
+  m_lastFix = Point();
+  m_fromLocation = Point();
+  m_fixInterval = 0;
+
+  if (!m_locationGraphic)
+    return;
+
+  m_locationGeometryConnection = connect(m_locationGraphic.data(), &Graphic::geometryChanged,
+                                         this, &FollowPositionController::onLocationGraphicChanged);
+
+  // heading changes are applied on the next frame
+  m_locationAttributesConnection = connect(m_locationGraphic->attributes(), &AttributeListModel::dataChanged, this, [this]()
+  {
+    requestFrame();
+  });
+
+  // place the camera target at the current location straight away
+  onLocationGraphicChanged();
+  if (m_cameraTarget && !m_lastFix.isEmpty())
+  {
+    m_cameraTarget->setGeometry(m_lastFix);
+    m_cameraTarget->attributes()->replaceAttribute(s_headingAttribute, m_locationGraphic->attributes()->attributeValue(s_headingAttribute));
+    ++m_cameraUpdateCount;
+  }
+}
+
+/*!
+  \internal
+
+  Records a new fix from the location graphic and updates the predicted track.
+ */
+void FollowPositionController::onLocationGraphicChanged()
+{
+  if (!m_locationGraphic)
+    return;
+
+  const Point fix(m_locationGraphic->geometry());
+  if (fix.isEmpty())
+    return;
+
+  ++m_positionUpdateCount;
+
+  const qint64 now = m_clock.elapsed();
+
+  // blend onto the new track from wherever the camera target is now
+  const Point displayed = m_cameraTarget ? Point(m_cameraTarget->geometry()) : Point();
+  m_fromLocation = displayed.isEmpty() ? fix : displayed;
+
+  // estimate the velocity from consecutive fixes, ignoring long gaps
+  constexpr qint64 maxFixInterval = 5000;
+  const qint64 interval = now - m_lastFixTime;
+  if (!m_lastFix.isEmpty() && interval > 0 && interval <= maxFixInterval)
+  {
+    m_velocityX = (fix.x() - m_lastFix.x()) / interval;
+    m_velocityY = (fix.y() - m_lastFix.y()) / interval;
+    m_fixInterval = interval;
+  }
+  else
+  {
+    m_velocityX = 0.0;
+    m_velocityY = 0.0;
+    m_fixInterval = 0;
+  }
+
+  m_lastFix = fix;
+  m_lastFixTime = now;
+
+  requestFrame();
+}
+
+/*!
+  \internal
+
+  Moves the camera target for the frame which has just been displayed.
+ */
+void FollowPositionController::onFrameSwapped()
+{
+  ++m_frameCount;
+
+  if (m_mode == FollowMode::Disabled || !m_cameraTarget || !m_locationGraphic || m_lastFix.isEmpty())
+    return;
+
+  const qint64 now = m_clock.elapsed();
+  const Point target = predictedLocation(now);
+  const Point current(m_cameraTarget->geometry());
+  if (current.isEmpty() || current.x() != target.x() || current.y() != target.y() || current.z() != target.z())
+  {
+    m_cameraTarget->setGeometry(target);
+    ++m_cameraUpdateCount;
+  }
+
+  const QVariant heading = m_locationGraphic->attributes()->attributeValue(s_headingAttribute);
+  if (m_cameraTarget->attributes()->attributeValue(s_headingAttribute) != heading)
+    m_cameraTarget->attributes()->replaceAttribute(s_headingAttribute, heading);
+
+  // keep moving along the predicted track until it has been fully applied
+  if (now - m_lastFixTime < m_fixInterval)
+    requestFrame();
+}
+
+/*!
+  \internal
+ */
+void FollowPositionController::connectWindow(QQuickWindow* window)
+{
+  if (m_frameConnection)
+    disconnect(m_frameConnection);
+
+  m_window = window;
+  if (!m_window)
+    return;
+
+  // frameSwapped is emitted on the render thread so the slot is queued to this thread
+  m_frameConnection = connect(m_window.data(), &QQuickWindow::frameSwapped,
+                              this, &FollowPositionController::onFrameSwapped, Qt::QueuedConnection);
+}
+
+/*!
+  \internal
+
+  Schedules a frame so that pending camera changes are applied.
+ */
+void FollowPositionController::requestFrame()
+{
+  if (m_window && m_mode != FollowMode::Disabled)
+    m_window->update();
+}
+
+/*!
+  \internal
+
+  Returns the location of the camera target at \a time.
+
+  The last fix is extrapolated along the estimated velocity for at most one fix
+  interval, and the result is blended from the previously displayed location over
+  the same interval.
+ */
+Point FollowPositionController::predictedLocation(qint64 time) const
+{
+  if (m_fixInterval <= 0 || m_fromLocation.isEmpty())
+    return m_lastFix;
+
+  const qint64 sinceFix = time - m_lastFixTime;
+  const double predictionTime = static_cast<double>(std::min(sinceFix, m_fixInterval));
+  const double predictedX = m_lastFix.x() + m_velocityX * predictionTime;
+  const double predictedY = m_lastFix.y() + m_velocityY * predictionTime;
+
+  const double blend = std::min(1.0, static_cast<double>(sinceFix) / m_fixInterval);
+  return Point(m_fromLocation.x() + (predictedX - m_fromLocation.x()) * blend,
+               m_fromLocation.y() + (predictedY - m_fromLocation.y()) * blend,
+               m_lastFix.z(),
+               m_lastFix.spatialReference());
+}
+
 } // Dsa
 
 // Signal Documentation
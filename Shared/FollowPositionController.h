@@ -20,14 +20,25 @@
 // toolkit headers
 #include "AbstractTool.h"
 
+// C++ API headers
+#include "Point.h"
+
+// Qt headers
+#include <QElapsedTimer>
+#include <QPointer>
+
 namespace Esri {
 namespace ArcGISRuntime {
   class CameraController;
   class GeoElement;
   class GeoView;
+  class Graphic;
   class GraphicListModel;
+  class GraphicsOverlay;
 }}
 
+class QQuickWindow;
+
 namespace Dsa {
 
 class FollowPositionController : public Esri::ArcGISRuntime::Toolkit::AbstractTool
@@ -60,11 +71,17 @@ public:
 
   void followGeoElement(Esri::ArcGISRuntime::GeoElement* elementToFollow);
 
+  quint64 positionUpdateCount() const;
+  quint64 cameraUpdateCount() const;
+  quint64 frameCount() const;
+
 signals:
   void followModeChanged();
 
 private slots:
   void updateGeoView();
+  void onLocationGraphicChanged();
+  void onFrameSwapped();
 
 private:
 
@@ -72,9 +89,33 @@ private:
   bool handleFollowInMap();
   bool handleFollowInScene();
   Esri::ArcGISRuntime::GraphicListModel* locationGraphicsModel() const;
+  void setLocationGraphic(Esri::ArcGISRuntime::Graphic* locationGraphic);
+  void connectWindow(QQuickWindow* window);
+  void requestFrame();
+  Esri::ArcGISRuntime::Point predictedLocation(qint64 time) const;
 
   FollowMode m_mode = FollowMode::Disabled;
   Esri::ArcGISRuntime::GeoView* m_geoView = nullptr;
+
+  // the camera orbits a proxy graphic which is moved at most once per frame
+  Esri::ArcGISRuntime::GraphicsOverlay* m_cameraTargetOverlay = nullptr;
+  Esri::ArcGISRuntime::Graphic* m_cameraTarget = nullptr;
+  QPointer<Esri::ArcGISRuntime::Graphic> m_locationGraphic;
+  QPointer<QQuickWindow> m_window;
+  QMetaObject::Connection m_locationGeometryConnection;
+  QMetaObject::Connection m_locationAttributesConnection;
+  QMetaObject::Connection m_frameConnection;
+  QMetaObject::Connection m_windowChangedConnection;
+  QElapsedTimer m_clock;
+  Esri::ArcGISRuntime::Point m_fromLocation;
+  Esri::ArcGISRuntime::Point m_lastFix;
+  double m_velocityX = 0.0;
+  double m_velocityY = 0.0;
+  qint64 m_lastFixTime = 0;
+  qint64 m_fixInterval = 0;
+  quint64 m_positionUpdateCount = 0;
+  quint64 m_cameraUpdateCount = 0;
+  quint64 m_frameCount = 0;
 };
 
 } // Dsa
@@ -30,6 +30,9 @@
 // Qt headers
 #include <QSet>
 
+// STL headers
+#include <algorithm>
+
 using namespace Esri::ArcGISRuntime;
 
 namespace Dsa {
@@ -77,6 +80,10 @@ struct GeometryQuadtree::QuadTree
 
   The tree then allows geometric tests for candidate intersections against
   query geometries.
+
+  The tree is maintained per element: adding, removing or moving a GeoElement
+  only re-assigns that element, unless it moves outside the extent of the tree.
+  After each change, \l geoElementChanged reports the area affected by the change.
  */
 
 /*!
@@ -107,7 +114,7 @@ GeometryQuadtree::~GeometryQuadtree()
 /*!
   \brief Adds the \a newGeoElement into the quadtree.
 
-  \note The tree will be re-built.
+  \note The tree will only be re-built if the element lies outside of its extent.
  */
 void GeometryQuadtree::appendGeoElment(GeoElement* newGeoElement)
 {
@@ -118,6 +125,30 @@ void GeometryQuadtree::appendGeoElment(GeoElement* newGeoElement)
   handleGeometryChange(newKey);
 }
 
+/*!
+  \brief Removes the \a geoElement from the quadtree.
+
+  The tree is not re-built.
+ */
+void GeometryQuadtree::removeGeoElement(GeoElement* geoElement)
+{
+  auto findIt = m_elementKeys.find(geoElement);
+  if (findIt == m_elementKeys.end())
+    return;
+
+  const int key = findIt.value();
+  m_elementKeys.erase(findIt);
+
+  GeoElementSignaler* signaler = m_elementStorage.value(key);
+  removeKey(key, geoElement);
+
+  if (signaler)
+  {
+    disconnect(signaler, nullptr, this, nullptr);
+    delete signaler;
+  }
+}
+
 /*!
   \brief Returns the list of \l Geometry objects which are in quadtree cells which intersect \a geometry
 
@@ -191,6 +222,28 @@ QList<Geometry> GeometryQuadtree::candidateIntersections(const Point& location)
   return results;
 }
 
+/*!
+  \brief Returns the GeoElements which are in quadtree cells which intersect \a extent.
+
+  \note No intersection test is carried out between the supplied Envelope and the results.
+ */
+QList<GeoElement*> GeometryQuadtree::candidateElements(const Envelope& extent) const
+{
+  // ensure the extent is in WGS84
+  const Envelope wgs84 = GeometryEngine::project(extent, SpatialReference::wgs84());
+
+  QList<GeoElement*> results;
+  const QSet<int> geomIds = m_tree->intersectingIds(wgs84);
+  for (const int id : geomIds)
+  {
+    GeoElementSignaler* element = m_elementStorage.value(id);
+    if (element)
+      results.append(element->geoElement());
+  }
+
+  return results;
+}
+
 /*!
   \internal
  */
@@ -199,21 +252,21 @@ void GeometryQuadtree::buildTree(const Envelope& extent)
   // ensure the tree's extent is in WGS84
   const Envelope extentWgs84 = GeometryEngine::project(extent, SpatialReference::wgs84());
 
+  // pad the extent so that elements on its boundary (or a tree of a single point) still
+  // fall inside a cell, and small movements do not require the tree to be re-built
+  constexpr double minimumPadding = 0.001;
+  const double xPadding = std::max((extentWgs84.xMax() - extentWgs84.xMin()) * 0.05, minimumPadding);
+  const double yPadding = std::max((extentWgs84.yMax() - extentWgs84.yMin()) * 0.05, minimumPadding);
+
   // build the (currently empty) tree to the desired depth
-  m_tree.reset(new QuadTree(0, extentWgs84.xMin(), extentWgs84.xMax(), extentWgs84.yMin(), extentWgs84.yMax()));
+  m_tree.reset(new QuadTree(0, extentWgs84.xMin() - xPadding, extentWgs84.xMax() + xPadding,
+                            extentWgs84.yMin() - yPadding, extentWgs84.yMax() + yPadding));
 
-  // assign the geometry of each element to the tree, along with its id in the lookup
-  auto it = m_elementStorage.cbegin();
-  auto itEnd = m_elementStorage.cend();
+  // assign the extent of each element to the tree, along with its id in the lookup
+  auto it = m_elementExtents.cbegin();
+  auto itEnd = m_elementExtents.cend();
   for (; it != itEnd; ++it)
-  {
-    GeoElementSignaler* element = it.value();
-    if (!element)
-      continue;
-
-    const Geometry wgs84 = GeometryEngine::project(element->geoElement()->geometry(), SpatialReference::wgs84());
-    m_tree->assign(wgs84.extent(), it.key(), m_maxLevels);
-  }
+    m_tree->assign(it.value(), it.key(), m_maxLevels);
 
   // remove any nodes from the tree which contain no geometry
   m_tree->prune();
@@ -232,6 +285,8 @@ void GeometryQuadtree::handleGeometryChange(int changedId)
 
   const Geometry wgs84Geom = GeometryEngine::project(changedElement->geoElement()->geometry(), SpatialReference::wgs84());
   const Envelope wgs84Extent = wgs84Geom.extent();
+  const Envelope oldExtent = m_elementExtents.value(changedId);
+  m_elementExtents.insert(changedId, wgs84Extent);
 
   // if the extent of the changed geom is the same or smaller than the existing tree, it can still be used
   if (m_tree->m_xMin <= wgs84Extent.xMin() &&
@@ -240,29 +295,33 @@ void GeometryQuadtree::handleGeometryChange(int changedId)
       m_tree->m_yMax >= wgs84Extent.yMax())
   {
     m_tree->removeId(changedId);
-    m_tree->assign(wgs84Geom.extent(), changedId, m_maxLevels);
+    m_tree->assign(wgs84Extent, changedId, m_maxLevels);
     m_tree->prune();
     emit treeChanged();
   }
   // otherwise calculate the new extent and rebuild the tree
   else
   {
-    QList<Geometry> allGeom;
-    for(auto it = m_elementStorage.begin(); it != m_elementStorage.end(); ++it)
+    // the stored extents are already in WGS84
+    QList<Geometry> allExtents;
+    for (auto it = m_elementExtents.cbegin(); it != m_elementExtents.cend(); ++it)
     {
-      GeoElementSignaler* element = it.value();
-      if (!element)
-        continue;
-
-      if (element->geoElement()->geometry().isEmpty())
-        continue;
-
-      allGeom.append(GeometryEngine::project(element->geoElement()->geometry(), SpatialReference::wgs84()));
+      if (!it.value().isEmpty())
+        allExtents.append(it.value());
     }
 
-    const Geometry newExtent = GeometryEngine::combineExtents(allGeom);
+    const Geometry newExtent = GeometryEngine::combineExtents(allExtents);
     buildTree(newExtent);
   }
+
+  // report the area covering both the old and the new position of the element
+  GeoElement* geoElement = changedElement->geoElement();
+  if (oldExtent.isEmpty())
+    emit geoElementChanged(wgs84Extent, geoElement);
+  else if (wgs84Extent.isEmpty())
+    emit geoElementChanged(oldExtent, geoElement);
+  else
+    emit geoElementChanged(GeometryEngine::combineExtents(QList<Geometry>{oldExtent, wgs84Extent}), geoElement);
 }
 
 /*!
@@ -279,52 +338,49 @@ int GeometryQuadtree::handleNewGeoElement(GeoElement* geoElement)
 
   GeoElementSignaler* signaler = new GeoElementSignaler(geoElement, GeoElementUtils::toQObject(geoElement));
 
-  m_elementStorage.insert(m_nextKey, signaler);
   const int insertedKey = m_nextKey;
   m_nextKey++;
 
-  connect(signaler, &GeoElementSignaler::geometryChanged, this, [this, signaler]()
+  m_elementStorage.insert(insertedKey, signaler);
+  m_elementKeys.insert(geoElement, insertedKey);
+  m_elementExtents.insert(insertedKey, GeometryEngine::project(geoElement->geometry(), SpatialReference::wgs84()).extent());
+
+  connect(signaler, &GeoElementSignaler::geometryChanged, this, [this, insertedKey]()
   {
-    auto it = m_elementStorage.cbegin();
-    auto itEnd = m_elementStorage.cend();
-    for (; it != itEnd; ++it)
-    {
-      GeoElementSignaler* testElement = it.value();
-      if (!testElement)
-        continue;
-
-      if (testElement == signaler)
-      {
-        handleGeometryChange(it.key());
-        return;
-      }
-    }
+    handleGeometryChange(insertedKey);
   });
 
-  connect(signaler, &GeoElementSignaler::destroyed, this, [this, signaler]()
+  connect(signaler, &GeoElementSignaler::destroyed, this, [this, geoElement, insertedKey]()
   {
-    auto it = m_elementStorage.cbegin();
-    auto itEnd = m_elementStorage.cend();
-    for (; it != itEnd; ++it)
-    {
-      GeoElementSignaler* testElement = it.value();
-      if (!testElement)
-        continue;
-
-      if (testElement == signaler)
-      {
-        m_tree->removeId(it.key());
-        m_tree->prune();
-        m_elementStorage.remove(it.key());
-        emit treeChanged();
-        return;
-      }
-    }
+    m_elementKeys.remove(geoElement);
+    removeKey(insertedKey, geoElement);
   });
 
   return insertedKey;
 }
 
+/*!
+  \internal
+
+  Removes the \a geoElement stored with \a key from the tree and the lookups.
+ */
+void GeometryQuadtree::removeKey(int key, GeoElement* geoElement)
+{
+  m_elementStorage.remove(key);
+  const Envelope oldExtent = m_elementExtents.take(key);
+
+  if (m_tree)
+  {
+    m_tree->removeId(key);
+    m_tree->prune();
+  }
+
+  emit treeChanged();
+
+  if (!oldExtent.isEmpty())
+    emit geoElementChanged(oldExtent, geoElement);
+}
+
 /*!
   \internal
  */
@@ -663,3 +719,11 @@ void GeometryQuadtree::QuadTree::removeId(int index)
   \brief Signal emitted when the quad tree changes.
  */
 
+/*!
+  \fn void GeometryQuadtree::geoElementChanged(const Esri::ArcGISRuntime::Envelope& changedArea, Esri::ArcGISRuntime::GeoElement* geoElement);
+  \brief Signal emitted when \a geoElement is added, removed or moved.
+
+  \a changedArea is the WGS84 extent covering the old and new positions of the element.
+  If the element has been destroyed \a geoElement must not be dereferenced.
+ */
+
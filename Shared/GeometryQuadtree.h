@@ -17,6 +17,9 @@
 #ifndef GEOMETRYQUADTREE_H
 #define GEOMETRYQUADTREE_H
 
+// C++ API headers
+#include "Envelope.h"
+
 // Qt headers
 #include <QHash>
 #include <QList>
@@ -27,7 +30,6 @@
 
 namespace Esri {
 namespace ArcGISRuntime {
-class Envelope;
 class GeoElement;
 class Geometry;
 class Point;
@@ -50,24 +52,30 @@ public:
   ~GeometryQuadtree();
 
   void appendGeoElment(Esri::ArcGISRuntime::GeoElement* newGeoElement);
+  void removeGeoElement(Esri::ArcGISRuntime::GeoElement* geoElement);
 
   QList<Esri::ArcGISRuntime::Geometry> candidateIntersections(const Esri::ArcGISRuntime::Geometry& geometry) const;
   QList<Esri::ArcGISRuntime::Geometry> candidateIntersections(const Esri::ArcGISRuntime::Envelope& extent) const;
   QList<Esri::ArcGISRuntime::Geometry> candidateIntersections(const Esri::ArcGISRuntime::Point& location) const;
+  QList<Esri::ArcGISRuntime::GeoElement*> candidateElements(const Esri::ArcGISRuntime::Envelope& extent) const;
 
 signals:
   void treeChanged();
+  void geoElementChanged(const Esri::ArcGISRuntime::Envelope& changedArea, Esri::ArcGISRuntime::GeoElement* geoElement);
 
 private:
   void buildTree(const Esri::ArcGISRuntime::Envelope& extent);
   void handleGeometryChange(int changedIndex);
   int handleNewGeoElement(Esri::ArcGISRuntime::GeoElement* geoElement);
+  void removeKey(int key, Esri::ArcGISRuntime::GeoElement* geoElement);
 
   struct QuadTree;
 
   int m_maxLevels;
   std::unique_ptr<QuadTree> m_tree;
   QHash<int, GeoElementSignaler*> m_elementStorage;
+  QHash<Esri::ArcGISRuntime::GeoElement*, int> m_elementKeys;
+  QHash<int, Esri::ArcGISRuntime::Envelope> m_elementExtents;
   int m_nextKey = 0;
 };
 
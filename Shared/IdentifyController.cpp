@@ -21,8 +21,10 @@
 #include "IdentifyController.h"
 
 // example app headers
+#include "GeoElementUtils.h"
 #include "GraphicsOverlaysResultsManager.h"
 #include "LayerResultsManager.h"
+#include "MessagesPickIndex.h"
 
 // toolkit headers
 #include "ToolManager.h"
@@ -35,6 +37,9 @@
 #include "Popup.h"
 #include "PopupManager.h"
 
+// STL headers
+#include <algorithm>
+
 using namespace Esri::ArcGISRuntime;
 
 namespace Dsa {
@@ -44,13 +49,23 @@ namespace Dsa {
   \inmodule Dsa
   \inherits Toolkit::AbstractTool
   \brief Tool controller for identifying GeoElements.
+
+  A click in the view starts a single batch of identify tasks for layers and graphics
+  overlays, each limited to \l maximumResults per source. The popups are published
+  once the whole batch has completed. Clicking again while a batch is running cancels
+  it and replaces it with a batch for the new location.
+
+  The \l Esri::ArcGISRuntime::PopupManager for an identified GeoElement is only created
+  when it is first requested: \l popupManagers returns the loaded page of popups and
+  \l fetchMorePopups or \l popupManager page in the rest.
  */
 
 /*!
   \brief Constructor accepting an optional \a parent.
  */
 IdentifyController::IdentifyController(QObject* parent /* = nullptr */):
-  Toolkit::AbstractTool(parent)
+  Toolkit::AbstractTool(parent),
+  m_resultsParent(new QObject(this))
 {
   // setup connection to handle mouse-clicking in the view (used to trigger the identify tasks)
   connect(Toolkit::ToolResourceProvider::instance(), &Toolkit::ToolResourceProvider::mouseClicked,
@@ -93,12 +108,9 @@ void IdentifyController::setActive(bool active)
   if (active == m_active)
     return;
 
-  // if the tool is busy (identify tasks are in-progress), cancel those tasks and start new ones
+  // if the tool is busy (identify tasks are in-progress), cancel those tasks
   if (busy())
-  {
-    m_layersWatcher.cancel();
-    m_graphicsOverlaysWatcher.cancel();
-  }
+    cancelIdentify();
 
   m_active = active;
   emit activeChanged();
@@ -118,14 +130,21 @@ bool IdentifyController::busy() const
   \property IdentifyController::popupManagers
   \brief Returns a QVariantList of \l Esri::ArcGISRuntime::PopupManager which can be displayed in the view.
 
+  Only the loaded page of popups is returned (see \l popupPageSize and \l fetchMorePopups).
+  The popup managers are created the first time they are requested.
+
   For example, this can be passed to a \l PopupView or \l PopupStackView for display.
  */
 QVariantList IdentifyController::popupManagers() const
 {
   QVariantList res;
 
-  for (PopupManager* mgr : m_popupManagers)
+  for (int i = 0; i < m_loadedPopupCount; ++i)
   {
+    PopupManager* mgr = createPopupManager(i);
+    if (!mgr)
+      continue;
+
     QVariant v = QVariant::fromValue(mgr);
     res.push_back(v);
   }
@@ -133,6 +152,92 @@ QVariantList IdentifyController::popupManagers() const
   return res;
 }
 
+/*!
+  \property IdentifyController::popupCount
+  \brief Returns the total number of identified GeoElements which can be shown as popups.
+
+  This can be larger than the number of \l popupManagers currently loaded.
+ */
+int IdentifyController::popupCount() const
+{
+  return m_identifiedElements.size();
+}
+
+/*!
+  \property IdentifyController::canFetchMorePopups
+  \brief Returns whether there are identified GeoElements beyond the loaded page of \l popupManagers.
+ */
+bool IdentifyController::canFetchMorePopups() const
+{
+  return m_loadedPopupCount < m_identifiedElements.size();
+}
+
+/*!
+  \brief Returns the popup manager for the identified GeoElement at \a index,
+  creating it if required.
+
+  Returns \c nullptr if \a index is out of range.
+ */
+QObject* IdentifyController::popupManager(int index) const
+{
+  return createPopupManager(index);
+}
+
+/*!
+  \brief Extends the loaded page of \l popupManagers by \l popupPageSize popups.
+ */
+void IdentifyController::fetchMorePopups()
+{
+  const int loadedPopupCount = std::min(m_loadedPopupCount + m_popupPageSize, m_identifiedElements.size());
+  if (loadedPopupCount == m_loadedPopupCount)
+    return;
+
+  m_loadedPopupCount = loadedPopupCount;
+  emit popupManagersChanged();
+}
+
+/*!
+  \property IdentifyController::maximumResults
+  \brief The maximum number of GeoElements identified from each layer and graphics overlay.
+
+  Values less than \c 1 are treated as \c 1.
+ */
+int IdentifyController::maximumResults() const
+{
+  return m_maximumResults;
+}
+
+void IdentifyController::setMaximumResults(int maximumResults)
+{
+  maximumResults = std::max(1, maximumResults);
+  if (maximumResults == m_maximumResults)
+    return;
+
+  m_maximumResults = maximumResults;
+  emit maximumResultsChanged();
+}
+
+/*!
+  \property IdentifyController::popupPageSize
+  \brief The number of popup managers loaded at a time.
+
+  Values less than \c 1 are treated as \c 1.
+ */
+int IdentifyController::popupPageSize() const
+{
+  return m_popupPageSize;
+}
+
+void IdentifyController::setPopupPageSize(int popupPageSize)
+{
+  popupPageSize = std::max(1, popupPageSize);
+  if (popupPageSize == m_popupPageSize)
+    return;
+
+  m_popupPageSize = popupPageSize;
+  emit popupPageSizeChanged();
+}
+
 /*!
   \brief Show the popup for \a geoElement with the title \a popupTitle.
  */
@@ -141,10 +246,11 @@ void IdentifyController::showPopup(GeoElement* geoElement, const QString& popupT
   if (!geoElement)
     return;
 
-  m_popupManagers.clear();
+  cancelIdentify();
+  clearPopups();
   emit popupManagersChanged();
   addGeoElementPopup(geoElement, popupTitle);
-  emit popupManagersChanged();
+  publishResults();
 }
 
 /*!
@@ -158,7 +264,8 @@ void IdentifyController::showPopups(const QHash<QString, QList<GeoElement*>>& ge
   if (geoElementsByTitle.isEmpty())
     return;
 
-  m_popupManagers.clear();
+  cancelIdentify();
+  clearPopups();
   emit popupManagersChanged();
 
   for (auto it = geoElementsByTitle.cbegin(); it != geoElementsByTitle.cend(); ++it)
@@ -168,11 +275,13 @@ void IdentifyController::showPopups(const QHash<QString, QList<GeoElement*>>& ge
       addGeoElementPopup(geoElement, popupTitle);
   }
 
-  emit popupManagersChanged();
+  publishResults();
 }
 
 /*!
   \brief Handles a mouse-click event in the view - used to trigger identify graphics and features tasks.
+
+  If a previous identify is still running it is cancelled and replaced by one at the new position.
  */
 void IdentifyController::onMouseClicked(QMouseEvent& event)
 {
@@ -184,23 +293,32 @@ void IdentifyController::onMouseClicked(QMouseEvent& event)
   if (event.button() != Qt::MouseButton::LeftButton)
     return;
 
-  // Ignore the event if the tool is cuurrently running tasks.
-  if (busy())
-    return;
-
   GeoView* geoView = Toolkit::ToolResourceProvider::instance()->geoView();
   if (!geoView)
     return;
 
+  // cancel any tasks which are still running - their results are ignored since the
+  // task Ids will no longer match the ones we are tracking
+  cancelIdentify();
+  clearPopups();
+  emit popupManagersChanged();
+
+  // pick the message graphics under the event from the client-side index
+  MessagesPickIndex* pickIndex = MessagesPickIndex::instance();
+  const QList<MessagesPickIndex::PickResult> pickResults = pickIndex->pick(geoView, event.pos(), m_tolerance, m_maximumResults);
+  for (const MessagesPickIndex::PickResult& pickResult : pickResults)
+    addGeoElementPopup(pickResult.graphic, pickResult.graphicsOverlay->overlayId());
+
   // start new identifyLayers and identifyGraphicsOverlays tasks at the x and y position of the event and using the
   // specifed tolerance (m_tolerance) to determine how accurate a hit-test to perform.
   // create a TaskWatcher to store the progress/state of the task.
-  m_layersWatcher = geoView->identifyLayers(event.pos().x(), event.pos().y(), m_tolerance, false);
-  m_graphicsOverlaysWatcher = geoView->identifyGraphicsOverlays(event.pos().x(), event.pos().y(), m_tolerance, false);
-  emit busyChanged();
+  // The graphics overlays are only identified if the index found nothing, could not place
+  // every message graphic exactly, or some graphics are not covered by it.
+  m_layersWatcher = geoView->identifyLayers(event.pos().x(), event.pos().y(), m_tolerance, false, m_maximumResults);
+  if (pickResults.isEmpty() || pickIndex->hasApproximatePlacement(geoView) || pickIndex->hasUncoveredGraphics(geoView))
+    m_graphicsOverlaysWatcher = geoView->identifyGraphicsOverlays(event.pos().x(), event.pos().y(), m_tolerance, false, m_maximumResults);
 
-  m_popupManagers.clear();
-  emit popupManagersChanged();
+  emit busyChanged();
 
   // accept the event to prevent it being used by other tools etc.
   event.accept();
@@ -209,7 +327,8 @@ void IdentifyController::onMouseClicked(QMouseEvent& event)
 /*!
   \brief Handles the output of an IdentifyLayers task with Id \a taskId and results \l identifyResults.
 
-  Creates a new \l Esri::ArcGISRuntime::PopupManager objects for every valid feature with attributes
+  Records every valid feature with attributes; the popups are published once the
+  graphics overlays have also been identified.
  */
 void IdentifyController::onIdentifyLayersCompleted(const QUuid& taskId, QList<IdentifyLayerResult*> identifyResults)
 {
@@ -226,8 +345,7 @@ void IdentifyController::onIdentifyLayersCompleted(const QUuid& taskId, QList<Id
   if (!isActive())
     return;
 
-  // iterate over the results and add a new PopupManager for any valid features, with attributes
-  bool anyAdded = false;
+  // iterate over the results and record any valid features, with attributes
   auto it = resultsManager.m_results.begin();
   auto itEnd = resultsManager.m_results.end();
   for (; it != itEnd; ++it)
@@ -240,19 +358,21 @@ void IdentifyController::onIdentifyLayersCompleted(const QUuid& taskId, QList<Id
     const QList<GeoElement*> geoElements = res->geoElements();
     for(GeoElement* g : geoElements)
     {
+      // the features must outlive the results so that their popups can be created later
       if (addGeoElementPopup(g, resTitle))
-        anyAdded = true;
+        GeoElementUtils::setParent(g, m_resultsParent);
     }
   }
 
-  if (anyAdded)
-    emit popupManagersChanged();
+  if (!busy())
+    publishResults();
 }
 
 /*!
   \brief Handles the output of an IdentifyGraphicsOverlays task with Id \a taskId and results \l identifyResults.
 
-  Creates a new \l Esri::ArcGISRumtime::PopupManager objects for every valid graphic with attributes
+  Records every valid graphic with attributes; the popups are published once the
+  layers have also been identified.
  */
 void IdentifyController::onIdentifyGraphicsOverlaysCompleted(const QUuid& taskId, QList<IdentifyGraphicsOverlayResult*> identifyResults)
 {
@@ -269,8 +389,7 @@ void IdentifyController::onIdentifyGraphicsOverlaysCompleted(const QUuid& taskId
   if (!isActive())
     return;
 
-  // iterate over the results and add a new PopupManager for any valid graphics, with attributes
-  bool anyAdded = false;
+  // iterate over the results and record any valid graphics, with attributes
   auto it = resultsManager.m_results.begin();
   auto itEnd = resultsManager.m_results.end();
   for (; it != itEnd; ++it)
@@ -282,20 +401,57 @@ void IdentifyController::onIdentifyGraphicsOverlaysCompleted(const QUuid& taskId
     const QString resTitle = res->graphicsOverlay()->overlayId();
     const QList<Graphic*> graphics = res->graphics();
 
+    // the graphics are the overlay's own instances, so they are not reparented; a popup
+    // is dropped if its graphic is deleted by its owner (see onGeoElementDestroyed)
     for(Graphic* g : graphics)
-    {
-      if (addGeoElementPopup(g, resTitle))
-        anyAdded = true;
-    }
+      addGeoElementPopup(g, resTitle);
+  }
+
+  if (!busy())
+    publishResults();
+}
+
+/*!
+  \internal
+
+  Discards the popups of identified GeoElements which have since been destroyed.
+ */
+void IdentifyController::onGeoElementDestroyed()
+{
+  auto isDestroyed = [](const IdentifiedElement& element)
+  {
+    return element.geoElementObject.isNull();
+  };
+
+  m_pendingElements.erase(std::remove_if(m_pendingElements.begin(), m_pendingElements.end(), isDestroyed), m_pendingElements.end());
+
+  bool changed = false;
+  for (int i = m_identifiedElements.size() - 1; i >= 0; --i)
+  {
+    const IdentifiedElement& element = m_identifiedElements.at(i);
+    if (!isDestroyed(element))
+      continue;
+
+    // the popup manager may still be referenced by the view until it receives popupManagersChanged
+    if (element.popupManager)
+      element.popupManager->deleteLater();
+
+    m_identifiedElements.removeAt(i);
+    if (i < m_loadedPopupCount)
+      --m_loadedPopupCount;
+
+    changed = true;
   }
 
-  if (anyAdded)
+  if (changed)
     emit popupManagersChanged();
 }
 
 /*!
-  \brief Helper method to create a new PopupManager with the title \a popupTitle,
+  \brief Helper method to record \a geoElement for a popup with the title \a popupTitle,
   if \a geoElement is valid and has attributes.
+
+  The popup itself is not created until it is requested.
  */
 bool IdentifyController::addGeoElementPopup(GeoElement* geoElement, const QString& popupTitle)
 {
@@ -305,16 +461,103 @@ bool IdentifyController::addGeoElementPopup(GeoElement* geoElement, const QStrin
   if (!geoElement->attributes() || geoElement->attributes()->isEmpty())
     return false;
 
-  // create a new Popup from the geoElement
-  Popup* newPopup = new Popup(geoElement, this);
-  newPopup->popupDefinition()->setTitle(popupTitle);
-  PopupManager* newManager = new PopupManager(newPopup, this);
+  // a message graphic may be both picked and identified
+  for (const IdentifiedElement& pendingElement : qAsConst(m_pendingElements))
+  {
+    if (pendingElement.geoElement == geoElement)
+      return false;
+  }
+
+  IdentifiedElement element;
+  element.geoElement = geoElement;
+  element.geoElementObject = GeoElementUtils::toQObject(geoElement);
+  element.popupTitle = popupTitle;
+  m_pendingElements.append(element);
 
-  m_popupManagers.push_back(newManager);
+  // graphics can be removed from their overlay (e.g. when they expire) while their popup is shown
+  if (element.geoElementObject)
+    connect(element.geoElementObject.data(), &QObject::destroyed, this, &IdentifyController::onGeoElementDestroyed, Qt::UniqueConnection);
 
   return true;
 }
 
+/*!
+  \internal
+
+  Returns the popup manager for the identified element at \a index, creating it on first use.
+ */
+PopupManager* IdentifyController::createPopupManager(int index) const
+{
+  if (index < 0 || index >= m_identifiedElements.size())
+    return nullptr;
+
+  IdentifiedElement& element = m_identifiedElements[index];
+  if (element.popupManager)
+    return element.popupManager;
+
+  // the graphic may have been removed from its overlay since it was identified
+  if (!element.geoElementObject)
+    return nullptr;
+
+  // create a new Popup from the geoElement
+  Popup* newPopup = new Popup(element.geoElement, m_resultsParent);
+  newPopup->popupDefinition()->setTitle(element.popupTitle);
+  element.popupManager = new PopupManager(newPopup, m_resultsParent);
+
+  return element.popupManager;
+}
+
+/*!
+  \internal
+
+  Cancels any running identify tasks and discards the results gathered for them.
+ */
+void IdentifyController::cancelIdentify()
+{
+  m_pendingElements.clear();
+
+  if (!busy())
+    return;
+
+  m_layersWatcher.cancel();
+  m_graphicsOverlaysWatcher.cancel();
+  m_layersWatcher = TaskWatcher();
+  m_graphicsOverlaysWatcher = TaskWatcher();
+  emit busyChanged();
+}
+
+/*!
+  \internal
+
+  Discards the current popups, along with the popup managers and identified features they use.
+ */
+void IdentifyController::clearPopups()
+{
+  m_identifiedElements.clear();
+  m_loadedPopupCount = 0;
+
+  // the old popups may still be referenced by the view until it receives popupManagersChanged
+  m_resultsParent->deleteLater();
+  m_resultsParent = new QObject(this);
+}
+
+/*!
+  \internal
+
+  Publishes the GeoElements gathered for the current batch as the first page of popups.
+ */
+void IdentifyController::publishResults()
+{
+  if (m_pendingElements.isEmpty())
+    return;
+
+  m_identifiedElements.append(m_pendingElements);
+  m_pendingElements.clear();
+  m_loadedPopupCount = std::min(m_popupPageSize, m_identifiedElements.size());
+
+  emit popupManagersChanged();
+}
+
 } // Dsa
 
 // Signal Documentation
@@ -328,3 +571,13 @@ bool IdentifyController::addGeoElementPopup(GeoElement* geoElement, const QStrin
   \brief Signal emitted when the popup managers change.
  */
 
+/*!
+  \fn void IdentifyController::maximumResultsChanged();
+  \brief Signal emitted when the maximumResults property changes.
+ */
+
+/*!
+  \fn void IdentifyController::popupPageSizeChanged();
+  \brief Signal emitted when the popupPageSize property changes.
+ */
+
@@ -24,8 +24,10 @@
 #include "TaskWatcher.h"
 
 // Qt headers
+#include <QList>
 #include <QMouseEvent>
 #include <QObject>
+#include <QPointer>
 
 namespace Esri {
 namespace ArcGISRuntime {
@@ -44,6 +46,10 @@ class IdentifyController : public Esri::ArcGISRuntime::Toolkit::AbstractTool
 
   Q_PROPERTY(bool busy READ busy NOTIFY busyChanged)
   Q_PROPERTY(QVariantList popupManagers READ popupManagers NOTIFY popupManagersChanged)
+  Q_PROPERTY(int popupCount READ popupCount NOTIFY popupManagersChanged)
+  Q_PROPERTY(bool canFetchMorePopups READ canFetchMorePopups NOTIFY popupManagersChanged)
+  Q_PROPERTY(int maximumResults READ maximumResults WRITE setMaximumResults NOTIFY maximumResultsChanged)
+  Q_PROPERTY(int popupPageSize READ popupPageSize WRITE setPopupPageSize NOTIFY popupPageSizeChanged)
 
 public:
 
@@ -56,6 +62,17 @@ public:
 
   bool busy() const;
   QVariantList popupManagers() const;
+  int popupCount() const;
+  bool canFetchMorePopups() const;
+
+  Q_INVOKABLE QObject* popupManager(int index) const;
+  Q_INVOKABLE void fetchMorePopups();
+
+  int maximumResults() const;
+  void setMaximumResults(int maximumResults);
+
+  int popupPageSize() const;
+  void setPopupPageSize(int popupPageSize);
 
   void showPopup(Esri::ArcGISRuntime::GeoElement* geoElement, const QString& popupTitle);
   void showPopups(const QHash<QString, QList<Esri::ArcGISRuntime::GeoElement*>>& geoElementsByTitle);
@@ -64,18 +81,38 @@ private slots:
   void onMouseClicked(QMouseEvent& event);
   void onIdentifyLayersCompleted(const QUuid& taskId, QList<Esri::ArcGISRuntime::IdentifyLayerResult*> identifyResults);
   void onIdentifyGraphicsOverlaysCompleted(const QUuid& taskId, QList<Esri::ArcGISRuntime::IdentifyGraphicsOverlayResult*> identifyResults);
+  void onGeoElementDestroyed();
 
 signals:
   void busyChanged();
   void popupManagersChanged();
+  void maximumResultsChanged();
+  void popupPageSizeChanged();
 
 private:
+  struct IdentifiedElement
+  {
+    Esri::ArcGISRuntime::GeoElement* geoElement = nullptr;
+    QPointer<QObject> geoElementObject;
+    QString popupTitle;
+    Esri::ArcGISRuntime::PopupManager* popupManager = nullptr;
+  };
+
   bool addGeoElementPopup(Esri::ArcGISRuntime::GeoElement* geoElement, const QString& popupTitle);
+  Esri::ArcGISRuntime::PopupManager* createPopupManager(int index) const;
+  void cancelIdentify();
+  void clearPopups();
+  void publishResults();
 
   double m_tolerance = 5.0;
+  int m_maximumResults = 10;
+  int m_popupPageSize = 5;
+  int m_loadedPopupCount = 0;
   Esri::ArcGISRuntime::TaskWatcher m_layersWatcher;
   Esri::ArcGISRuntime::TaskWatcher m_graphicsOverlaysWatcher;
-  QList<Esri::ArcGISRuntime::PopupManager*> m_popupManagers;
+  QObject* m_resultsParent = nullptr;
+  mutable QList<IdentifiedElement> m_identifiedElements;
+  QList<IdentifiedElement> m_pendingElements;
 };
 
 } // Dsa
@@ -21,6 +21,7 @@
 
 // example app headers
 #include "DataSender.h"
+#include "DsaUtility.h"
 
 // toolkit headers
 #include "ToolResourceProvider.h"
@@ -30,6 +31,9 @@
 #include <QTimer>
 #include <QUdpSocket>
 
+// STL headers
+#include <algorithm>
+
 using namespace Esri::ArcGISRuntime;
 
 namespace Dsa {
@@ -37,6 +41,9 @@ namespace Dsa {
 // friendly symbol ID for our location broadcast
 static const QString s_locationBroadcastSic{QStringLiteral("SFGPEVAL-------")};
 
+// sent datagrams remembered to recognize their echo; more than can be in flight at the minimum interval
+static const int s_recentlySentCount = 4;
+
 /*!
   \class Dsa::LocationBroadcast
   \inmodule Dsa
@@ -49,6 +56,12 @@ static const QString s_locationBroadcastSic{QStringLiteral("SFGPEVAL-------")};
   The broadcast should typically be configured with an existing message feed type
   over an existing message feed UDP port.
 
+  Rather than sending at a fixed rate, an update is sent whenever the location
+  diverges from the last broadcast location (the position receivers are displaying)
+  by more than \l distanceThreshold meters. Updates are never sent more often than
+  every \l minimumInterval milliseconds, and a heartbeat is sent every
+  \l frequency milliseconds even when the location has not changed.
+
   \sa MessageFeedsController
   \sa setMessageType
   \sa setUdpPort
@@ -133,7 +146,7 @@ void LocationBroadcast::setLocation(const Point& location)
 
   m_location = location;
 
-  broadcastLocation();
+  onLocationUpdated();
 }
 
 /*!
@@ -213,10 +226,37 @@ void LocationBroadcast::setUdpPort(int port)
     update();
 }
 
+/*!
+   \brief Returns the multicast group location updates are sent to.
+
+   A null address, the default, broadcasts the updates to every host.
+ */
+QHostAddress LocationBroadcast::multicastGroup() const
+{
+  return m_multicastGroup;
+}
+
+/*!
+   \brief Sets the multicast group location updates are sent to to \a multicastGroup.
+
+   Setting a null address broadcasts the updates to every host.
+ */
+void LocationBroadcast::setMulticastGroup(const QHostAddress& multicastGroup)
+{
+  if (m_multicastGroup == multicastGroup)
+    return;
+
+  m_multicastGroup = multicastGroup;
+
+  update();
+}
+
 /*!
    \brief Returns the frequency of broadcasted location updates.
 
-   The frequency value is in milliseconds. The default is \c 3000 milliseconds
+   This is the longest time between two updates, used as a heartbeat when the
+   location does not change. The frequency value is in milliseconds. The default
+   is \c 3000 milliseconds
  */
 int LocationBroadcast::frequency() const
 {
@@ -242,6 +282,64 @@ void LocationBroadcast::setFrequency(int frequency)
     m_timer->setInterval(m_frequency);
 }
 
+/*!
+   \brief Returns the shortest time, in milliseconds, between two location updates.
+
+   The default is \c 500 milliseconds.
+ */
+int LocationBroadcast::minimumInterval() const
+{
+  return m_minimumInterval;
+}
+
+/*!
+   \brief Sets the shortest time, in milliseconds, between two location updates to \a minimumInterval.
+ */
+void LocationBroadcast::setMinimumInterval(int minimumInterval)
+{
+  m_minimumInterval = std::max(minimumInterval, 0);
+}
+
+/*!
+   \brief Returns the distance, in meters, the location must move from the last
+   broadcast location before an update is sent.
+
+   The default is \c 10 meters.
+ */
+double LocationBroadcast::distanceThreshold() const
+{
+  return m_distanceThreshold;
+}
+
+/*!
+   \brief Sets the distance, in meters, the location must move from the last
+   broadcast location before an update is sent to \a distanceThreshold.
+ */
+void LocationBroadcast::setDistanceThreshold(double distanceThreshold)
+{
+  m_distanceThreshold = std::max(distanceThreshold, 0.0);
+}
+
+/*!
+   \brief Returns the encoding in which location updates are broadcast.
+
+   The default is Message::MessageEncoding::GeoMessage. The compact binary
+   encoding is much smaller and cheaper to parse, but is only understood by
+   receivers which support it.
+ */
+Message::MessageEncoding LocationBroadcast::messageEncoding() const
+{
+  return m_messageEncoding;
+}
+
+/*!
+   \brief Sets the encoding in which location updates are broadcast to \a messageEncoding.
+ */
+void LocationBroadcast::setMessageEncoding(Message::MessageEncoding messageEncoding)
+{
+  m_messageEncoding = messageEncoding;
+}
+
 /*!
    \brief Returns \c true if the location broadcast reports
    message status as being in distress.
@@ -271,6 +369,9 @@ void LocationBroadcast::setInDistress(bool inDistress)
 
   if (m_inDistress && !isEnabled())
     setEnabled(true);
+
+  // a change of status is sent straight away
+  broadcastLocation();
 }
 
 /*!
@@ -286,8 +387,8 @@ Message LocationBroadcast::message() const
    \brief Updates the configuration of the location broadcast to use
    the specified message feed type and UDP port.
 
-   The existing broadcast will be stopped and torn down. If enabled, a new location broadcast
-   will be started at the specified frequency rate.
+   The data sender and socket are created once and kept for the lifetime of the
+   broadcast. The socket is only reconnected when the UDP port or multicast group changes.
  */
 void LocationBroadcast::update()
 {
@@ -297,27 +398,50 @@ void LocationBroadcast::update()
   if (m_messageType.isEmpty() || m_udpPort == -1)
     return;
 
-  if (m_dataSender)
+  if (!m_dataSender)
   {
-    delete m_dataSender;
-    m_dataSender = nullptr;
-    m_timer = nullptr;
+    m_dataSender = new DataSender(this);
+    m_udpSocket = new QUdpSocket(m_dataSender);
+    m_dataSender->setDevice(m_udpSocket);
+
+    // heartbeat for when the location does not change
+    m_timer = new QTimer(m_dataSender);
+    m_timer->setSingleShot(true);
+    connect(m_timer, &QTimer::timeout, this, [this]
+    {
+      broadcastLocation();
+    });
+
+    // deferred update for movement within the minimum interval
+    m_rateLimitTimer = new QTimer(m_dataSender);
+    m_rateLimitTimer->setSingleShot(true);
+    connect(m_rateLimitTimer, &QTimer::timeout, this, [this]
+    {
+      broadcastLocation();
+    });
   }
 
-  m_dataSender = new DataSender(this);
+  const QHostAddress destination = m_multicastGroup.isNull() ? QHostAddress(QHostAddress::Broadcast) : m_multicastGroup;
+  if (m_udpSocket->peerPort() != m_udpPort || m_udpSocket->peerAddress() != destination)
+  {
+    if (m_udpSocket->state() != QAbstractSocket::UnconnectedState)
+      m_udpSocket->disconnectFromHost();
 
-  QUdpSocket* udpSocket = new QUdpSocket(m_dataSender);
-  udpSocket->connectToHost(QHostAddress::Broadcast, m_udpPort, QIODevice::WriteOnly);
-  m_dataSender->setDevice(udpSocket);
+    m_udpSocket->connectToHost(destination, m_udpPort, QIODevice::WriteOnly);
+  }
 
-  m_timer = new QTimer(m_dataSender);
-  connect(m_timer, &QTimer::timeout, this, [this]
-  {
-    broadcastLocation();
-  });
+  if (!m_message.isEmpty())
+    m_message.setMessageType(m_messageType);
 
   if (m_enabled)
+  {
     m_timer->start(m_frequency);
+  }
+  else
+  {
+    m_timer->stop();
+    m_rateLimitTimer->stop();
+  }
 
   if (m_useCurrentLocation)
   {
@@ -328,17 +452,48 @@ void LocationBroadcast::update()
         return;
 
       m_location = location;
+      onLocationUpdated();
     });
   }
 }
 
+/*!
+   \internal
+   \brief Broadcasts the current location if it has diverged from the last
+   broadcast location by more than the distance threshold.
+
+   Receivers display the last location they were sent, so that is the position
+   they predict until the next update. Updates within the minimum interval of the
+   previous broadcast are deferred until the interval has elapsed.
+ */
+void LocationBroadcast::onLocationUpdated()
+{
+  if (!m_enabled || !m_dataSender || m_location.isEmpty())
+    return;
+
+  if (!m_lastBroadcastLocation.isEmpty())
+  {
+    // compare horizontal positions only, so that GPS altitude noise does not trigger updates
+    const Point from(m_lastBroadcastLocation.x(), m_lastBroadcastLocation.y(), 0.0, m_lastBroadcastLocation.spatialReference());
+    const Point to(m_location.x(), m_location.y(), 0.0, m_location.spatialReference());
+    if (DsaUtility::distance3D(from, to) < m_distanceThreshold)
+      return;
+  }
+
+  const qint64 sinceLastBroadcast = m_sinceLastBroadcast.isValid() ? m_sinceLastBroadcast.elapsed() : m_minimumInterval;
+  if (sinceLastBroadcast >= m_minimumInterval)
+    broadcastLocation();
+  else if (!m_rateLimitTimer->isActive())
+    m_rateLimitTimer->start(static_cast<int>(m_minimumInterval - sinceLastBroadcast));
+}
+
 /*!
    \internal
    \brief Broadcasts the current location with the configured
    message feed type and UDP port.
 
    This function updates the current message with the current location
-   and broadcasts the message in GeoMessage format.
+   and broadcasts the message in the configured \l messageEncoding.
  */
 void LocationBroadcast::broadcastLocation()
 {
@@ -373,7 +528,12 @@ void LocationBroadcast::broadcastLocation()
 
   emit messageChanged();
 
-  m_dataSender->sendData(m_message.toGeoMessage());
+  sendMessage();
+
+  m_lastBroadcastLocation = m_location;
+  m_sinceLastBroadcast.restart();
+  m_rateLimitTimer->stop();
+  m_timer->start(m_frequency);
 }
 
 /*!
@@ -392,10 +552,37 @@ void LocationBroadcast::removeBroadcast()
     emit messageChanged();
 
     if (m_dataSender)
-      m_dataSender->sendData(m_message.toGeoMessage());
+      sendMessage();
   }
 }
 
+/*!
+   \internal
+   \brief Sends the current message and remembers its bytes so that the
+   echo of the broadcast can be recognized.
+ */
+void LocationBroadcast::sendMessage()
+{
+  const QByteArray data = m_message.encode(m_messageEncoding);
+  m_dataSender->sendData(data);
+
+  m_recentlySent.append(data);
+  if (m_recentlySent.size() > s_recentlySentCount)
+    m_recentlySent.removeFirst();
+}
+
+/*!
+   \brief Returns \c true if \a data is identical to one of the last
+   datagrams sent by this location broadcast.
+
+   A broadcast is also received by the sending host, so this identifies
+   our own updates without parsing them.
+ */
+bool LocationBroadcast::isOwnData(const QByteArray& data) const
+{
+  return m_recentlySent.contains(data);
+}
+
 /*!
    \brief Returns the user name for the location broadcast.
  */
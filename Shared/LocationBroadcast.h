@@ -24,9 +24,12 @@
 #include "Point.h"
 
 // Qt headers
+#include <QElapsedTimer>
+#include <QHostAddress>
 #include <QObject>
 
 class QTimer;
+class QUdpSocket;
 
 namespace Dsa {
 
@@ -56,14 +59,28 @@ public:
   int udpPort() const;
   void setUdpPort(int port);
 
+  QHostAddress multicastGroup() const;
+  void setMulticastGroup(const QHostAddress& multicastGroup);
+
   int frequency() const;
   void setFrequency(int frequency);
 
+  int minimumInterval() const;
+  void setMinimumInterval(int minimumInterval);
+
+  double distanceThreshold() const;
+  void setDistanceThreshold(double distanceThreshold);
+
+  Message::MessageEncoding messageEncoding() const;
+  void setMessageEncoding(Message::MessageEncoding messageEncoding);
+
   bool isInDistress() const;
   void setInDistress(bool inDistress);
 
   Message message() const;
 
+  bool isOwnData(const QByteArray& data) const;
+
   QString userName() const;
   void setUserName(const QString& userName);
 
@@ -74,8 +91,10 @@ private:
   Q_DISABLE_COPY(LocationBroadcast)
 
   void update();
+  void onLocationUpdated();
   void broadcastLocation();
   void removeBroadcast();
+  void sendMessage();
 
   QString m_userName;
   bool m_enabled = true;
@@ -83,12 +102,21 @@ private:
   bool m_useCurrentLocation = true;
   QString m_messageType;
   int m_udpPort = -1;
+  QHostAddress m_multicastGroup;
   int m_frequency = 3000;
+  int m_minimumInterval = 500;
+  double m_distanceThreshold = 10.0;
   bool m_inDistress = false;
+  Message::MessageEncoding m_messageEncoding = Message::MessageEncoding::GeoMessage;
 
   DataSender* m_dataSender = nullptr;
+  QUdpSocket* m_udpSocket = nullptr;
   Message m_message;
+  QList<QByteArray> m_recentlySent;
   QTimer* m_timer = nullptr;
+  QTimer* m_rateLimitTimer = nullptr;
+  QElapsedTimer m_sinceLastBroadcast;
+  Esri::ArcGISRuntime::Point m_lastBroadcastLocation;
 
   QMetaObject::Connection m_locationChangedConn;
 };
@@ -51,6 +51,8 @@ namespace Dsa {
 const QString LocationController::SIMULATE_LOCATION_PROPERTYNAME = "SimulateLocation";
 const QString LocationController::GPX_FILE_PROPERTYNAME = "GpxFile";
 const QString LocationController::RESOURCE_DIRECTORY_PROPERTYNAME = "ResourceDirectory";
+const QString LocationController::DISTANCE_THRESHOLD_PROPERTYNAME = "LocationDisplayDistanceThreshold";
+const QString LocationController::HEADING_THRESHOLD_PROPERTYNAME = "LocationDisplayHeadingThreshold";
 
 /*!
   \class Dsa::LocationController
@@ -199,6 +201,8 @@ QString LocationController::toolName() const
  *  \li \c SimulateLocation - Whether the app's location should be simulated.
  *  \li \c GpxFile - The path of the GPX file for simulated positions.
  *  \li \c ResourceDirectory - The directory containing icons for the location display.
+ *  \li \c LocationDisplayDistanceThreshold - The distance in meters the location must move before the display is updated.
+ *  \li \c LocationDisplayHeadingThreshold - The angle in degrees the heading must turn before the display is updated.
  * \endlist
  */
 void LocationController::setProperties(const QVariantMap& properties)
@@ -207,6 +211,12 @@ void LocationController::setProperties(const QVariantMap& properties)
   setGpxFilePath(properties[GPX_FILE_PROPERTYNAME].toString());
   setSimulationEnabled(simulate);
   setIconDataPath(properties[RESOURCE_DIRECTORY_PROPERTYNAME].toString());
+
+  if (properties.contains(DISTANCE_THRESHOLD_PROPERTYNAME))
+    m_locationDisplay3d->setDistanceThreshold(properties.value(DISTANCE_THRESHOLD_PROPERTYNAME).toDouble());
+
+  if (properties.contains(HEADING_THRESHOLD_PROPERTYNAME))
+    m_locationDisplay3d->setHeadingThreshold(properties.value(HEADING_THRESHOLD_PROPERTYNAME).toDouble());
 }
 
 /*!
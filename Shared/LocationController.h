@@ -53,6 +53,8 @@ public:
   static const QString SIMULATE_LOCATION_PROPERTYNAME;
   static const QString GPX_FILE_PROPERTYNAME;
   static const QString RESOURCE_DIRECTORY_PROPERTYNAME;
+  static const QString DISTANCE_THRESHOLD_PROPERTYNAME;
+  static const QString HEADING_THRESHOLD_PROPERTYNAME;
 
   explicit LocationController(QObject* parent = nullptr);
   ~LocationController();
@@ -20,6 +20,7 @@
 #include "LocationDisplay3d.h"
 
 // example app headers
+#include "DsaUtility.h"
 #include "GPXLocationSimulator.h"
 
 // C++ API headers
@@ -28,8 +29,10 @@
 
 // Qt headers
 #include <QCompass>
+#include <QTimer>
 
 // STL headers
+#include <algorithm>
 #include <cmath>
 
 using namespace Esri::ArcGISRuntime;
@@ -46,6 +49,11 @@ static const QString s_headingAttribute{"heading"};
 
   The position is displayed as a \l Esri::ArcGISRuntime::Graphic in
   a \l Esri::ArcGISRuntime::GraphicsOverlay.
+
+  To avoid redrawing the scene for GPS jitter, the graphic is only updated when
+  the position moves by at least \l distanceThreshold meters or the heading turns
+  by at least \l headingThreshold degrees. Position and heading changes which arrive
+  together are applied to the graphic in a single update.
  */
 
 /*!
@@ -92,6 +100,7 @@ void LocationDisplay3d::stop()
 {
   m_locationOverlay->setVisible(false);
   m_lastKnownLocation = Point();
+  m_displayedLocation = Point();
 
   m_isStarted = false;
 }
@@ -150,10 +159,7 @@ void LocationDisplay3d::setPositionSource(QGeoPositionInfoSource* positionSource
 
     // display position 10m off the ground
     constexpr double elevatedZ = 10.0;
-    m_lastKnownLocation = Point(pos.longitude(), pos.latitude(), elevatedZ, SpatialReference::wgs84());
-    m_locationGraphic->setGeometry(m_lastKnownLocation);
-
-    emit locationChanged(m_lastKnownLocation);
+    setPosition(Point(pos.longitude(), pos.latitude(), elevatedZ, SpatialReference::wgs84()));
   });
 
   auto* gpxLocationSimulator = dynamic_cast<GPXLocationSimulator*>(m_geoPositionInfoSource);
@@ -164,7 +170,7 @@ void LocationDisplay3d::setPositionSource(QGeoPositionInfoSource* positionSource
 
     m_headingConnection = connect(gpxLocationSimulator, &GPXLocationSimulator::headingChanged, this, [this](double heading)
     {
-      m_locationGraphic->attributes()->replaceAttribute(s_headingAttribute, heading);
+      setHeading(heading);
     });
   }
 
@@ -202,7 +208,7 @@ void LocationDisplay3d::setCompass(QCompass* compass)
     if (!reading)
       return;
 
-    m_locationGraphic->attributes()->replaceAttribute(s_headingAttribute, static_cast<double>(reading->azimuth()));
+    setHeading(static_cast<double>(reading->azimuth()));
 
     emit headingChanged();
   });
@@ -256,6 +262,42 @@ void LocationDisplay3d::setDefaultSymbol(Symbol* defaultSymbol)
   }
 }
 
+/*!
+  \brief Returns the distance, in meters, the position must move before the graphic is updated.
+ */
+double LocationDisplay3d::distanceThreshold() const
+{
+  return m_distanceThreshold;
+}
+
+/*!
+  \brief Sets the distance, in meters, the position must move before the graphic is updated to \a distanceThreshold.
+
+  The default is \c 1.0.
+ */
+void LocationDisplay3d::setDistanceThreshold(double distanceThreshold)
+{
+  m_distanceThreshold = std::max(distanceThreshold, 0.0);
+}
+
+/*!
+  \brief Returns the angle, in degrees, the heading must turn before the graphic is updated.
+ */
+double LocationDisplay3d::headingThreshold() const
+{
+  return m_headingThreshold;
+}
+
+/*!
+  \brief Sets the angle, in degrees, the heading must turn before the graphic is updated to \a headingThreshold.
+
+  The default is \c 1.0.
+ */
+void LocationDisplay3d::setHeadingThreshold(double headingThreshold)
+{
+  m_headingThreshold = std::max(headingThreshold, 0.0);
+}
+
 /*!
   \internal
  */
@@ -264,11 +306,81 @@ void LocationDisplay3d::postLastKnownLocationUpdate()
   if (m_lastKnownLocation.isEmpty())
     return;
 
-  m_locationGraphic->setGeometry(m_lastKnownLocation);
+  scheduleGraphicUpdate();
+
+  emit locationChanged(m_lastKnownLocation);
+}
+
+/*!
+  \internal
+
+  Records the new \a location and schedules an update of the graphic.
+ */
+void LocationDisplay3d::setPosition(const Point& location)
+{
+  m_lastKnownLocation = location;
+  scheduleGraphicUpdate();
 
   emit locationChanged(m_lastKnownLocation);
 }
 
+/*!
+  \internal
+
+  Records the new \a heading and schedules an update of the graphic.
+ */
+void LocationDisplay3d::setHeading(double heading)
+{
+  m_heading = heading;
+  scheduleGraphicUpdate();
+}
+
+/*!
+  \internal
+
+  Defers the graphic update to the event loop so that position and heading
+  changes which arrive together are applied at once.
+ */
+void LocationDisplay3d::scheduleGraphicUpdate()
+{
+  if (m_graphicUpdateScheduled)
+    return;
+
+  m_graphicUpdateScheduled = true;
+  QTimer::singleShot(0, this, [this]()
+  {
+    applyGraphicUpdate();
+  });
+}
+
+/*!
+  \internal
+
+  Applies any position or heading change which exceeds its threshold to the graphic.
+ */
+void LocationDisplay3d::applyGraphicUpdate()
+{
+  m_graphicUpdateScheduled = false;
+
+  const bool moved = !m_lastKnownLocation.isEmpty() &&
+      (m_displayedLocation.isEmpty() || DsaUtility::distance3D(m_displayedLocation, m_lastKnownLocation) >= m_distanceThreshold);
+
+  // the smallest angle between the displayed and current heading
+  const bool turned = std::abs(std::remainder(m_heading - m_displayedHeading, 360.0)) >= m_headingThreshold;
+
+  if (moved)
+  {
+    m_displayedLocation = m_lastKnownLocation;
+    m_locationGraphic->setGeometry(m_displayedLocation);
+  }
+
+  if (turned)
+  {
+    m_displayedHeading = m_heading;
+    m_locationGraphic->attributes()->replaceAttribute(s_headingAttribute, m_displayedHeading);
+  }
+}
+
 } // Dsa
 
 // Signal Documentation
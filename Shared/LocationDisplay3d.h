@@ -61,6 +61,12 @@ public:
   Esri::ArcGISRuntime::Symbol* defaultSymbol() const;
   void setDefaultSymbol(Esri::ArcGISRuntime::Symbol* defaultSymbol);
 
+  double distanceThreshold() const;
+  void setDistanceThreshold(double distanceThreshold);
+
+  double headingThreshold() const;
+  void setHeadingThreshold(double headingThreshold);
+
 signals:
   void locationChanged(const Esri::ArcGISRuntime::Point& location);
   void headingChanged();
@@ -69,6 +75,10 @@ private:
   Q_DISABLE_COPY(LocationDisplay3d)
 
   void postLastKnownLocationUpdate();
+  void setPosition(const Esri::ArcGISRuntime::Point& location);
+  void setHeading(double heading);
+  void scheduleGraphicUpdate();
+  void applyGraphicUpdate();
 
   mutable Esri::ArcGISRuntime::GraphicsOverlay* m_locationOverlay = nullptr;
   Esri::ArcGISRuntime::SimpleRenderer* m_locationRenderer = nullptr;
@@ -77,6 +87,12 @@ private:
   QGeoPositionInfoSource* m_geoPositionInfoSource = nullptr;
   QCompass* m_compass = nullptr;
   Esri::ArcGISRuntime::Point m_lastKnownLocation;
+  Esri::ArcGISRuntime::Point m_displayedLocation;
+  double m_heading = 0.0;
+  double m_displayedHeading = 0.0;
+  double m_distanceThreshold = 1.0;
+  double m_headingThreshold = 1.0;
+  bool m_graphicUpdateScheduled = false;
   bool m_isStarted = false;
 
   QMetaObject::Connection m_positionErrorConnection;
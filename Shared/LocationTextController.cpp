@@ -20,6 +20,9 @@
 
 #include "LocationTextController.h"
 
+// example app headers
+#include "ElevationCache.h"
+
 // toolkit headers
 #include "ToolManager.h"
 #include "ToolResourceProvider.h"
@@ -71,6 +74,9 @@ LocationTextController::LocationTextController(QObject* parent) :
   connect(Toolkit::ToolResourceProvider::instance(), &Toolkit::ToolResourceProvider::locationChanged,
           this, &LocationTextController::onLocationChanged);
 
+  connect(ElevationCache::instance(), &ElevationCache::elevationCompleted,
+          this, &LocationTextController::onElevationCompleted);
+
   Toolkit::ToolManager::instance().addTool(this);
 }
 
@@ -132,7 +138,16 @@ void LocationTextController::onLocationChanged(const Point& pt)
     if (!m_surface)
       return;
 
-    m_surface->locationToElevation(pt);
+    // nearby fixes share a single terrain sample
+    double elevation = 0.0;
+    if (ElevationCache::instance()->cachedElevation(pt, elevation))
+    {
+      m_elevationTaskId = QUuid();
+      formatElevationText(elevation);
+      return;
+    }
+
+    m_elevationTaskId = ElevationCache::instance()->requestElevation(pt);
   }
 }
 
@@ -143,16 +158,23 @@ void LocationTextController::onGeoViewChanged()
 {
   Scene* scene = Toolkit::ToolResourceProvider::instance()->scene();
   if (scene)
-  {
     m_surface = scene->baseSurface();
+}
 
-    // connect the Surface::locationToElevationCompleted signal
-    connect(m_surface, &Surface::locationToElevationCompleted, this, [this](QUuid, double elevation)
-    {
-      // format the elevation for display in QML
-      formatElevationText(elevation);
-    });
-  }
+/*!
+ \brief Slot for ElevationCache::elevationCompleted.
+
+ Formats the \a elevation if \a taskId is the most recent request made by this tool.
+ */
+void LocationTextController::onElevationCompleted(const QUuid& taskId, double elevation)
+{
+  if (taskId != m_elevationTaskId)
+    return;
+
+  m_elevationTaskId = QUuid();
+
+  // format the elevation for display in QML
+  formatElevationText(elevation);
 }
 
 /*!
@@ -20,6 +20,9 @@
 // toolkit headers
 #include "AbstractTool.h"
 
+// Qt headers
+#include <QUuid>
+
 namespace Esri {
 namespace ArcGISRuntime {
 class Point;
@@ -59,6 +62,7 @@ signals:
 private slots:
   void onGeoViewChanged();
   void onLocationChanged(const Esri::ArcGISRuntime::Point& pt);
+  void onElevationCompleted(const QUuid& taskId, double elevation);
 
 private:
   std::function<QString(const Esri::ArcGISRuntime::Point&)> formatCoordinate;
@@ -82,6 +86,7 @@ private:
   static const QString Feet;
 
   Esri::ArcGISRuntime::Surface* m_surface = nullptr;
+  QUuid m_elevationTaskId;
   QString m_currentLocationText = "Location Unavailable";
   QString m_currentElevationText = "Elevation Unavailable";
   QString m_coordinateFormat;
@@ -24,14 +24,17 @@
 
 // C++ API headers
 #include "GeoView.h"
+#include "GeometryEngine.h"
 #include "Graphic.h"
 #include "GraphicListModel.h"
 #include "GraphicsOverlay.h"
 #include "Point.h"
+#include "SceneQuickView.h"
 #include "SimpleMarkerSceneSymbol.h"
+#include "Viewpoint.h"
 
 // Qt headers
-#include <QTimer>
+#include <QQuickWindow>
 
 using namespace Esri::ArcGISRuntime;
 
@@ -42,6 +45,13 @@ namespace Dsa {
   \inmodule Dsa
   \inherits QObject
   \brief Manager for an animated highlight graphic centered on a point.
+
+  The pulse is advanced once per frame rendered by the view's window, so it never
+  runs faster than the display refresh rate. The size of the pulse is derived from
+  the elapsed time, so the speed of the animation does not depend on the frame rate.
+
+  The animation is suspended while the window is hidden or when the highlighted
+  point is outside of the current view.
  */
 
 /*!
@@ -70,6 +80,15 @@ PointHighlighter::~PointHighlighter()
 void PointHighlighter::onPointChanged(const Point& point)
 {
   m_point = point;
+
+  if (!m_highlighting || !m_highlightOverlay || !m_highlightOverlay->graphics() || m_highlightOverlay->graphics()->isEmpty())
+    return;
+
+  Graphic* graphic = m_highlightOverlay->graphics()->first();
+  if (graphic)
+    graphic->setGeometry(m_point);
+
+  updatePointVisible();
 }
 
 /*!
@@ -86,62 +105,10 @@ void PointHighlighter::startHighlight()
   Graphic* highlightGraphic = new Graphic(m_point, m_highlightSymbol, this);
   m_highlightOverlay->graphics()->append(highlightGraphic);
 
-  if (m_highlightTimer)
-  {
-    disconnect(m_timerConnection);
-    m_highlightTimer->stop();
-    delete m_highlightTimer;
-    m_highlightTimer = nullptr;
-  }
-
-  m_highlightTimer = new QTimer(this);
-  m_timerConnection = connect(m_highlightTimer, &QTimer::timeout, this, [this]()
-  {
-    if (!m_highlightSymbol)
-    {
-      m_highlightTimer->stop();
-      return;
-    }
-
-    if (!m_highlightOverlay || !m_highlightOverlay->graphics() || m_highlightOverlay->graphics()->isEmpty())
-    {
-      m_highlightTimer->stop();
-      return;
-    }
-
-    Graphic* graphic = m_highlightOverlay->graphics()->first();
-    if (!graphic)
-    {
-      m_highlightTimer->stop();
-      return;
-    }
-
-    graphic->setGeometry(m_point);
-
-    const int currDim = m_highlightSymbol->width();
-    constexpr int maxDimension = 1000;
-    int newDimension = currDim;
-    float newOpacity = m_highlightOverlay->opacity();
-    if (currDim < maxDimension)
-    {
-      newDimension += 10;
-      newOpacity -= 0.01f;
-    }
-    else
-    {
-      newDimension = 1;
-    }
-
-    if (currDim > 10 && currDim < 30)
-      newOpacity = 1.0f;
-
-    m_highlightSymbol->setWidth(newDimension);
-    m_highlightSymbol->setHeight(newDimension);
-    m_highlightSymbol->setDepth(newDimension);
-    m_highlightOverlay->setOpacity(newOpacity);
-  });
-
-  m_highlightTimer->start(10);
+  m_highlighting = true;
+  m_animationClock.start();
+  updatePointVisible();
+  requestFrame();
 }
 
 /*!
@@ -149,6 +116,8 @@ void PointHighlighter::startHighlight()
  */
 void PointHighlighter::stopHighlight()
 {
+  m_highlighting = false;
+
   if (!m_highlightOverlay || !m_highlightOverlay->graphics() || m_highlightOverlay->graphics()->isEmpty())
     return;
 
@@ -158,14 +127,6 @@ void PointHighlighter::stopHighlight()
     delete graphic;
     m_highlightOverlay->graphics()->clear();
   }
-
-  if (m_highlightTimer)
-  {
-    disconnect(m_timerConnection);
-    m_highlightTimer->stop();
-    delete m_highlightTimer;
-    m_highlightTimer = nullptr;
-  }
 }
 
 /*!
@@ -173,6 +134,8 @@ void PointHighlighter::stopHighlight()
  */
 void PointHighlighter::onGeoViewChanged()
 {
+  disconnectView();
+
   if (m_highlightOverlay)
   {
     delete m_highlightOverlay;
@@ -185,6 +148,8 @@ void PointHighlighter::onGeoViewChanged()
     m_highlightSymbol = nullptr;
   }
 
+  m_highlighting = false;
+
   GeoView* geoview = Toolkit::ToolResourceProvider::instance()->geoView();
   if (!geoview)
     return;
@@ -197,6 +162,144 @@ void PointHighlighter::onGeoViewChanged()
 
   m_highlightSymbol = new SimpleMarkerSceneSymbol(
         SimpleMarkerSceneSymbolStyle::Sphere, Qt::red, 1.0, 1.0, 1.0, SceneSymbolAnchorPosition::Center, this);
+
+  m_sceneView = dynamic_cast<SceneQuickView*>(geoview);
+  if (!m_sceneView)
+    return;
+
+  // the point can move in or out of view whenever the camera changes
+  m_viewpointConnection = connect(m_sceneView.data(), &SceneQuickView::viewpointChanged, this, [this]()
+  {
+    if (m_highlighting)
+      updatePointVisible();
+  });
+
+  // drive the animation from the frame clock of the window displaying the view
+  auto connectWindow = [this](QQuickWindow* window)
+  {
+    if (m_frameConnection)
+      disconnect(m_frameConnection);
+
+    if (m_windowVisibilityConnection)
+      disconnect(m_windowVisibilityConnection);
+
+    m_window = window;
+    if (!m_window)
+      return;
+
+    // frameSwapped is emitted on the render thread so the slot is queued to this thread
+    m_frameConnection = connect(m_window.data(), &QQuickWindow::frameSwapped, this, &PointHighlighter::onFrameSwapped, Qt::QueuedConnection);
+    m_windowVisibilityConnection = connect(m_window.data(), &QWindow::visibilityChanged, this, [this]()
+    {
+      requestFrame();
+    });
+  };
+
+  m_windowChangedConnection = connect(m_sceneView.data(), &QQuickItem::windowChanged, this, connectWindow);
+  connectWindow(m_sceneView->window());
+}
+
+/*!
+  \internal
+
+  Advances the pulse for the frame which has just been displayed.
+ */
+void PointHighlighter::onFrameSwapped()
+{
+  if (!m_highlighting || !canAnimate())
+    return;
+
+  if (!m_highlightSymbol || !m_highlightOverlay)
+    return;
+
+  // one pulse per second, growing from 1 to 1000 pixels while fading out
+  constexpr qint64 pulseDuration = 1000;
+  constexpr double maxDimension = 1000.0;
+  const double phase = static_cast<double>(m_animationClock.elapsed() % pulseDuration) / pulseDuration;
+  const double newDimension = 1.0 + phase * (maxDimension - 1.0);
+
+  m_highlightSymbol->setWidth(newDimension);
+  m_highlightSymbol->setHeight(newDimension);
+  m_highlightSymbol->setDepth(newDimension);
+  m_highlightOverlay->setOpacity(static_cast<float>(1.0 - phase));
+
+  requestFrame();
+}
+
+/*!
+  \internal
+
+  Returns whether the window is showing and the highlighted point is in view.
+ */
+bool PointHighlighter::canAnimate() const
+{
+  if (!m_window || !m_window->isExposed())
+    return false;
+
+  const QWindow::Visibility visibility = m_window->visibility();
+  if (visibility == QWindow::Hidden || visibility == QWindow::Minimized)
+    return false;
+
+  return m_pointVisible;
+}
+
+/*!
+  \internal
+
+  Schedules another frame if the animation should continue.
+ */
+void PointHighlighter::requestFrame()
+{
+  if (!m_highlighting || !canAnimate())
+    return;
+
+  m_window->update();
+}
+
+/*!
+  \internal
+
+  Tests whether the highlighted point lies within the visible area of the view.
+ */
+void PointHighlighter::updatePointVisible()
+{
+  const bool wasVisible = m_pointVisible;
+  m_pointVisible = true;
+
+  if (m_sceneView && !m_point.isEmpty())
+  {
+    const Geometry visibleArea = m_sceneView->currentViewpoint(ViewpointType::BoundingGeometry).targetGeometry();
+    if (!visibleArea.isEmpty())
+    {
+      const Geometry projectedPoint = GeometryEngine::project(m_point, visibleArea.spatialReference());
+      m_pointVisible = GeometryEngine::intersects(visibleArea, projectedPoint);
+    }
+  }
+
+  // resume a suspended animation
+  if (m_pointVisible && !wasVisible)
+    requestFrame();
+}
+
+/*!
+  \internal
+ */
+void PointHighlighter::disconnectView()
+{
+  if (m_frameConnection)
+    disconnect(m_frameConnection);
+
+  if (m_windowVisibilityConnection)
+    disconnect(m_windowVisibilityConnection);
+
+  if (m_viewpointConnection)
+    disconnect(m_viewpointConnection);
+
+  if (m_windowChangedConnection)
+    disconnect(m_windowChangedConnection);
+
+  m_sceneView.clear();
+  m_window.clear();
 }
 
 } // Dsa
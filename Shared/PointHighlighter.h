@@ -21,16 +21,19 @@
 #include "Point.h"
 
 // Qt headers
+#include <QElapsedTimer>
 #include <QObject>
+#include <QPointer>
 
 namespace Esri {
 namespace ArcGISRuntime {
 class GraphicsOverlay;
+class SceneQuickView;
 class SimpleMarkerSceneSymbol;
 }
 }
 
-class QTimer;
+class QQuickWindow;
 
 namespace Dsa {
 
@@ -50,13 +53,26 @@ public slots:
 
 private slots:
   void onGeoViewChanged();
+  void onFrameSwapped();
 
 private:
+  bool canAnimate() const;
+  void requestFrame();
+  void updatePointVisible();
+  void disconnectView();
+
   Esri::ArcGISRuntime::GraphicsOverlay* m_highlightOverlay = nullptr;
   Esri::ArcGISRuntime::SimpleMarkerSceneSymbol* m_highlightSymbol = nullptr;
   Esri::ArcGISRuntime::Point m_point;
-  QTimer* m_highlightTimer = nullptr;
-  QMetaObject::Connection m_timerConnection;
+  QPointer<Esri::ArcGISRuntime::SceneQuickView> m_sceneView;
+  QPointer<QQuickWindow> m_window;
+  QElapsedTimer m_animationClock;
+  bool m_highlighting = false;
+  bool m_pointVisible = true;
+  QMetaObject::Connection m_frameConnection;
+  QMetaObject::Connection m_windowVisibilityConnection;
+  QMetaObject::Connection m_viewpointConnection;
+  QMetaObject::Connection m_windowChangedConnection;
 };
 
 } // Dsa
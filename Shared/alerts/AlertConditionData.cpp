@@ -21,6 +21,7 @@
 
 // example app headers
 #include "AlertCondition.h"
+#include "AlertEvaluator.h"
 #include "AlertSource.h"
 #include "AlertTarget.h"
 
@@ -45,6 +46,11 @@ namespace Dsa {
   When either the source or target is changed for a given data element, the condition can be
   re-tested using an \l AlertQuery to determine whether an alert should be triggered.
 
+  Any change to the target causes the query to be re-tested. Changes to the source are
+  only handled for the parts of the source the query depends upon: derived types
+  connect the relevant \l AlertSource::locationChanged or \l AlertSource::attributeChanged
+  signal to \l handleDataChanged.
+
   \note This is an abstract base type.
 
   \sa AlertSource
@@ -77,13 +83,17 @@ AlertConditionData::AlertConditionData(const QString& name,
   m_target(target)
 {
   connect(m_source, &AlertSource::noLongerValid, this, &AlertConditionData::noLongerValid);
-  connect(m_source, &AlertSource::dataChanged, this, &AlertConditionData::handleDataChanged);
   connect(m_source, &AlertSource::destroyed, this, [this]()
   {
     m_source = nullptr;
     emit noLongerValid();
   });
   connect(m_target, &AlertTarget::dataChanged, this, &AlertConditionData::handleDataChanged);
+  connect(m_target, &AlertTarget::areaChanged, this, [this](const Envelope& changedArea)
+  {
+    if (isQueryAreaAffected(changedArea))
+      handleDataChanged();
+  });
   connect(m_target, &AlertTarget::destroyed, this, [this]()
   {
     m_target = nullptr;
@@ -239,6 +249,30 @@ AlertTarget* AlertConditionData::target() const
   return m_target;
 }
 
+/*!
+  \brief Returns whether a change to the target within the WGS84 \a changedArea
+  could change the result of the query.
+
+  The default implementation returns \c true.
+ */
+bool AlertConditionData::isQueryAreaAffected(const Envelope&) const
+{
+  return true;
+}
+
+/*!
+  \brief Returns a function which evaluates the query from a snapshot of its inputs.
+
+  The snapshot is taken on the calling (GUI) thread. The returned function must only use
+  value types captured in the snapshot, so that it can be run on a worker thread by the
+  \l AlertEvaluator. The default implementation returns an empty function, meaning that the
+  query is cheap enough to be run directly with \l matchesQuery.
+ */
+std::function<bool()> AlertConditionData::queryFunction() const
+{
+  return std::function<bool()>();
+}
+
 /*!
   \brief Returns the cached value from the last time the underlying query
   was run.
@@ -257,9 +291,7 @@ bool AlertConditionData::isQueryOutOfDate() const
 }
 
 /*!
-  \brief Internal.
-
-  Respond to changes to the underlying source or target data.
+  \brief Re-tests the query in response to changes to the underlying source or target data.
  */
 void AlertConditionData::handleDataChanged()
 {
@@ -269,8 +301,38 @@ void AlertConditionData::handleDataChanged()
   // set the query flag to out-of-date to force a new query to be run
   m_queryOutOfDate = true;
 
-  // run the query and cache whether this condition has now been met
-  m_cachedQueryResult = matchesQuery();
+  // when evaluating on worker threads, the result is applied once the batch completes
+  if (AlertEvaluator::instance()->isParallel())
+  {
+    AlertEvaluator::instance()->schedule(this);
+    return;
+  }
+
+  evaluate();
+}
+
+/*!
+  \internal
+
+  Runs the query on the calling thread and applies the result.
+ */
+void AlertConditionData::evaluate()
+{
+  // set the query flag to out-of-date to force a new query to be run
+  m_queryOutOfDate = true;
+
+  applyQueryResult(matchesQuery());
+}
+
+/*!
+  \internal
+
+  Caches the query \a result and updates the active state.
+ */
+void AlertConditionData::applyQueryResult(bool result)
+{
+  // cache whether this condition has now been met
+  m_cachedQueryResult = result;
 
   // the query is now up-to-date
   m_queryOutOfDate = false;
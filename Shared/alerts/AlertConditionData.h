@@ -21,6 +21,7 @@
 #include "AlertLevel.h"
 
 // C++ API headers
+#include "Envelope.h"
 #include "Point.h"
 
 // Qt headers
@@ -28,6 +29,9 @@
 #include <QString>
 #include <QUuid>
 
+// STL headers
+#include <functional>
+
 namespace Dsa {
 
 class AlertSource;
@@ -63,6 +67,8 @@ public:
   AlertTarget* target() const;
 
   virtual bool matchesQuery() const = 0;
+  virtual bool isQueryAreaAffected(const Esri::ArcGISRuntime::Envelope& changedArea) const;
+  virtual std::function<bool()> queryFunction() const;
 
   bool cachedQueryResult() const;
   bool isQueryOutOfDate() const;
@@ -77,11 +83,15 @@ signals:
   void activeChanged();
   void noLongerValid();
 
-private slots:
+protected slots:
   void handleDataChanged();
 
 private:
+  friend class AlertEvaluator;
+
   void setActive(bool active);
+  void evaluate();
+  void applyQueryResult(bool result);
 
   QString m_name;
   AlertLevel m_level = AlertLevel::Unknown;
@@ -24,6 +24,7 @@
 #include "AlertConditionData.h"
 #include "AlertConditionListModel.h"
 #include "AlertConstants.h"
+#include "AlertEvaluator.h"
 #include "AlertListModel.h"
 #include "AttributeEqualsAlertCondition.h"
 #include "FeatureLayerAlertTarget.h"
@@ -125,12 +126,18 @@ QString AlertConditionsController::toolName() const
  * \list
  *  \li Conditions. A list of JSON objects describing alert conditions to be added to the map.
  *  \li MessageFeeds. A list of real-time feeds to be used as condition sources.
+ *  \li AlertEvaluationThreads. The number of worker threads used to evaluate conditions (see \l AlertEvaluator).
  * \endlist
  */
 void AlertConditionsController::setProperties(const QVariantMap& properties)
 {
   const auto conditionsData = properties[AlertConstants::ALERT_CONDITIONS_PROPERTYNAME];
 
+  // 0 evaluates conditions on the GUI thread, a negative value uses a worker per core
+  auto evaluationThreadsFindIt = properties.find(AlertConstants::ALERT_EVALUATION_THREADS_PROPERTYNAME);
+  if (evaluationThreadsFindIt != properties.end())
+    AlertEvaluator::instance()->setWorkerCount(evaluationThreadsFindIt.value().toInt());
+
   const auto messageFeeds = properties[MessageFeedConstants::MESSAGE_FEEDS_PROPERTYNAME].toList();
   if (!messageFeeds.isEmpty())
   {
@@ -27,6 +27,7 @@
 namespace Dsa {
 
 const QString AlertConstants::ALERT_CONDITIONS_PROPERTYNAME = "Conditions";
+const QString AlertConstants::ALERT_EVALUATION_THREADS_PROPERTYNAME = "AlertEvaluationThreads";
 const QString AlertConstants::ATTRIBUTE_NAME = "attribute_name";
 const QString AlertConstants::CONDITION_TYPE = "condition_type";
 const QString AlertConstants::CONDITION_NAME = "name";
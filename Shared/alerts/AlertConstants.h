@@ -25,6 +25,7 @@ namespace Dsa {
 class AlertConstants {
 public:
   static const QString ALERT_CONDITIONS_PROPERTYNAME;
+  static const QString ALERT_EVALUATION_THREADS_PROPERTYNAME;
   static const QString ATTRIBUTE_NAME;
   static const QString CONDITION_TYPE;
   static const QString CONDITION_NAME;
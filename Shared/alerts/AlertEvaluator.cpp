@@ -0,0 +1,343 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+// PCH header
+#include "pch.hpp"
+
+#include "AlertEvaluator.h"
+
+// example app headers
+#include "AlertConditionData.h"
+
+// Qt headers
+#include <QAtomicInt>
+#include <QRunnable>
+#include <QThread>
+#include <QTimer>
+#include <QVector>
+
+// STL headers
+#include <algorithm>
+#include <functional>
+
+namespace Dsa {
+
+/*!
+  \internal
+
+  The queries of a batch, their results and the number of tasks still running.
+ */
+struct AlertEvaluator::Batch
+{
+  QVector<QPointer<AlertConditionData>> data;
+  QVector<std::function<bool()>> queries;
+  QVector<char> results;
+  QAtomicInt remainingTasks;
+  QElapsedTimer timer;
+};
+
+/*!
+  \internal
+
+  Runs the queries in the range [\a begin, \a end) of a batch on a worker thread.
+ */
+class AlertEvaluator::EvaluationTask : public QRunnable
+{
+public:
+  EvaluationTask(AlertEvaluator* evaluator, std::shared_ptr<Batch> batch, int begin, int end):
+    m_evaluator(evaluator),
+    m_batch(std::move(batch)),
+    m_begin(begin),
+    m_end(end)
+  {
+  }
+
+  void run() override
+  {
+    for (int i = m_begin; i < m_end; ++i)
+      m_batch->results[i] = m_batch->queries.at(i)() ? 1 : 0;
+
+    // the last task to finish hands the results back to the GUI thread
+    if (!m_batch->remainingTasks.deref())
+      QMetaObject::invokeMethod(m_evaluator, "applyBatch", Qt::QueuedConnection);
+  }
+
+private:
+  AlertEvaluator* m_evaluator = nullptr;
+  std::shared_ptr<Batch> m_batch;
+  int m_begin = 0;
+  int m_end = 0;
+};
+
+/*!
+  \class Dsa::AlertEvaluator
+  \inmodule Dsa
+  \inherits QObject
+  \brief Evaluates the queries of \l AlertConditionData on a pool of worker threads.
+
+  By default (a \l workerCount of \c 0) every query is run on the GUI thread as soon as
+  its source or target changes. When worker threads are enabled, changed condition data
+  is collected and evaluated in batches:
+
+  \list
+    \li On the GUI thread, each condition data takes a snapshot of the geometries its query
+      needs (see \l AlertConditionData::queryFunction).
+    \li The geometric tests for the snapshots are shared out over the thread pool.
+    \li The results are applied back to the condition data on the GUI thread in one pass.
+  \endlist
+
+  Only one batch runs at a time; condition data which changes while a batch is running is
+  evaluated in the next batch. The size and duration of each batch are recorded, so that
+  the throughput for different numbers of workers can be compared.
+ */
+
+/*!
+  \brief Static method to return a singleton instance of the evaluator.
+ */
+AlertEvaluator* AlertEvaluator::instance()
+{
+  static AlertEvaluator s_instance;
+
+  return &s_instance;
+}
+
+/*!
+  \brief Constructor taking an optional \a parent.
+ */
+AlertEvaluator::AlertEvaluator(QObject* parent):
+  QObject(parent)
+{
+}
+
+/*!
+  \brief Destructor.
+ */
+AlertEvaluator::~AlertEvaluator()
+{
+  m_pool.waitForDone();
+}
+
+/*!
+  \brief Returns whether queries are evaluated on worker threads.
+ */
+bool AlertEvaluator::isParallel() const
+{
+  return m_workerCount > 0;
+}
+
+/*!
+  \brief Returns the number of worker threads used to evaluate queries.
+
+  A value of \c 0 means that queries are evaluated on the GUI thread.
+ */
+int AlertEvaluator::workerCount() const
+{
+  return m_workerCount;
+}
+
+/*!
+  \brief Sets the number of worker threads used to evaluate queries to \a workerCount.
+
+  A value of \c 0 evaluates queries on the GUI thread. A negative value uses one worker
+  per processor core.
+ */
+void AlertEvaluator::setWorkerCount(int workerCount)
+{
+  if (workerCount < 0)
+    workerCount = QThread::idealThreadCount();
+
+  if (workerCount == m_workerCount)
+    return;
+
+  m_workerCount = workerCount;
+  if (m_workerCount > 0)
+    m_pool.setMaxThreadCount(m_workerCount);
+}
+
+/*!
+  \brief Schedules \a data to be evaluated in the next batch.
+ */
+void AlertEvaluator::schedule(AlertConditionData* data)
+{
+  if (!data || m_pendingSet.contains(data))
+    return;
+
+  m_pendingSet.insert(data);
+  m_pending.append(data);
+
+  // a deleted data's address can be reused, so it must not stay in the pending set
+  connect(data, &QObject::destroyed, this, &AlertEvaluator::onDataDestroyed, Qt::UniqueConnection);
+
+  // wait for the running batch to be applied before starting another
+  if (m_batchRequested || m_batch)
+    return;
+
+  m_batchRequested = true;
+  QTimer::singleShot(0, this, &AlertEvaluator::runBatch);
+}
+
+/*!
+  \brief Returns the total number of queries evaluated in batches whose results were applied.
+
+  Queries whose condition data was deleted, disabled or scheduled again before the
+  batch finished are not counted.
+ */
+quint64 AlertEvaluator::evaluationCount() const
+{
+  return m_evaluationCount;
+}
+
+/*!
+  \brief Returns the number of queries in the last batch whose results were applied.
+ */
+int AlertEvaluator::lastBatchSize() const
+{
+  return m_lastBatchSize;
+}
+
+/*!
+  \brief Returns the time, in milliseconds, taken to snapshot, evaluate and apply the last batch.
+ */
+qint64 AlertEvaluator::lastBatchElapsed() const
+{
+  return m_lastBatchElapsed;
+}
+
+/*!
+  \brief Returns the average number of queries evaluated per second across all batches.
+ */
+double AlertEvaluator::evaluationsPerSecond() const
+{
+  if (m_totalElapsed <= 0)
+    return 0.0;
+
+  return m_evaluationCount * 1000.0 / m_totalElapsed;
+}
+
+/*!
+  \internal
+
+  Takes snapshots of the pending queries and starts them on the thread pool.
+ */
+void AlertEvaluator::runBatch()
+{
+  m_batchRequested = false;
+  if (m_batch || m_pending.isEmpty())
+    return;
+
+  auto batch = std::make_shared<Batch>();
+  batch->timer.start();
+
+  const QList<QPointer<AlertConditionData>> pending = m_pending;
+  m_pending.clear();
+  m_pendingSet.clear();
+
+  for (const QPointer<AlertConditionData>& data : pending)
+  {
+    if (!data || !data->isConditionEnabled())
+      continue;
+
+    std::function<bool()> query = data->queryFunction();
+
+    // queries without a snapshot are cheap enough to run here
+    if (!query)
+    {
+      data->evaluate();
+      continue;
+    }
+
+    batch->data.append(data);
+    batch->queries.append(std::move(query));
+  }
+
+  const int count = batch->queries.size();
+  if (count == 0)
+    return;
+
+  batch->results.fill(0, count);
+
+  // use a few tasks per worker so that uneven queries are balanced across the pool
+  const int workers = std::max(m_workerCount, 1);
+  const int taskCount = std::min(count, workers * 4);
+  const int chunkSize = (count + taskCount - 1) / taskCount;
+  const int chunkCount = (count + chunkSize - 1) / chunkSize;
+
+  batch->remainingTasks.store(chunkCount);
+  m_batch = batch;
+
+  for (int begin = 0; begin < count; begin += chunkSize)
+    m_pool.start(new EvaluationTask(this, batch, begin, std::min(begin + chunkSize, count)));
+}
+
+/*!
+  \internal
+
+  Applies the results of the running batch on the GUI thread.
+ */
+void AlertEvaluator::applyBatch()
+{
+  std::shared_ptr<Batch> batch = std::move(m_batch);
+  m_batch.reset();
+  if (!batch)
+    return;
+
+  const int count = batch->data.size();
+  int appliedCount = 0;
+  for (int i = 0; i < count; ++i)
+  {
+    AlertConditionData* data = batch->data.at(i);
+
+    // skip data which has been deleted, or re-scheduled with newer inputs
+    if (!data || !data->isConditionEnabled() || m_pendingSet.contains(data))
+      continue;
+
+    data->applyQueryResult(batch->results.at(i) != 0);
+    ++appliedCount;
+  }
+
+  m_evaluationCount += appliedCount;
+  m_lastBatchSize = appliedCount;
+  m_lastBatchElapsed = batch->timer.elapsed();
+  m_totalElapsed += m_lastBatchElapsed;
+
+  emit batchEvaluated(m_lastBatchSize, m_lastBatchElapsed);
+
+  if (!m_pending.isEmpty() && !m_batchRequested)
+  {
+    m_batchRequested = true;
+    QTimer::singleShot(0, this, &AlertEvaluator::runBatch);
+  }
+}
+
+/*!
+  \internal
+
+  Forgets the pending entry of a condition data \a object which has been deleted.
+ */
+void AlertEvaluator::onDataDestroyed(QObject* object)
+{
+  m_pendingSet.remove(object);
+}
+
+} // Dsa
+
+// Signal Documentation
+/*!
+  \fn void AlertEvaluator::batchEvaluated(int batchSize, qint64 elapsedMs);
+  \brief Signal emitted when a batch of \a batchSize queries has been applied,
+  \a elapsedMs milliseconds after it was started.
+ */
@@ -0,0 +1,86 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#ifndef ALERTEVALUATOR_H
+#define ALERTEVALUATOR_H
+
+// Qt headers
+#include <QElapsedTimer>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QThreadPool>
+
+// STL headers
+#include <memory>
+
+namespace Dsa {
+
+class AlertConditionData;
+
+class AlertEvaluator : public QObject
+{
+  Q_OBJECT
+
+public:
+  static AlertEvaluator* instance();
+
+  ~AlertEvaluator();
+
+  bool isParallel() const;
+
+  int workerCount() const;
+  void setWorkerCount(int workerCount);
+
+  void schedule(AlertConditionData* data);
+
+  quint64 evaluationCount() const;
+  int lastBatchSize() const;
+  qint64 lastBatchElapsed() const;
+  double evaluationsPerSecond() const;
+
+signals:
+  void batchEvaluated(int batchSize, qint64 elapsedMs);
+
+private slots:
+  void applyBatch();
+  void onDataDestroyed(QObject* object);
+
+private:
+  struct Batch;
+  class EvaluationTask;
+
+  AlertEvaluator(QObject* parent = nullptr);
+
+  void runBatch();
+
+  QThreadPool m_pool;
+  int m_workerCount = 0;
+  QList<QPointer<AlertConditionData>> m_pending;
+  QSet<QObject*> m_pendingSet;
+  std::shared_ptr<Batch> m_batch;
+  bool m_batchRequested = false;
+  quint64 m_evaluationCount = 0;
+  int m_lastBatchSize = 0;
+  qint64 m_lastBatchElapsed = 0;
+  qint64 m_totalElapsed = 0;
+};
+
+} // Dsa
+
+#endif // ALERTEVALUATOR_H
@@ -171,7 +171,7 @@ void AlertListController::highlight(int rowIndex, bool showHighlight)
       m_highlighter->stopHighlight();
     }));
 
-    m_highlightConnections.append(connect(conditionData->source(), &AlertSource::dataChanged, this, [this, conditionData]()
+    m_highlightConnections.append(connect(conditionData->source(), &AlertSource::locationChanged, this, [this, conditionData]()
     {
       if (!conditionData)
         return;
@@ -29,6 +29,11 @@ namespace Dsa {
   \inherits QObject
   \brief Represents a source (generally a real-time feed) for an \l AlertCondition.
 
+  Implementations emit \l locationChanged when the location moves and
+  \l attributeChanged for each attribute whose value changes, followed by
+  \l dataChanged. Condition data should connect to the typed signals for the
+  parts of the source their query depends upon.
+
   \note This is an abstract base type.
   */
 
@@ -55,6 +60,18 @@ AlertSource::~AlertSource()
 /*!
   \fn void AlertSource::dataChanged();
   \brief Signal emitted when alert source's data changes.
+
+  This is emitted after \l locationChanged or \l attributeChanged.
+ */
+
+/*!
+  \fn void AlertSource::locationChanged();
+  \brief Signal emitted when the location of the alert source changes.
+ */
+
+/*!
+  \fn void AlertSource::attributeChanged(const QString& attributeName);
+  \brief Signal emitted when the value of the attribute \a attributeName changes.
  */
 
 /*!
@@ -41,6 +41,8 @@ public:
 
 signals:
   void dataChanged();
+  void locationChanged();
+  void attributeChanged(const QString& attributeName);
   void noLongerValid();
 };
 
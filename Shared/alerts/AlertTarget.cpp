@@ -20,6 +20,14 @@
 
 #include "AlertTarget.h"
 
+// example app headers
+#include "PreparedPolygon.h"
+
+// C++ API headers
+#include "Geometry.h"
+
+using namespace Esri::ArcGISRuntime;
+
 namespace Dsa {
 
 /*!
@@ -47,6 +55,26 @@ AlertTarget::~AlertTarget()
   emit noLongerValid();
 }
 
+/*!
+  \brief Returns the polygons in the \a targetArea, prepared for point-in-polygon tests.
+
+  The default implementation prepares the polygons from \l targetGeometries on every call.
+  Types which know when their geometry changes should override this to re-use
+  the prepared polygons.
+ */
+QList<std::shared_ptr<const PreparedPolygon>> AlertTarget::targetPolygons(const Envelope& targetArea) const
+{
+  QList<std::shared_ptr<const PreparedPolygon>> polygons;
+  const QList<Geometry> geometries = targetGeometries(targetArea);
+  for (const Geometry& geometry : geometries)
+  {
+    if (geometry.geometryType() == GeometryType::Polygon)
+      polygons.append(std::make_shared<const PreparedPolygon>(geometry));
+  }
+
+  return polygons;
+}
+
 } // Dsa
 
 // Signal Documentation
@@ -58,5 +86,15 @@ AlertTarget::~AlertTarget()
 /*!
   \fn void AlertTarget::dataChanged();
   \brief Signal emitted when alert target's data changes.
+
+  All condition data using the target will be re-tested.
+ */
+
+/*!
+  \fn void AlertTarget::areaChanged(const Esri::ArcGISRuntime::Envelope& changedArea);
+  \brief Signal emitted when a single element of the alert target changes.
+
+  \a changedArea is the WGS84 extent covering the old and new positions of the element.
+  Only condition data whose query could be affected by a change in this area will be re-tested.
  */
 
@@ -17,21 +17,28 @@
 #ifndef ALERTTARGET_H
 #define ALERTTARGET_H
 
+// C++ API headers
+#include "Envelope.h"
+
 // Qt headers
 #include <QObject>
 #include <QVariant>
 
+// STL headers
+#include <memory>
+
 namespace Esri
 {
 namespace ArcGISRuntime
 {
-  class Envelope;
   class Geometry;
 }
 }
 
 namespace Dsa {
 
+class PreparedPolygon;
+
 class AlertTarget : public QObject
 {
   Q_OBJECT
@@ -42,10 +49,12 @@ public:
 
   virtual QList<Esri::ArcGISRuntime::Geometry> targetGeometries(const Esri::ArcGISRuntime::Envelope& targetArea) const = 0;
   virtual QVariant targetValue() const = 0;
+  virtual QList<std::shared_ptr<const PreparedPolygon>> targetPolygons(const Esri::ArcGISRuntime::Envelope& targetArea) const;
 
 signals:
   void noLongerValid();
   void dataChanged();
+  void areaChanged(const Esri::ArcGISRuntime::Envelope& changedArea);
 };
 
 } // Dsa
@@ -21,7 +21,9 @@
 
 // example app headers
 #include "AlertConstants.h"
+#include "AlertTarget.h"
 #include "AttributeEqualsAlertConditionData.h"
+#include "AttributeEqualsIndex.h"
 
 using namespace Esri::ArcGISRuntime;
 
@@ -35,6 +37,9 @@ namespace Dsa {
   trigger an alert when a source object's attribute matches the target value.
 
   This condition will create new \l AttributeEqualsAlertConditionData to track source and target objects.
+
+  The condition data for each target share an \l AttributeEqualsIndex, so that a change
+  to a source only costs a hash update and only re-tests condition data whose match state changes.
   */
 
 /*!
@@ -64,7 +69,20 @@ AttributeEqualsAlertCondition::~AttributeEqualsAlertCondition()
  */
 AlertConditionData* AttributeEqualsAlertCondition::createData(AlertSource* source, AlertTarget* target)
 {
-  return new AttributeEqualsAlertConditionData(newConditionDataName(), level(), source, target, m_attributeName, this);
+  AttributeEqualsIndex* index = m_indexes.value(target);
+  if (!index && target)
+  {
+    index = new AttributeEqualsIndex(m_attributeName, target, this);
+    m_indexes.insert(target, index);
+
+    // existing condition data may still refer to the index, so it is kept until the condition is destroyed
+    connect(target, &AlertTarget::destroyed, this, [this, target]()
+    {
+      m_indexes.remove(target);
+    });
+  }
+
+  return new AttributeEqualsAlertConditionData(newConditionDataName(), level(), source, target, m_attributeName, index, this);
 }
 
 /*!
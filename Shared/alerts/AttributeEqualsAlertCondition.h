@@ -21,10 +21,13 @@
 #include "AlertCondition.h"
 
 // Qt headers
+#include <QHash>
 #include <QObject>
 
 namespace Dsa {
 
+class AttributeEqualsIndex;
+
 class AttributeEqualsAlertCondition : public AlertCondition
 {
   Q_OBJECT
@@ -46,6 +49,7 @@ public:
 
 private:
   QString m_attributeName;
+  QHash<AlertTarget*, AttributeEqualsIndex*> m_indexes;
 };
 
 } // Dsa
@@ -22,6 +22,7 @@
 // example app headers
 #include "AlertSource.h"
 #include "AlertTarget.h"
+#include "AttributeEqualsIndex.h"
 
 using namespace Esri::ArcGISRuntime;
 
@@ -37,6 +38,10 @@ namespace Dsa {
   a given query of the form "[my_attribute] = [my_value]".
 
   The target should be a fixed value whereas the attributes of the source object may change.
+
+  When an \l AttributeEqualsIndex is supplied, the query is answered by the index and the
+  index decides when the query needs to be re-tested, rather than each condition data
+  listening to its own source and target.
  */
 
 /*!
@@ -49,6 +54,7 @@ namespace Dsa {
       \l Esri::ArcGISRuntime::Graphic or a location).
     \li \a target. The target data for the condition. This should be a fixed value.
     \li \a attributeName. The name of the attribute in the source object to be queried.
+    \li \a index. The (optional) index shared by the condition data for the target.
     \li \a parent. The (optional) parent object.
   \endlist
  */
@@ -57,11 +63,26 @@ AttributeEqualsAlertConditionData::AttributeEqualsAlertConditionData(const QStri
                                                                      AlertSource* source,
                                                                      AlertTarget* target,
                                                                      const QString& attributeName,
+                                                                     AttributeEqualsIndex* index,
                                                                      QObject* parent):
   AlertConditionData(name, level, source, target, parent),
-  m_attributeName(attributeName)
+  m_attributeName(attributeName),
+  m_index(index)
 {
-
+  if (m_index)
+  {
+    // the index re-tests this data only when its source starts or stops matching the target
+    disconnect(target, &AlertTarget::dataChanged, this, nullptr);
+    m_index->addSource(source, this);
+    return;
+  }
+
+  // the query only depends upon the value of a single attribute
+  connect(source, &AlertSource::attributeChanged, this, [this](const QString& changedAttribute)
+  {
+    if (changedAttribute == m_attributeName)
+      handleDataChanged();
+  });
 }
 
 /*!
@@ -81,15 +102,15 @@ bool AttributeEqualsAlertConditionData::matchesQuery() const
   if (!isQueryOutOfDate())
     return cachedQueryResult();
 
-  const QVariant sourceValue = source()->value(attributeName());
-  if (sourceValue.isNull() || !sourceValue.isValid())
-    return false;
+  if (m_index)
+    return m_index->matches(source());
 
-  const QVariant targetValue = target()->targetValue();
-  if (targetValue.isNull() || !targetValue.isValid())
+  // compare as the index does, so that the result does not depend on whether it is used
+  const QString sourceKey = AttributeEqualsIndex::indexKey(source()->value(attributeName()));
+  if (sourceKey.isNull())
     return false;
 
-  return sourceValue == targetValue;
+  return sourceKey == AttributeEqualsIndex::indexKey(target()->targetValue());
 }
 
 /*!
@@ -29,6 +29,8 @@ class Graphic;
 
 namespace Dsa {
 
+class AttributeEqualsIndex;
+
 class AttributeEqualsAlertConditionData : public AlertConditionData
 {
   Q_OBJECT
@@ -40,6 +42,7 @@ public:
                                     AlertSource* source,
                                     AlertTarget* target,
                                     const QString& attributeName,
+                                    AttributeEqualsIndex* index = nullptr,
                                     QObject* parent = nullptr);
 
   ~AttributeEqualsAlertConditionData();
@@ -49,7 +52,10 @@ public:
   QString attributeName() const;
 
 private:
+  friend class AttributeEqualsIndex;
+
   QString m_attributeName;
+  AttributeEqualsIndex* m_index = nullptr;
 };
 
 } // Dsa
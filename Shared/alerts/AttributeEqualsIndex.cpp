@@ -0,0 +1,290 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+// PCH header
+#include "pch.hpp"
+
+#include "AttributeEqualsIndex.h"
+
+// example app headers
+#include "AlertSource.h"
+#include "AlertTarget.h"
+#include "AttributeEqualsAlertConditionData.h"
+
+// STL headers
+#include <cmath>
+#include <limits>
+
+namespace Dsa {
+
+/*!
+  \class Dsa::AttributeEqualsIndex
+  \inmodule Dsa
+  \inherits QObject
+  \brief A hash index from attribute value to the \l AlertSource objects with that value.
+
+  The index is shared by all of the \l AttributeEqualsAlertConditionData created by an
+  \l AttributeEqualsAlertCondition for one target. Each source is only re-indexed when
+  its value for the attribute changes, and condition data is only re-tested when
+  the change moves its source into or out of the set of matches. A change of target
+  value re-tests only the sources which matched the old or the new value.
+
+  Values are compared by a normalized key (see \l indexKey). Numbers, and strings which
+  read as numbers, are compared by their numeric value, so \c "1.50" matches \c 1.5.
+  Booleans, and the strings \c "true" and \c "false", are compared as \c 1 and \c 0,
+  so \c "1" matches \c true. Other values are compared by their string representation.
+  Null or invalid values never match.
+ */
+
+/*!
+  \brief Constructor taking the \a attributeName to index, the \a target providing
+  the value to match and an optional \a parent.
+ */
+AttributeEqualsIndex::AttributeEqualsIndex(const QString& attributeName, AlertTarget* target, QObject* parent):
+  QObject(parent),
+  m_attributeName(attributeName),
+  m_target(target)
+{
+  if (!m_target)
+    return;
+
+  m_targetKey = indexKey(m_target->targetValue());
+  connect(m_target, &AlertTarget::dataChanged, this, &AttributeEqualsIndex::handleTargetChanged);
+  connect(m_target, &AlertTarget::destroyed, this, [this]()
+  {
+    m_target = nullptr;
+    m_targetKey.clear();
+  });
+}
+
+/*!
+  \brief Destructor.
+ */
+AttributeEqualsIndex::~AttributeEqualsIndex()
+{
+}
+
+/*!
+  \brief Adds \a source to the index. \a data will be re-tested when the source
+  starts or stops matching the target value.
+ */
+void AttributeEqualsIndex::addSource(AlertSource* source, AttributeEqualsAlertConditionData* data)
+{
+  if (!source || !data)
+    return;
+
+  const QString key = indexKey(source->value(m_attributeName));
+  m_sourceValues.insert(source, key);
+  m_sourceData.insert(source, data);
+  if (!key.isNull())
+    m_sourcesByValue[key].insert(source);
+
+  connect(source, &AlertSource::attributeChanged, this, [this, source](const QString& attributeName)
+  {
+    if (attributeName == m_attributeName)
+      handleAttributeChanged(source);
+  });
+
+  connect(source, &AlertSource::destroyed, this, [this, source]()
+  {
+    removeSource(source);
+  });
+
+  connect(data, &AttributeEqualsAlertConditionData::destroyed, this, [this, source]()
+  {
+    removeSource(source);
+  });
+}
+
+/*!
+  \brief Removes \a source from the index.
+ */
+void AttributeEqualsIndex::removeSource(AlertSource* source)
+{
+  auto findIt = m_sourceValues.find(source);
+  if (findIt == m_sourceValues.end())
+    return;
+
+  const QString key = findIt.value();
+  m_sourceValues.erase(findIt);
+  m_sourceData.remove(source);
+
+  auto bucketIt = m_sourcesByValue.find(key);
+  if (bucketIt != m_sourcesByValue.end())
+  {
+    bucketIt.value().remove(source);
+    if (bucketIt.value().isEmpty())
+      m_sourcesByValue.erase(bucketIt);
+  }
+
+  // the source may already be destroyed, so only disconnect signals sent to this index
+  disconnect(source, nullptr, this, nullptr);
+}
+
+/*!
+  \brief Returns whether the value of \a source matches the target value.
+ */
+bool AttributeEqualsIndex::matches(AlertSource* source) const
+{
+  if (m_targetKey.isNull())
+    return false;
+
+  return m_sourceValues.value(source) == m_targetKey;
+}
+
+/*!
+  \brief Returns the set of sources whose value matches the target value.
+ */
+QSet<AlertSource*> AttributeEqualsIndex::matches() const
+{
+  if (m_targetKey.isNull())
+    return QSet<AlertSource*>();
+
+  return m_sourcesByValue.value(m_targetKey);
+}
+
+/*!
+  \internal
+
+  Moves \a source to the bucket for its new value, re-testing its condition data
+  if it has started or stopped matching.
+ */
+void AttributeEqualsIndex::handleAttributeChanged(AlertSource* source)
+{
+  auto findIt = m_sourceValues.find(source);
+  if (findIt == m_sourceValues.end())
+    return;
+
+  const QString oldKey = findIt.value();
+  const QString newKey = indexKey(source->value(m_attributeName));
+  if (oldKey == newKey)
+    return;
+
+  findIt.value() = newKey;
+
+  auto oldBucketIt = m_sourcesByValue.find(oldKey);
+  if (oldBucketIt != m_sourcesByValue.end())
+  {
+    oldBucketIt.value().remove(source);
+    if (oldBucketIt.value().isEmpty())
+      m_sourcesByValue.erase(oldBucketIt);
+  }
+
+  if (!newKey.isNull())
+    m_sourcesByValue[newKey].insert(source);
+
+  const bool wasMatch = !m_targetKey.isNull() && oldKey == m_targetKey;
+  const bool isMatch = !m_targetKey.isNull() && newKey == m_targetKey;
+  if (wasMatch != isMatch)
+    notify(QSet<AlertSource*>{source});
+}
+
+/*!
+  \internal
+
+  Re-tests the condition data of the sources matching the old or new target value.
+ */
+void AttributeEqualsIndex::handleTargetChanged()
+{
+  const QString newTargetKey = m_target ? indexKey(m_target->targetValue()) : QString();
+  if (newTargetKey == m_targetKey)
+    return;
+
+  QSet<AlertSource*> affected = matches();
+  m_targetKey = newTargetKey;
+  affected += matches();
+
+  notify(affected);
+}
+
+/*!
+  \internal
+ */
+void AttributeEqualsIndex::notify(const QSet<AlertSource*>& sources)
+{
+  for (AlertSource* source : sources)
+  {
+    AttributeEqualsAlertConditionData* data = m_sourceData.value(source);
+    if (data)
+      data->handleDataChanged();
+  }
+}
+
+/*!
+  \brief Returns the normalized key used to compare \a value, or a null string for
+  null or invalid values.
+
+  Two values match when their keys are equal.
+ */
+QString AttributeEqualsIndex::indexKey(const QVariant& value)
+{
+  if (value.isNull() || !value.isValid())
+    return QString();
+
+  double number = 0.0;
+  bool isNumber = false;
+  switch (static_cast<QMetaType::Type>(value.type()))
+  {
+  case QMetaType::Bool:
+    return value.toBool() ? QStringLiteral("1") : QStringLiteral("0");
+  case QMetaType::Int:
+  case QMetaType::LongLong:
+  case QMetaType::Short:
+  case QMetaType::Char:
+  case QMetaType::Long:
+    return QString::number(value.toLongLong());
+  case QMetaType::UInt:
+  case QMetaType::ULongLong:
+  case QMetaType::UShort:
+  case QMetaType::UChar:
+  case QMetaType::ULong:
+    return QString::number(value.toULongLong());
+  case QMetaType::Double:
+  case QMetaType::Float:
+    number = value.toDouble(&isNumber);
+    break;
+  default:
+  {
+    const QString text = value.toString().trimmed();
+    if (text.compare(QStringLiteral("true"), Qt::CaseInsensitive) == 0)
+      return QStringLiteral("1");
+
+    if (text.compare(QStringLiteral("false"), Qt::CaseInsensitive) == 0)
+      return QStringLiteral("0");
+
+    number = text.toDouble(&isNumber);
+    if (!isNumber)
+    {
+      // distinguish an empty (but valid) value from a missing one
+      const QString key = value.toString();
+      return key.isNull() ? QString("") : key;
+    }
+    break;
+  }
+  }
+
+  if (!isNumber || !std::isfinite(number))
+    return value.toString();
+
+  // whole numbers share the key of the equivalent integer
+  if (number == std::floor(number) && std::abs(number) < static_cast<double>(std::numeric_limits<qint64>::max()))
+    return QString::number(static_cast<qint64>(number));
+
+  return QString::number(number, 'g', std::numeric_limits<double>::max_digits10);
+}
+
+} // Dsa
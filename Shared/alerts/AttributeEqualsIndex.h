@@ -0,0 +1,65 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#ifndef ATTRIBUTEEQUALSINDEX_H
+#define ATTRIBUTEEQUALSINDEX_H
+
+// Qt headers
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QVariant>
+
+namespace Dsa {
+
+class AlertSource;
+class AlertTarget;
+class AttributeEqualsAlertConditionData;
+
+class AttributeEqualsIndex : public QObject
+{
+  Q_OBJECT
+
+public:
+  AttributeEqualsIndex(const QString& attributeName, AlertTarget* target, QObject* parent = nullptr);
+  ~AttributeEqualsIndex();
+
+  void addSource(AlertSource* source, AttributeEqualsAlertConditionData* data);
+  void removeSource(AlertSource* source);
+
+  bool matches(AlertSource* source) const;
+  QSet<AlertSource*> matches() const;
+
+  static QString indexKey(const QVariant& value);
+
+private:
+  void handleAttributeChanged(AlertSource* source);
+  void handleTargetChanged();
+  void notify(const QSet<AlertSource*>& sources);
+
+  QString m_attributeName;
+  AlertTarget* m_target = nullptr;
+  QString m_targetKey;
+  QHash<QString, QSet<AlertSource*>> m_sourcesByValue;
+  QHash<AlertSource*, QString> m_sourceValues;
+  QHash<AlertSource*, AttributeEqualsAlertConditionData*> m_sourceData;
+};
+
+} // Dsa
+
+#endif // ATTRIBUTEEQUALSINDEX_H
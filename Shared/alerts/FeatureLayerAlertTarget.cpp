@@ -14,6 +14,7 @@
  *  limitations under the License.
  ******************************************************************************/
 
+
 // PCH header
 #include "pch.hpp"
 
@@ -21,15 +22,46 @@
 
 // example app headers
 #include "FeatureQueryResultManager.h"
-#include "GeometryQuadtree.h"
+#include "PreparedPolygon.h"
 
 // C++ API headers
+#include "ArcGISFeatureTable.h"
+#include "AttributeListModel.h"
+#include "Envelope.h"
+#include "Feature.h"
 #include "FeatureLayer.h"
+#include "FeatureQueryResult.h"
+#include "GeometryEngine.h"
+
+// Qt headers
+#include <QTimer>
+
+// STL headers
+#include <algorithm>
+#include <cmath>
 
 using namespace Esri::ArcGISRuntime;
 
 namespace Dsa {
 
+// the number of features retrieved by each query when building the index
+static const int s_indexPageSize = 5000;
+
+// the number of grid cells along each side of the layer's extent
+static const int s_gridCellsPerSide = 256;
+
+// features spanning more cells than this are tested against every query instead
+static const int s_maxCellsPerFeature = 64;
+
+// the time, in milliseconds, over which updates and deletes are gathered before the index is checked
+static const int s_refreshDelay = 1000;
+
+// the maximum number of object ids in the where clause of each geometry fetch
+static const int s_fetchChunkSize = 500;
+
+// the cache never grows beyond this many geometries by itself
+static const int s_maxCachedGeometriesLimit = 10000;
+
 /*!
   \class Dsa::FeatureLayerAlertTarget
   \inmodule Dsa
@@ -37,28 +69,82 @@ namespace Dsa {
   \brief Represents a target based on an \l Esri::ArcGISRuntime::FeatureLayer
   for an \l AlertCondition.
 
-  Changes to any of the features in the layer will cause the \l AlertTarget::locationChanged
-  signal to be emitted.
+  Rather than holding every feature in memory, the target builds a lightweight index of
+  the object id and WGS84 extent of each feature. The index is built by a series of
+  paged queries, ordered by object id, and the features of each page are released as
+  soon as their extents have been read.
+
+  The full geometry of a feature is only fetched when it is a candidate for a query
+  (its extent intersects the query area). Fetched geometries are held in a least
+  recently used cache of \l maxCachedGeometries entries. While a geometry is being
+  fetched it is not returned by \l targetGeometries; once it arrives the
+  \l AlertTarget::areaChanged signal is emitted so that affected conditions are re-tested.
+
+  If a geometry has to be fetched again soon after being evicted, the conditions need
+  more geometries than the cache holds, so the cache grows to hold them (up to a limit
+  of 10000). Otherwise the re-test triggered by each fetch would evict and fetch again
+  without end. Only refetches within a window of recent fetches (twice the size of the
+  cache) count, so that features visited again much later do not grow the cache.
+
+  When features are added to the layer's table, only the features with object ids above
+  those already indexed are read and applied with \l updateFeature. The table does not
+  report which features were updated or deleted, so after these edits the index is
+  read again, once for all of the edits made within a second, and only the features
+  which moved or were removed are applied with \l updateFeature and \l removeFeature.
+  In each case \l AlertTarget::areaChanged is emitted just for the edited features.
+
+  Code which knows the features it edits can instead apply them directly with
+  \l updateFeature and \l removeFeature.
   */
 
 /*!
   \brief Constructor taking an \l Esri::ArcGISRuntime::FeatureLayer (\a featureLayer).
 
-  All features will be retrieved from the underlying feature layer.
+  The index of all features in the underlying feature layer will be built.
  */
 FeatureLayerAlertTarget::FeatureLayerAlertTarget(FeatureLayer* featureLayer):
   AlertTarget(featureLayer),
-  m_FeatureLayer(featureLayer)
+  m_FeatureLayer(featureLayer),
+  m_geometryCache(1000),
+  m_polygonCache(1000)
 {
-  // assume no editing of feature table
-
   FeatureTable* table = m_FeatureLayer->featureTable();
-  QueryParameters allFeaturesQuery;
-  allFeaturesQuery.setWhereClause("1=1");
-  allFeaturesQuery.setReturnGeometry(true);
+  if (!table)
+    return;
+
+  ArcGISFeatureTable* agsFeatureTable = qobject_cast<ArcGISFeatureTable*>(table);
+  if (agsFeatureTable)
+  {
+    m_objectIdField = agsFeatureTable->objectIdField();
+  }
+  else
+  {
+    const QList<Field> fields = table->fields();
+    for (const Field& field : fields)
+    {
+      if (field.fieldType() == FieldType::OID)
+      {
+        m_objectIdField = field.name();
+        break;
+      }
+    }
+  }
+
+  // size the grid cells from the extent of the layer
+  const Envelope fullExtent = m_FeatureLayer->fullExtent();
+  if (!fullExtent.isEmpty())
+  {
+    const Envelope extentWgs84 = GeometryEngine::project(fullExtent, SpatialReference::wgs84());
+    const double largestSide = std::max(extentWgs84.width(), extentWgs84.height());
+    if (largestSide > 0.0)
+      m_cellSize = largestSide / s_gridCellsPerSide;
+  }
 
   connect(table, &FeatureTable::queryFeaturesCompleted, this, &FeatureLayerAlertTarget::handleQueryFeaturesCompleted);
-  table->queryFeatures(allFeaturesQuery);
+  connect(table, &FeatureTable::addFeatureCompleted, this, &FeatureLayerAlertTarget::handleAddCompleted);
+  connect(table, &FeatureTable::updateFeatureCompleted, this, &FeatureLayerAlertTarget::handleEditCompleted);
+  connect(table, &FeatureTable::deleteFeatureCompleted, this, &FeatureLayerAlertTarget::handleEditCompleted);
+  queryNextIndexPage();
 }
 
 /*!
@@ -72,31 +158,69 @@ FeatureLayerAlertTarget::~FeatureLayerAlertTarget()
 /*!
   \brief Returns the list of \l Esri::ArcGISRuntime::Geometry which are in the \a targetArea.
 
+  Geometries which are not yet cached are requested and will be returned by later calls.
+
   \note No exact intersection tests are carried out to create this list.
  */
 QList<Geometry> FeatureLayerAlertTarget::targetGeometries(const Envelope& targetArea) const
 {
-  // if the quad-tree has been built use it to determine the candidate geometry
-  if (m_quadtree)
-    return m_quadtree->candidateIntersections(targetArea);
+  QList<Geometry> results;
+  QList<qint64> missingIds;
+  const QList<qint64> ids = candidateIds(targetArea);
+  for (const qint64 id : ids)
+  {
+    const Geometry* geometry = m_geometryCache.object(id);
+    if (geometry)
+      results.append(*geometry);
+    else if (!m_pendingIds.contains(id))
+      missingIds.append(id);
+  }
 
-  // if there is no quad-tree just return the cache of geoemtry
-  if (!m_geomCache.isEmpty())
-    return m_geomCache;
+  fetchGeometries(missingIds);
+
+  return results;
+}
 
-  // if there is no cached geometry, get the geometry for all features
-  auto it = m_features.begin();
-  auto itEnd = m_features.end();
-  for (; it != itEnd; ++it)
+/*!
+  \brief Returns the prepared polygons of the features in the \a targetArea.
+
+  Polygons are prepared from the cached geometries and re-used until the feature is
+  edited or evicted from the cache.
+ */
+QList<std::shared_ptr<const PreparedPolygon>> FeatureLayerAlertTarget::targetPolygons(const Envelope& targetArea) const
+{
+  QList<std::shared_ptr<const PreparedPolygon>> results;
+  QList<qint64> missingIds;
+  const QList<qint64> ids = candidateIds(targetArea);
+  for (const qint64 id : ids)
   {
-    Feature* feat = *it;
-    if (!feat)
+    const std::shared_ptr<const PreparedPolygon>* prepared = m_polygonCache.object(id);
+    if (prepared)
+    {
+      results.append(*prepared);
+      continue;
+    }
+
+    const Geometry* geometry = m_geometryCache.object(id);
+    if (!geometry)
+    {
+      if (!m_pendingIds.contains(id))
+        missingIds.append(id);
+
       continue;
+    }
 
-    m_geomCache.append(feat->geometry());
+    if (geometry->geometryType() != GeometryType::Polygon)
+      continue;
+
+    auto newPrepared = std::make_shared<const PreparedPolygon>(*geometry);
+    m_polygonCache.insert(id, new std::shared_ptr<const PreparedPolygon>(newPrepared));
+    results.append(newPrepared);
   }
 
-  return m_geomCache;
+  fetchGeometries(missingIds);
+
+  return results;
 }
 
 /*!
@@ -107,64 +231,620 @@ QVariant FeatureLayerAlertTarget::targetValue() const
   return QVariant();
 }
 
+/*!
+  \brief Updates the index for the edited \a feature.
+
+  The feature is added to the index if it is new, and its cached geometry is replaced.
+ */
+void FeatureLayerAlertTarget::updateFeature(Feature* feature)
+{
+  if (!feature)
+    return;
+
+  const qint64 id = objectId(feature);
+  if (id < 0)
+    return;
+
+  FeatureExtent oldExtent;
+  const bool wasIndexed = removeFromIndex(id, oldExtent);
+
+  FeatureExtent newExtent;
+  const bool hasExtent = extentFor(feature->geometry(), newExtent);
+  if (hasExtent)
+  {
+    insertIntoIndex(id, newExtent);
+    m_geometryCache.insert(id, new Geometry(feature->geometry()));
+    m_polygonCache.remove(id);
+  }
+
+  // report the area covering both the old and the new extent
+  if (wasIndexed && hasExtent)
+  {
+    newExtent.xMin = std::min(newExtent.xMin, oldExtent.xMin);
+    newExtent.yMin = std::min(newExtent.yMin, oldExtent.yMin);
+    newExtent.xMax = std::max(newExtent.xMax, oldExtent.xMax);
+    newExtent.yMax = std::max(newExtent.yMax, oldExtent.yMax);
+    emit areaChanged(toEnvelope(newExtent));
+  }
+  else if (hasExtent)
+  {
+    emit areaChanged(toEnvelope(newExtent));
+  }
+  else if (wasIndexed)
+  {
+    emit areaChanged(toEnvelope(oldExtent));
+  }
+}
+
+/*!
+  \brief Removes the feature with \a objectId from the index.
+ */
+void FeatureLayerAlertTarget::removeFeature(qint64 objectId)
+{
+  FeatureExtent oldExtent;
+  if (removeFromIndex(objectId, oldExtent))
+    emit areaChanged(toEnvelope(oldExtent));
+}
+
+/*!
+  \brief Returns the number of features in the index.
+ */
+int FeatureLayerAlertTarget::indexedFeatureCount() const
+{
+  return m_extents.size();
+}
+
+/*!
+  \brief Returns the maximum number of full feature geometries held in memory.
+
+  The default is \c 1000. The cache grows beyond this, up to \c 10000, if the
+  alert conditions need more geometries at once.
+ */
+int FeatureLayerAlertTarget::maxCachedGeometries() const
+{
+  return m_geometryCache.maxCost();
+}
+
+/*!
+  \brief Sets the maximum number of full feature geometries held in memory to \a maxCachedGeometries.
+ */
+void FeatureLayerAlertTarget::setMaxCachedGeometries(int maxCachedGeometries)
+{
+  m_geometryCache.setMaxCost(maxCachedGeometries);
+  m_polygonCache.setMaxCost(maxCachedGeometries);
+}
+
 /*!
   \brief internal.
 
-  Handle the query to obtain all of the features in the layer.
+  Handle the queries to build the index and to fetch candidate geometries.
  */
-void FeatureLayerAlertTarget::handleQueryFeaturesCompleted(QUuid, FeatureQueryResult* queryResults)
+void FeatureLayerAlertTarget::handleQueryFeaturesCompleted(QUuid taskId, FeatureQueryResult* queryResults)
 {
   // Store the results in a RAII manager to ensure they are cleaned up
   FeatureQueryResultManager results(queryResults);
-  if (!results.m_results)
+
+  if (taskId == m_indexTaskId)
   {
-    emit dataChanged();
+    m_indexTaskId = QUuid();
+    handleIndexPage(results.m_results);
     return;
   }
 
-  // cache all of the features
-  m_geomCache.clear();
-  m_features = results.m_results->iterator().features(this);
-  auto it = m_features.begin();
-  auto itEnd = m_features.end();
-  for (; it != itEnd; ++it)
+  auto findIt = m_fetchTasks.find(taskId);
+  if (findIt == m_fetchTasks.end())
+    return;
+
+  const QList<qint64> requestedIds = findIt.value();
+  m_fetchTasks.erase(findIt);
+  handleFetchedFeatures(requestedIds, results.m_results);
+}
+
+/*!
+  \brief internal.
+
+  Handle the completion of a feature being added to the layer's table.
+ */
+void FeatureLayerAlertTarget::handleAddCompleted(QUuid, bool success)
+{
+  if (success)
+    appendNewFeatures();
+}
+
+/*!
+  \brief internal.
+
+  Handle the completion of an update to, or delete from, the layer's table.
+ */
+void FeatureLayerAlertTarget::handleEditCompleted(QUuid, bool success)
+{
+  if (success)
+    scheduleRefresh();
+}
+
+/*!
+  \internal
+
+  Reads the features with object ids above those already indexed and applies them
+  to the index. If the index is still being read, this starts once it has finished.
+ */
+void FeatureLayerAlertTarget::appendNewFeatures()
+{
+  if (!m_indexTaskId.isNull())
+  {
+    m_appendRequested = true;
+    return;
+  }
+
+  m_appendRequested = false;
+  m_indexMode = IndexMode::Appending;
+  queryNextIndexPage();
+}
+
+/*!
+  \internal
+
+  Refreshes the index once, after the edits made within the refresh delay.
+ */
+void FeatureLayerAlertTarget::scheduleRefresh()
+{
+  if (m_refreshScheduled)
+    return;
+
+  m_refreshScheduled = true;
+  QTimer::singleShot(s_refreshDelay, this, [this]()
+  {
+    m_refreshScheduled = false;
+    refreshIndex();
+  });
+}
+
+/*!
+  \internal
+
+  Reads the index again from the first page, so that edited features can be applied to it.
+  If the index is still being read, the refresh starts once it has finished.
+ */
+void FeatureLayerAlertTarget::refreshIndex()
+{
+  if (!m_indexTaskId.isNull())
+  {
+    m_refreshRequested = true;
+    return;
+  }
+
+  // the refresh also reads any new features
+  m_refreshRequested = false;
+  m_appendRequested = false;
+  m_indexMode = IndexMode::Refreshing;
+  m_refreshedIds.clear();
+  m_lastIndexedId = -1;
+  queryNextIndexPage();
+}
+
+/*!
+  \internal
+
+  Starts any refresh or read of new features which was requested while the index was being read.
+ */
+void FeatureLayerAlertTarget::startRequestedIndexWork()
+{
+  if (m_refreshRequested)
+    refreshIndex();
+  else if (m_appendRequested)
+    appendNewFeatures();
+}
+
+/*!
+  \internal
+
+  Queries the next page of features, ordered by object id, for the index.
+ */
+void FeatureLayerAlertTarget::queryNextIndexPage()
+{
+  FeatureTable* table = m_FeatureLayer->featureTable();
+  if (!table || m_objectIdField.isEmpty())
+    return;
+
+  QueryParameters pageQuery;
+  pageQuery.setWhereClause(QString("\"%1\" > %2").arg(m_objectIdField, QString::number(m_lastIndexedId)));
+  pageQuery.setOrderByFields(QList<OrderBy>{OrderBy(m_objectIdField, SortOrder::Ascending)});
+  pageQuery.setMaxFeatures(s_indexPageSize);
+  pageQuery.setReturnGeometry(true);
+
+  m_indexTaskId = table->queryFeatures(pageQuery).taskId();
+}
+
+/*!
+  \internal
+
+  Adds the extents of a page of features to the index and requests the next page.
+ */
+void FeatureLayerAlertTarget::handleIndexPage(FeatureQueryResult* featureQueryResult)
+{
+  // only the initial build of the index affects the whole target
+  const bool building = m_indexMode == IndexMode::Building;
+
+  if (!featureQueryResult)
+  {
+    // a failed refresh leaves the index as it was
+    m_refreshedIds.clear();
+    startRequestedIndexWork();
+
+    if (building)
+      emit dataChanged();
+
+    return;
+  }
+
+  // the features are only needed while their extents are read
+  QObject localParent;
+  const QList<Feature*> features = featureQueryResult->iterator().features(&localParent);
+  for (Feature* feature : features)
   {
-    Feature* feature = *it;
     if (!feature)
       continue;
 
-    // for each feature, connect to the geometryChanged signal
-    connect(feature, &Feature::geometryChanged, this, [this]()
+    const qint64 id = objectId(feature);
+    if (id < 0)
+      continue;
+
+    m_lastIndexedId = std::max(m_lastIndexedId, id);
+
+    if (m_indexMode == IndexMode::Appending)
     {
-      m_geomCache.clear();
-      rebuildQuadtree();
+      // new features report their own area
+      updateFeature(feature);
+      continue;
+    }
+
+    FeatureExtent extent;
+    const bool hasExtent = extentFor(feature->geometry(), extent);
+    if (building)
+    {
+      if (hasExtent)
+        insertIntoIndex(id, extent);
+
+      continue;
+    }
+
+    // when refreshing, only apply the features which were added or moved
+    m_refreshedIds.insert(id);
+    auto findIt = m_extents.constFind(id);
+    const bool unchanged = findIt != m_extents.constEnd() && hasExtent &&
+        findIt.value().xMin == extent.xMin && findIt.value().yMin == extent.yMin &&
+        findIt.value().xMax == extent.xMax && findIt.value().yMax == extent.yMax;
+    if (!unchanged)
+      updateFeature(feature);
+  }
+
+  // a full page means there may be more features to index
+  if (features.size() >= s_indexPageSize)
+  {
+    queryNextIndexPage();
+    if (building)
       emit dataChanged();
-    });
+
+    return;
+  }
+
+  if (m_indexMode == IndexMode::Refreshing)
+  {
+    // features which were not read again have been deleted
+    const QList<qint64> indexedIds = m_extents.keys();
+    for (const qint64 id : indexedIds)
+    {
+      if (!m_refreshedIds.contains(id))
+        removeFeature(id);
+    }
+
+    m_refreshedIds.clear();
   }
 
-  rebuildQuadtree();
-  emit dataChanged();
+  startRequestedIndexWork();
+
+  if (building)
+    emit dataChanged();
 }
 
 /*!
-  \brief internal.
+  \internal
+
+  Caches the geometries of features fetched for \a requestedIds and reports the area they cover.
+ */
+void FeatureLayerAlertTarget::handleFetchedFeatures(const QList<qint64>& requestedIds, FeatureQueryResult* featureQueryResult)
+{
+  for (const qint64 id : requestedIds)
+    m_pendingIds.remove(id);
+
+  if (!featureQueryResult)
+    return;
+
+  QObject localParent;
+  const QList<Feature*> features = featureQueryResult->iterator().features(&localParent);
+
+  bool hasArea = false;
+  FeatureExtent changedArea;
+  for (Feature* feature : features)
+  {
+    if (!feature)
+      continue;
+
+    const qint64 id = objectId(feature);
+    auto findIt = m_extents.constFind(id);
+    if (findIt == m_extents.constEnd())
+      continue;
+
+    m_geometryCache.insert(id, new Geometry(feature->geometry()));
+
+    const FeatureExtent& extent = findIt.value();
+    if (!hasArea)
+    {
+      changedArea = extent;
+      hasArea = true;
+      continue;
+    }
+
+    changedArea.xMin = std::min(changedArea.xMin, extent.xMin);
+    changedArea.yMin = std::min(changedArea.yMin, extent.yMin);
+    changedArea.xMax = std::max(changedArea.xMax, extent.xMax);
+    changedArea.yMax = std::max(changedArea.yMax, extent.yMax);
+  }
+
+  // conditions near the fetched features can now be tested against them
+  if (hasArea)
+    emit areaChanged(toEnvelope(changedArea));
+}
+
+/*!
+  \internal
+
+  Returns the ids of the features whose extent intersects \a targetArea.
+ */
+QList<qint64> FeatureLayerAlertTarget::candidateIds(const Envelope& targetArea) const
+{
+  QList<qint64> results;
+  if (m_extents.isEmpty() || targetArea.isEmpty())
+    return results;
+
+  const Envelope areaWgs84 = GeometryEngine::project(targetArea, SpatialReference::wgs84());
+  FeatureExtent area;
+  area.xMin = areaWgs84.xMin();
+  area.yMin = areaWgs84.yMin();
+  area.xMax = areaWgs84.xMax();
+  area.yMax = areaWgs84.yMax();
+
+  // broad phase: collect the ids of features in the grid cells (and large features) covering the area
+  QSet<qint64> ids = m_largeFeatures;
+  const QVector<quint64> keys = cellKeys(area);
+  if (keys.size() > s_maxCellsPerFeature)
+  {
+    // for a large area, testing every extent is cheaper than visiting every cell
+    for (auto it = m_extents.cbegin(); it != m_extents.cend(); ++it)
+      ids.insert(it.key());
+  }
+  else
+  {
+    for (const quint64 key : keys)
+    {
+      auto findIt = m_grid.constFind(key);
+      if (findIt == m_grid.constEnd())
+        continue;
+
+      for (const qint64 id : findIt.value())
+        ids.insert(id);
+    }
+  }
+
+  // test the extent of each feature against the area
+  for (const qint64 id : ids)
+  {
+    const FeatureExtent extent = m_extents.value(id);
+    if (extent.xMin > area.xMax || extent.xMax < area.xMin ||
+        extent.yMin > area.yMax || extent.yMax < area.yMin)
+      continue;
+
+    results.append(id);
+  }
+
+  return results;
+}
+
+/*!
+  \internal
 
-  Build the quadtree used to find intersections with feature geometry etc.
+  Requests the full geometries of the features with \a objectIds.
  */
-void FeatureLayerAlertTarget::rebuildQuadtree()
+void FeatureLayerAlertTarget::fetchGeometries(const QList<qint64>& objectIds) const
 {
-  if (m_quadtree)
+  if (objectIds.isEmpty())
+    return;
+
+  FeatureTable* table = m_FeatureLayer->featureTable();
+  if (!table)
+    return;
+
+  // start a new window once the ids fetched in this one have had time to be evicted
+  // in the normal course of use, forgetting them
+  if (m_fetchWindowCount > 2 * m_geometryCache.maxCost())
+  {
+    m_fetchedIds.clear();
+    m_fetchWindowCount = 0;
+  }
+
+  // geometries fetched earlier in the window have been evicted, so the cache is too
+  // small for the conditions
+  int refetchedCount = 0;
+  for (const qint64 id : objectIds)
+  {
+    if (m_fetchedIds.contains(id))
+      ++refetchedCount;
+    else
+      m_fetchedIds.insert(id);
+  }
+  m_fetchWindowCount += objectIds.size();
+
+  const int maxCostLimit = std::min(m_extents.size(), s_maxCachedGeometriesLimit);
+  if (refetchedCount > 0 && m_geometryCache.maxCost() < maxCostLimit)
+  {
+    const int maxCost = std::min(m_geometryCache.maxCost() + refetchedCount, maxCostLimit);
+    m_geometryCache.setMaxCost(maxCost);
+    m_polygonCache.setMaxCost(maxCost);
+  }
+
+  // keep the where clause of each query bounded
+  for (int start = 0; start < objectIds.size(); start += s_fetchChunkSize)
+  {
+    const QList<qint64> chunkIds = objectIds.mid(start, s_fetchChunkSize);
+
+    QStringList idStrings;
+    idStrings.reserve(chunkIds.size());
+    for (const qint64 id : chunkIds)
+    {
+      idStrings.append(QString::number(id));
+      m_pendingIds.insert(id);
+    }
+
+    QueryParameters fetchQuery;
+    fetchQuery.setWhereClause(QString("\"%1\" IN (%2)").arg(m_objectIdField, idStrings.join(",")));
+    fetchQuery.setReturnGeometry(true);
+
+    const QUuid taskId = table->queryFeatures(fetchQuery).taskId();
+    if (taskId.isNull())
+    {
+      for (const qint64 id : chunkIds)
+        m_pendingIds.remove(id);
+
+      continue;
+    }
+
+    m_fetchTasks.insert(taskId, chunkIds);
+  }
+}
+
+/*!
+  \internal
+
+  Returns the object id of \a feature, or \c -1 if it has none.
+ */
+qint64 FeatureLayerAlertTarget::objectId(Feature* feature) const
+{
+  if (!feature || !feature->attributes())
+    return -1;
+
+  bool ok = false;
+  const qint64 id = feature->attributes()->attributeValue(m_objectIdField).toLongLong(&ok);
+  return ok ? id : -1;
+}
+
+/*!
+  \internal
+
+  Writes the WGS84 extent of \a geometry to \a extent. Returns \c false if the geometry is empty.
+ */
+bool FeatureLayerAlertTarget::extentFor(const Geometry& geometry, FeatureExtent& extent) const
+{
+  if (geometry.isEmpty())
+    return false;
+
+  const Envelope extentWgs84 = GeometryEngine::project(geometry, SpatialReference::wgs84()).extent();
+  if (extentWgs84.isEmpty())
+    return false;
+
+  extent.xMin = extentWgs84.xMin();
+  extent.yMin = extentWgs84.yMin();
+  extent.xMax = extentWgs84.xMax();
+  extent.yMax = extentWgs84.yMax();
+  return true;
+}
+
+/*!
+  \internal
+ */
+void FeatureLayerAlertTarget::insertIntoIndex(qint64 objectId, const FeatureExtent& extent)
+{
+  m_extents.insert(objectId, extent);
+
+  const QVector<quint64> keys = cellKeys(extent);
+  if (keys.size() > s_maxCellsPerFeature)
   {
-    delete m_quadtree;
-    m_quadtree = nullptr;
+    m_largeFeatures.insert(objectId);
+    return;
   }
 
-  QList<GeoElement*> elements;
-  for (auto it = m_features.begin(); it != m_features.end(); ++it)
-    elements.append(*it);
+  for (const quint64 key : keys)
+    m_grid[key].append(objectId);
+}
+
+/*!
+  \internal
+
+  Removes \a objectId from the index, writing its previous extent to \a oldExtent.
+  Returns \c false if the feature was not indexed.
+ */
+bool FeatureLayerAlertTarget::removeFromIndex(qint64 objectId, FeatureExtent& oldExtent)
+{
+  auto findIt = m_extents.find(objectId);
+  if (findIt == m_extents.end())
+    return false;
+
+  oldExtent = findIt.value();
+  m_extents.erase(findIt);
+  m_geometryCache.remove(objectId);
+  m_polygonCache.remove(objectId);
+  m_fetchedIds.remove(objectId);
+
+  if (!m_largeFeatures.remove(objectId))
+  {
+    const QVector<quint64> keys = cellKeys(oldExtent);
+    for (const quint64 key : keys)
+    {
+      auto cellIt = m_grid.find(key);
+      if (cellIt == m_grid.end())
+        continue;
 
-  if (elements.size() > 1)
-    m_quadtree = new GeometryQuadtree(m_FeatureLayer->fullExtent(), elements, 8, this);
+      cellIt.value().removeAll(objectId);
+      if (cellIt.value().isEmpty())
+        m_grid.erase(cellIt);
+    }
+  }
+
+  return true;
+}
+
+/*!
+  \internal
+
+  Returns the keys of the grid cells covered by \a extent. If there are more than
+  the maximum number of cells per feature, the list is truncated after that number.
+ */
+QVector<quint64> FeatureLayerAlertTarget::cellKeys(const FeatureExtent& extent) const
+{
+  const qint64 columnMin = static_cast<qint64>(std::floor(extent.xMin / m_cellSize));
+  const qint64 columnMax = static_cast<qint64>(std::floor(extent.xMax / m_cellSize));
+  const qint64 rowMin = static_cast<qint64>(std::floor(extent.yMin / m_cellSize));
+  const qint64 rowMax = static_cast<qint64>(std::floor(extent.yMax / m_cellSize));
+
+  QVector<quint64> keys;
+  for (qint64 column = columnMin; column <= columnMax; ++column)
+  {
+    for (qint64 row = rowMin; row <= rowMax; ++row)
+    {
+      keys.append((static_cast<quint64>(static_cast<quint32>(column)) << 32) | static_cast<quint32>(row));
+      if (keys.size() > s_maxCellsPerFeature)
+        return keys;
+    }
+  }
+
+  return keys;
+}
+
+/*!
+  \internal
+ */
+Envelope FeatureLayerAlertTarget::toEnvelope(const FeatureExtent& extent) const
+{
+  return Envelope(extent.xMin, extent.yMin, extent.xMax, extent.yMax, SpatialReference::wgs84());
 }
 
 } // Dsa
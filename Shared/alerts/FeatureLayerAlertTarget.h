@@ -14,14 +14,22 @@
  *  limitations under the License.
  ******************************************************************************/
 
+
 #ifndef FEATURELAYERALERTTARGET_H
 #define FEATURELAYERALERTTARGET_H
 
 // example app headers
 #include "AlertTarget.h"
 
+// C++ API headers
+#include "Geometry.h"
+
 // Qt headers
+#include <QCache>
+#include <QHash>
+#include <QSet>
 #include <QUuid>
+#include <QVector>
 
 namespace Esri {
 namespace ArcGISRuntime {
@@ -33,8 +41,6 @@ class FeatureQueryResult;
 
 namespace Dsa {
 
-class GeometryQuadtree;
-
 class FeatureLayerAlertTarget : public AlertTarget
 {
   Q_OBJECT
@@ -45,17 +51,73 @@ public:
 
   QList<Esri::ArcGISRuntime::Geometry> targetGeometries(const Esri::ArcGISRuntime::Envelope& targetArea) const override;
   QVariant targetValue() const override;
+  QList<std::shared_ptr<const PreparedPolygon>> targetPolygons(const Esri::ArcGISRuntime::Envelope& targetArea) const override;
+
+  void updateFeature(Esri::ArcGISRuntime::Feature* feature);
+  void removeFeature(qint64 objectId);
+
+  int indexedFeatureCount() const;
+
+  int maxCachedGeometries() const;
+  void setMaxCachedGeometries(int maxCachedGeometries);
 
 private slots:
   void handleQueryFeaturesCompleted(QUuid taskId, Esri::ArcGISRuntime::FeatureQueryResult* featureQueryResult);
+  void handleAddCompleted(QUuid taskId, bool success);
+  void handleEditCompleted(QUuid taskId, bool success);
 
 private:
-  void rebuildQuadtree();
+  enum class IndexMode
+  {
+    Building,
+    Appending,
+    Refreshing
+  };
+
+  struct FeatureExtent
+  {
+    double xMin = 0.0;
+    double yMin = 0.0;
+    double xMax = 0.0;
+    double yMax = 0.0;
+  };
+
+  void queryNextIndexPage();
+  void appendNewFeatures();
+  void scheduleRefresh();
+  void refreshIndex();
+  void startRequestedIndexWork();
+  void handleIndexPage(Esri::ArcGISRuntime::FeatureQueryResult* featureQueryResult);
+  void handleFetchedFeatures(const QList<qint64>& requestedIds, Esri::ArcGISRuntime::FeatureQueryResult* featureQueryResult);
+  void fetchGeometries(const QList<qint64>& objectIds) const;
+  QList<qint64> candidateIds(const Esri::ArcGISRuntime::Envelope& targetArea) const;
+
+  qint64 objectId(Esri::ArcGISRuntime::Feature* feature) const;
+  bool extentFor(const Esri::ArcGISRuntime::Geometry& geometry, FeatureExtent& extent) const;
+  void insertIntoIndex(qint64 objectId, const FeatureExtent& extent);
+  bool removeFromIndex(qint64 objectId, FeatureExtent& oldExtent);
+  QVector<quint64> cellKeys(const FeatureExtent& extent) const;
+  Esri::ArcGISRuntime::Envelope toEnvelope(const FeatureExtent& extent) const;
 
   Esri::ArcGISRuntime::FeatureLayer* m_FeatureLayer = nullptr;
-  GeometryQuadtree* m_quadtree = nullptr;
-  QList<Esri::ArcGISRuntime::Feature*> m_features;
-  mutable QList<Esri::ArcGISRuntime::Geometry> m_geomCache;
+  QString m_objectIdField;
+  QUuid m_indexTaskId;
+  qint64 m_lastIndexedId = -1;
+  IndexMode m_indexMode = IndexMode::Building;
+  bool m_appendRequested = false;
+  bool m_refreshScheduled = false;
+  bool m_refreshRequested = false;
+  QSet<qint64> m_refreshedIds;
+  double m_cellSize = 0.01;
+  QHash<qint64, FeatureExtent> m_extents;
+  QHash<quint64, QVector<qint64>> m_grid;
+  QSet<qint64> m_largeFeatures;
+  mutable QCache<qint64, Esri::ArcGISRuntime::Geometry> m_geometryCache;
+  mutable QCache<qint64, std::shared_ptr<const PreparedPolygon>> m_polygonCache;
+  mutable QSet<qint64> m_pendingIds;
+  mutable QSet<qint64> m_fetchedIds;
+  mutable int m_fetchWindowCount = 0;
+  mutable QHash<QUuid, QList<qint64>> m_fetchTasks;
 };
 
 } // Dsa
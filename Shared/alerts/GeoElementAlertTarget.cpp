@@ -21,6 +21,7 @@
 #include "GeoElementAlertTarget.h"
 
 #include "GeoElementUtils.h"
+#include "PreparedPolygon.h"
 
 // C++ API headers
 #include "GeoElement.h"
@@ -49,7 +50,11 @@ GeoElementAlertTarget::GeoElementAlertTarget(GeoElement* geoElement):
   AlertTarget(GeoElementUtils::toQObject(geoElement)),
   m_geoElementSignaler(new GeoElementSignaler(geoElement, this))
 {
-  connect(m_geoElementSignaler, &GeoElementSignaler::geometryChanged, this, &GeoElementAlertTarget::dataChanged);
+  connect(m_geoElementSignaler, &GeoElementSignaler::geometryChanged, this, [this]()
+  {
+    m_preparedPolygon.reset();
+    emit dataChanged();
+  });
 }
 
 /*!
@@ -69,6 +74,24 @@ QList<Geometry> GeoElementAlertTarget::targetGeometries(const Envelope&) const
   return QList<Geometry>{m_geoElementSignaler->geoElement()->geometry()};
 }
 
+/*!
+  \brief Returns the prepared polygon of the underlying \l Esri::ArcGISRuntime::GeoElement,
+  if its geometry is a polygon.
+
+  The polygon is prepared once and re-used until the geometry of the element changes.
+ */
+QList<std::shared_ptr<const PreparedPolygon>> GeoElementAlertTarget::targetPolygons(const Envelope&) const
+{
+  const Geometry geometry = m_geoElementSignaler->geoElement()->geometry();
+  if (geometry.geometryType() != GeometryType::Polygon)
+    return QList<std::shared_ptr<const PreparedPolygon>>();
+
+  if (!m_preparedPolygon)
+    m_preparedPolygon = std::make_shared<const PreparedPolygon>(geometry);
+
+  return QList<std::shared_ptr<const PreparedPolygon>>{m_preparedPolygon};
+}
+
 /*!
   \brief Returns an empty QVariant.
  */
@@ -39,9 +39,11 @@ public:
 
   QList<Esri::ArcGISRuntime::Geometry> targetGeometries(const Esri::ArcGISRuntime::Envelope& targetArea) const override;
   QVariant targetValue() const override;
+  QList<std::shared_ptr<const PreparedPolygon>> targetPolygons(const Esri::ArcGISRuntime::Envelope& targetArea) const override;
 
 private:
   GeoElementSignaler* m_geoElementSignaler = nullptr;
+  mutable std::shared_ptr<const PreparedPolygon> m_preparedPolygon;
 };
 
 } // Dsa
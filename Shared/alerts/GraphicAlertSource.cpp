@@ -36,7 +36,10 @@ namespace Dsa {
   for an \l AlertCondition.
 
   Changes to the underlying graphic's position will cause the \l AlertSource::locationChanged
-  signal to be emitted.
+  signal to be emitted. Changes to the graphic's attributes are compared against the
+  previous values, so that \l AlertSource::attributeChanged is only emitted for the
+  attributes which actually changed. Updates which change neither the position nor any
+  attribute value are ignored.
  */
 
 /*!
@@ -46,9 +49,13 @@ GraphicAlertSource::GraphicAlertSource(Graphic* graphic):
   AlertSource(graphic),
   m_graphic(graphic)
 {
-  connect(m_graphic, &Graphic::geometryChanged, this, &GraphicAlertSource::dataChanged);
-  connect(m_graphic->attributes(), &AttributeListModel::modelReset, this, &GraphicAlertSource::dataChanged);
-  connect(m_graphic->attributes(), &AttributeListModel::dataChanged, this, &GraphicAlertSource::dataChanged);
+  m_location = location();
+  if (m_graphic->attributes())
+    m_attributes = m_graphic->attributes()->attributesMap();
+
+  connect(m_graphic, &Graphic::geometryChanged, this, &GraphicAlertSource::onGeometryChanged);
+  connect(m_graphic->attributes(), &AttributeListModel::modelReset, this, &GraphicAlertSource::onAttributesChanged);
+  connect(m_graphic->attributes(), &AttributeListModel::dataChanged, this, &GraphicAlertSource::onAttributesChanged);
 }
 
 /*!
@@ -90,4 +97,58 @@ void GraphicAlertSource::setSelected(bool selected)
   m_graphic->setSelected(selected);
 }
 
+/*!
+  \internal
+
+  Emits \l AlertSource::locationChanged if the location of the graphic has moved.
+ */
+void GraphicAlertSource::onGeometryChanged()
+{
+  const Point newLocation = location();
+  if (newLocation == m_location)
+    return;
+
+  m_location = newLocation;
+  emit locationChanged();
+  emit dataChanged();
+}
+
+/*!
+  \internal
+
+  Emits \l AlertSource::attributeChanged for each attribute of the graphic
+  whose value differs from the previous update.
+ */
+void GraphicAlertSource::onAttributesChanged()
+{
+  if (!m_graphic->attributes())
+    return;
+
+  const QVariantMap newAttributes = m_graphic->attributes()->attributesMap();
+
+  QStringList changedAttributes;
+  for (auto it = newAttributes.cbegin(); it != newAttributes.cend(); ++it)
+  {
+    auto oldIt = m_attributes.constFind(it.key());
+    if (oldIt == m_attributes.cend() || oldIt.value() != it.value())
+      changedAttributes.append(it.key());
+  }
+
+  for (auto it = m_attributes.cbegin(); it != m_attributes.cend(); ++it)
+  {
+    if (!newAttributes.contains(it.key()))
+      changedAttributes.append(it.key());
+  }
+
+  m_attributes = newAttributes;
+
+  if (changedAttributes.isEmpty())
+    return;
+
+  for (const QString& attributeName : changedAttributes)
+    emit attributeChanged(attributeName);
+
+  emit dataChanged();
+}
+
 } // Dsa
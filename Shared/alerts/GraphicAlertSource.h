@@ -42,7 +42,12 @@ public:
   void setSelected(bool selected) override;
 
 private:
+  void onGeometryChanged();
+  void onAttributesChanged();
+
   Esri::ArcGISRuntime::Graphic* m_graphic = nullptr;
+  Esri::ArcGISRuntime::Point m_location;
+  QVariantMap m_attributes;
 };
 
 } // Dsa
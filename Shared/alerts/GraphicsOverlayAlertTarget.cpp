@@ -21,8 +21,10 @@
 
 // example app headers
 #include "GeometryQuadtree.h"
+#include "PreparedPolygon.h"
 
 // C++ API headers
+#include "GeoElement.h"
 #include "GraphicListModel.h"
 #include "GraphicsOverlay.h"
 
@@ -37,8 +39,12 @@ namespace Dsa {
   \brief Represents a target based on an \l Esri::ArcGISRuntime::GraphicsOverlay
   for an \l AlertCondition.
 
-  Changes to any of the graphics in the overlay will cause the \l AlertTarget::locationChanged
-  signal to be emitted.
+  The graphics are held in a \l GeometryQuadtree which is updated for each graphic
+  as it is added, removed or moved. Each of these changes causes the
+  \l AlertTarget::areaChanged signal to be emitted for the area of the graphic.
+
+  Polygon graphics are prepared for point-in-polygon tests the first time they are
+  requested, and re-used until the geometry of the graphic changes.
   */
 
 /*!
@@ -52,22 +58,32 @@ GraphicsOverlayAlertTarget::GraphicsOverlayAlertTarget(GraphicsOverlay* graphics
   m_graphicsOverlay(graphicsOverlay)
 {
   // respond to graphics being removed from the overlay
-  connect(m_graphicsOverlay->graphics(), &GraphicListModel::graphicRemoved, this, [this](int)
+  connect(m_graphicsOverlay->graphics(), &GraphicListModel::graphicRemoved, this, [this](int index)
   {
-    rebuildQuadtree();
-    emit dataChanged();
+    // the graphic has already left the model, so look it up in the local copy
+    if (index < 0 || index >= m_graphics.size())
+    {
+      rebuildQuadtree();
+      emit dataChanged();
+      return;
+    }
+
+    m_quadtree->removeGeoElement(m_graphics.takeAt(index));
   });
 
   // respond to graphics being added to the overlay
   connect(m_graphicsOverlay->graphics(), &GraphicListModel::graphicAdded, this, [this](int index)
   {
     Graphic* graphic = m_graphicsOverlay->graphics()->at(index);
-    setupGraphicConnections(graphic);
-    if (m_quadtree)
+    m_graphics.insert(index, graphic);
+    if (graphic)
       m_quadtree->appendGeoElment(graphic);
-    else
-      rebuildQuadtree();
+  });
 
+  // respond to the overlay being cleared
+  connect(m_graphicsOverlay->graphics(), &GraphicListModel::modelReset, this, [this]()
+  {
+    rebuildQuadtree();
     emit dataChanged();
   });
 
@@ -90,25 +106,35 @@ GraphicsOverlayAlertTarget::~GraphicsOverlayAlertTarget()
  */
 QList<Geometry> GraphicsOverlayAlertTarget::targetGeometries(const Envelope& targetArea) const
 {
-  // if the quadtree has been built, use  it to return the set of candidate geometries
-  if (m_quadtree)
-    return m_quadtree->candidateIntersections(targetArea);
-
-  // otherwise, return all of the geometry in the overlay
-  QList<Geometry> geomList;
-  const GraphicListModel* graphics = m_graphicsOverlay->graphics();
-  if (!graphics)
-    return geomList;
+  return m_quadtree->candidateIntersections(targetArea);
+}
 
-  const int count = graphics->rowCount();
-  for (int i = 0; i < count; ++i)
+/*!
+  \brief Returns the prepared polygons of the graphics in the \a targetArea.
+ */
+QList<std::shared_ptr<const PreparedPolygon>> GraphicsOverlayAlertTarget::targetPolygons(const Envelope& targetArea) const
+{
+  QList<std::shared_ptr<const PreparedPolygon>> polygons;
+  const QList<GeoElement*> elements = m_quadtree->candidateElements(targetArea);
+  for (GeoElement* element : elements)
   {
-    Graphic* graphic = m_graphicsOverlay->graphics()->at(i);
-    if (graphic)
-      geomList.append(graphic->geometry());
+    auto findIt = m_preparedPolygons.constFind(element);
+    if (findIt != m_preparedPolygons.constEnd())
+    {
+      polygons.append(findIt.value());
+      continue;
+    }
+
+    const Geometry geometry = element->geometry();
+    if (geometry.geometryType() != GeometryType::Polygon)
+      continue;
+
+    auto prepared = std::make_shared<const PreparedPolygon>(geometry);
+    m_preparedPolygons.insert(element, prepared);
+    polygons.append(prepared);
   }
 
-  return geomList;
+  return polygons;
 }
 
 /*!
@@ -119,19 +145,6 @@ QVariant GraphicsOverlayAlertTarget::targetValue() const
   return QVariant();
 }
 
-/*!
-  \internal
-
-  Connect signals etc. for a new \a graphic.
- */
-void GraphicsOverlayAlertTarget::setupGraphicConnections(Graphic* graphic)
-{
-  if (!graphic)
-    return;
-
-  m_graphicConnections.append(connect(graphic, &Graphic::geometryChanged, this, &GraphicsOverlayAlertTarget::dataChanged));
-}
-
 /*!
   \internal
 
@@ -145,25 +158,28 @@ void GraphicsOverlayAlertTarget::rebuildQuadtree()
     m_quadtree = nullptr;
   }
 
-  const GraphicListModel* graphics = m_graphicsOverlay->graphics();
-  if (!graphics)
-    return;
+  m_graphics.clear();
+  m_preparedPolygons.clear();
 
-  const int count = graphics->rowCount();
+  const GraphicListModel* graphics = m_graphicsOverlay->graphics();
+  const int count = graphics ? graphics->rowCount() : 0;
   QList<GeoElement*> elements;
   for (int i = 0; i < count; ++i)
   {
     Graphic* g = m_graphicsOverlay->graphics()->at(i);
-    if (!g)
-      continue;
-
-    setupGraphicConnections(g);
-    elements.append(g);
+    m_graphics.append(g);
+    if (g)
+      elements.append(g);
   }
 
-  // if there is more than 1 element in the overlay, build a quadtree
-  if (elements.size() > 1)
-    m_quadtree = new GeometryQuadtree(m_graphicsOverlay->extent(), elements, 8, this);
+  // build the quadtree even for small overlays, so that it can be maintained per graphic
+  m_quadtree = new GeometryQuadtree(m_graphicsOverlay->extent(), elements, 8, this);
+  connect(m_quadtree, &GeometryQuadtree::geoElementChanged, this, [this](const Envelope& changedArea, GeoElement* geoElement)
+  {
+    // the prepared polygon is out of date once the graphic has moved or been removed
+    m_preparedPolygons.remove(geoElement);
+    emit areaChanged(changedArea);
+  });
 }
 
 } // Dsa
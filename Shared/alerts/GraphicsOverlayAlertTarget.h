@@ -20,8 +20,12 @@
 // example app headers
 #include "AlertTarget.h"
 
+// Qt headers
+#include <QHash>
+
 namespace Esri {
 namespace ArcGISRuntime {
+class GeoElement;
 class Graphic;
 class GraphicsOverlay;
 }
@@ -41,14 +45,15 @@ public:
 
   QList<Esri::ArcGISRuntime::Geometry> targetGeometries(const Esri::ArcGISRuntime::Envelope& targetArea) const override;
   QVariant targetValue() const override;
+  QList<std::shared_ptr<const PreparedPolygon>> targetPolygons(const Esri::ArcGISRuntime::Envelope& targetArea) const override;
 
 private:
-  void setupGraphicConnections(Esri::ArcGISRuntime::Graphic* graphic);
   void rebuildQuadtree();
 
   Esri::ArcGISRuntime::GraphicsOverlay* m_graphicsOverlay = nullptr;
   GeometryQuadtree* m_quadtree = nullptr;
-  QList<QMetaObject::Connection> m_graphicConnections;
+  QList<Esri::ArcGISRuntime::Graphic*> m_graphics;
+  mutable QHash<Esri::ArcGISRuntime::GeoElement*, std::shared_ptr<const PreparedPolygon>> m_preparedPolygons;
 };
 
 } // Dsa
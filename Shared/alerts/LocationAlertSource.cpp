@@ -52,6 +52,7 @@ LocationAlertSource::LocationAlertSource(QObject* parent):
       return;
 
     m_location = location;
+    emit locationChanged();
     emit dataChanged();
   });
 }
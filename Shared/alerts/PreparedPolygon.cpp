@@ -0,0 +1,187 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+// PCH header
+#include "pch.hpp"
+
+#include "PreparedPolygon.h"
+
+// C++ API headers
+#include "Envelope.h"
+#include "GeometryEngine.h"
+#include "Part.h"
+#include "PartCollection.h"
+#include "Point.h"
+#include "Polygon.h"
+#include "PolygonBuilder.h"
+
+// STL headers
+#include <algorithm>
+#include <cmath>
+
+using namespace Esri::ArcGISRuntime;
+
+namespace Dsa {
+
+// polygons with at least this many edges are tested with the edge index
+const int PreparedPolygon::INDEX_THRESHOLD = 64;
+
+/*!
+  \class Dsa::PreparedPolygon
+  \inmodule Dsa
+  \brief A polygon projected to WGS84 and prepared for repeated point-in-polygon tests.
+
+  Alert targets such as geofences rarely change, so they are projected once and the
+  result is shared by every test until the target geometry changes.
+
+  Polygons with many edges also get an index of their edges, bucketed into horizontal
+  bands. A point is then tested by casting a ray through only the edges of its band,
+  rather than by a general intersection test against the whole polygon.
+
+  A PreparedPolygon is not modified after construction, so it can be shared between threads.
+ */
+
+/*!
+  \brief Constructor taking a \a polygon in any spatial reference.
+ */
+PreparedPolygon::PreparedPolygon(const Geometry& polygon):
+  m_geometry(GeometryEngine::project(polygon, SpatialReference::wgs84()))
+{
+  if (m_geometry.isEmpty() || m_geometry.geometryType() != GeometryType::Polygon)
+    return;
+
+  const Envelope extent = m_geometry.extent();
+  m_xMin = extent.xMin();
+  m_yMin = extent.yMin();
+  m_xMax = extent.xMax();
+  m_yMax = extent.yMax();
+
+  // collect the edges of every ring
+  QVector<Edge> edges;
+  PolygonBuilder builder(Polygon(m_geometry));
+  PartCollection* parts = builder.parts();
+  const int partCount = parts ? parts->size() : 0;
+  for (int i = 0; i < partCount; ++i)
+  {
+    Part* part = parts->part(i);
+    if (!part)
+      continue;
+
+    const int pointCount = part->pointCount();
+    for (int j = 0; j < pointCount; ++j)
+    {
+      // rings are closed implicitly, so join the last point back to the first
+      const Point from = part->point(j);
+      const Point to = part->point((j + 1) % pointCount);
+      edges.append(Edge{from.x(), from.y(), to.x(), to.y()});
+    }
+  }
+
+  if (edges.size() >= INDEX_THRESHOLD)
+    buildIndex(edges);
+}
+
+/*!
+  \brief Destructor.
+ */
+PreparedPolygon::~PreparedPolygon()
+{
+}
+
+/*!
+  \brief Returns the polygon projected to WGS84.
+ */
+Geometry PreparedPolygon::geometry() const
+{
+  return m_geometry;
+}
+
+/*!
+  \brief Returns whether the polygon is tested using the edge index.
+ */
+bool PreparedPolygon::isIndexed() const
+{
+  return !m_bands.isEmpty();
+}
+
+/*!
+  \brief Returns whether the polygon contains \a location.
+
+  \a location must be in WGS84.
+ */
+bool PreparedPolygon::contains(const Point& location) const
+{
+  if (m_geometry.isEmpty())
+    return false;
+
+  const double x = location.x();
+  const double y = location.y();
+  if (x < m_xMin || x > m_xMax || y < m_yMin || y > m_yMax)
+    return false;
+
+  if (!isIndexed())
+    return GeometryEngine::intersects(m_geometry, location);
+
+  const int band = std::min(static_cast<int>((y - m_yMin) / m_bandHeight), m_bands.size() - 1);
+
+  // count the edges crossed by a ray from the location towards +x (even-odd rule)
+  bool inside = false;
+  for (const Edge& edge : m_bands.at(band))
+  {
+    if ((edge.y1 > y) == (edge.y2 > y))
+      continue;
+
+    const double crossingX = edge.x1 + (y - edge.y1) * (edge.x2 - edge.x1) / (edge.y2 - edge.y1);
+    if (x < crossingX)
+      inside = !inside;
+  }
+
+  return inside;
+}
+
+/*!
+  \internal
+
+  Buckets \a edges into horizontal bands covering the extent of the polygon.
+ */
+void PreparedPolygon::buildIndex(const QVector<Edge>& edges)
+{
+  const double height = m_yMax - m_yMin;
+  if (height <= 0.0)
+    return;
+
+  // aim for a handful of edges per band
+  const int bandCount = std::max(1, std::min(static_cast<int>(edges.size()) / 4, 4096));
+  m_bandHeight = height / bandCount;
+  m_bands.resize(bandCount);
+
+  for (const Edge& edge : edges)
+  {
+    // horizontal edges are never crossed by the ray
+    if (edge.y1 == edge.y2)
+      continue;
+
+    const double edgeYMin = std::min(edge.y1, edge.y2);
+    const double edgeYMax = std::max(edge.y1, edge.y2);
+    const int firstBand = std::max(0, static_cast<int>((edgeYMin - m_yMin) / m_bandHeight));
+    const int lastBand = std::min(bandCount - 1, static_cast<int>((edgeYMax - m_yMin) / m_bandHeight));
+    for (int band = firstBand; band <= lastBand; ++band)
+      m_bands[band].append(edge);
+  }
+}
+
+} // Dsa
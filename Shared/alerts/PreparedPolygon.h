@@ -0,0 +1,70 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#ifndef PREPAREDPOLYGON_H
+#define PREPAREDPOLYGON_H
+
+// C++ API headers
+#include "Geometry.h"
+
+// Qt headers
+#include <QVector>
+
+namespace Esri {
+namespace ArcGISRuntime {
+class Point;
+}
+}
+
+namespace Dsa {
+
+class PreparedPolygon
+{
+public:
+  explicit PreparedPolygon(const Esri::ArcGISRuntime::Geometry& polygon);
+  ~PreparedPolygon();
+
+  Esri::ArcGISRuntime::Geometry geometry() const;
+
+  bool isIndexed() const;
+  bool contains(const Esri::ArcGISRuntime::Point& location) const;
+
+  static const int INDEX_THRESHOLD;
+
+private:
+  struct Edge
+  {
+    double x1;
+    double y1;
+    double x2;
+    double y2;
+  };
+
+  void buildIndex(const QVector<Edge>& edges);
+
+  Esri::ArcGISRuntime::Geometry m_geometry;
+  double m_xMin = 0.0;
+  double m_yMin = 0.0;
+  double m_xMax = 0.0;
+  double m_yMax = 0.0;
+  double m_bandHeight = 0.0;
+  QVector<QVector<Edge>> m_bands;
+};
+
+} // Dsa
+
+#endif // PREPAREDPOLYGON_H
@@ -22,6 +22,7 @@
 // example app headers
 #include "AlertSource.h"
 #include "AlertTarget.h"
+#include "PreparedPolygon.h"
 
 // C++ API headers
 #include "GeoElement.h"
@@ -64,7 +65,7 @@ WithinAreaAlertConditionData::WithinAreaAlertConditionData(const QString& name,
                                                            QObject* parent):
   AlertConditionData(name, level, source, target, parent)
 {
-
+  connect(source, &AlertSource::locationChanged, this, &WithinAreaAlertConditionData::handleDataChanged);
 }
 
 /*!
@@ -83,21 +84,53 @@ bool WithinAreaAlertConditionData::matchesQuery() const
   if (!isQueryOutOfDate())
     return cachedQueryResult();
 
-  Geometry sourceWgs84 = GeometryEngine::project(sourceLocation(), SpatialReference::wgs84());
-  const QList<Geometry> targetGeometries = target()->targetGeometries(sourceWgs84.extent());
+  return queryFunction()();
+}
 
-  for (const Geometry& target : targetGeometries)
-  {
-    if (target.geometryType() != GeometryType::Polygon)
-      continue;
+/*!
+  \brief Returns a function which tests a snapshot of the source location against
+  the prepared target polygons.
 
-    const Geometry targetWgs84 = GeometryEngine::project(target, sourceWgs84.spatialReference());
-    if (GeometryEngine::instance()->intersects(sourceWgs84, targetWgs84))
-      return true;
-  }
+  The target polygons are prepared (projected and indexed) once by the target and
+  shared between evaluations, so only the source location is projected here.
+ */
+std::function<bool()> WithinAreaAlertConditionData::queryFunction() const
+{
+  const Point sourceWgs84 = GeometryEngine::project(sourceLocation(), SpatialReference::wgs84());
+  const QList<std::shared_ptr<const PreparedPolygon>> targetPolygons = target()->targetPolygons(sourceWgs84.extent());
 
-  return false;
+  if (targetPolygons.isEmpty())
+    return []() { return false; };
+
+  return [sourceWgs84, targetPolygons]()
+  {
+    for (const auto& targetPolygon : targetPolygons)
+    {
+      if (targetPolygon->contains(sourceWgs84))
+        return true;
+    }
+
+    return false;
+  };
 }
 
+/*!
+  \brief Returns whether the source location lies within the WGS84 \a changedArea.
+
+  A target polygon can only start or stop containing the source if its extent
+  covers the source location.
+ */
+bool WithinAreaAlertConditionData::isQueryAreaAffected(const Envelope& changedArea) const
+{
+  if (changedArea.isEmpty())
+    return true;
+
+  const Point sourceWgs84 = GeometryEngine::project(sourceLocation(), SpatialReference::wgs84());
+
+  return changedArea.xMin() <= sourceWgs84.x() &&
+         changedArea.xMax() >= sourceWgs84.x() &&
+         changedArea.yMin() <= sourceWgs84.y() &&
+         changedArea.yMax() >= sourceWgs84.y();
+}
 
 } // Dsa
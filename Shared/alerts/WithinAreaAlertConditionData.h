@@ -45,6 +45,8 @@ public:
   ~WithinAreaAlertConditionData();
 
   bool matchesQuery() const override;
+  std::function<bool()> queryFunction() const override;
+  bool isQueryAreaAffected(const Esri::ArcGISRuntime::Envelope& changedArea) const override;
 };
 
 } // Dsa
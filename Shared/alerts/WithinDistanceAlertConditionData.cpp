@@ -29,7 +29,11 @@
 #include "Graphic.h"
 #include "Point.h"
 
+// Qt headers
+#include <QtMath>
+
 // STL headers
+#include <algorithm>
 #include <cmath>
 
 using namespace Esri::ArcGISRuntime;
@@ -70,7 +74,7 @@ WithinDistanceAlertConditionData::WithinDistanceAlertConditionData(const QString
   m_distance(distance),
   m_moveDistance(std::sqrt((m_distance * m_distance) + (m_distance * m_distance)))
 {
-
+  connect(source, &AlertSource::locationChanged, this, &WithinDistanceAlertConditionData::handleDataChanged);
 }
 
 /*!
@@ -98,12 +102,26 @@ bool WithinDistanceAlertConditionData::matchesQuery() const
   if (!isQueryOutOfDate())
     return cachedQueryResult();
 
+  return queryFunction()();
+}
+
+/*!
+  \brief Returns a function which tests a snapshot of the source location and the
+  candidate target geometries.
+
+  The candidate geometries are found on the calling thread; the buffer and
+  intersection tests are carried out by the returned function.
+ */
+std::function<bool()> WithinDistanceAlertConditionData::queryFunction() const
+{
+  const Point location = sourceLocation();
+
   // get 2 new points by moving the source position in a NE and SW position
   // m_moveDistance is the hypotenuse of the triangle with opposite and adjacent of distance
-  const QList<Point> southWest = GeometryEngine::moveGeodetic(QList<Point>{sourceLocation()}, m_moveDistance,
+  const QList<Point> southWest = GeometryEngine::moveGeodetic(QList<Point>{location}, m_moveDistance,
                                                               LinearUnit::meters(), 225.0, AngularUnit::degrees(),
                                                               GeodeticCurveType::Geodesic);
-  const QList<Point> northEast = GeometryEngine::moveGeodetic(QList<Point>{sourceLocation()}, m_moveDistance,
+  const QList<Point> northEast = GeometryEngine::moveGeodetic(QList<Point>{location}, m_moveDistance,
                                                               LinearUnit::meters(), 45.0, AngularUnit::degrees(),
                                                               GeodeticCurveType::Geodesic);
 
@@ -113,23 +131,52 @@ bool WithinDistanceAlertConditionData::matchesQuery() const
 
   // if there are no target geometries within the distance extent, stop
   if (targetGeometries.isEmpty())
-    return false;
+    return []() { return false; };
 
-  // buffer the source position by the distance for an accurate within distance test
-  const Geometry bufferGeom = GeometryEngine::bufferGeodetic(sourceLocation(), distance(), LinearUnit::meters(), 1.0,
-                                                             GeodeticCurveType::Geodesic);
-  const Geometry bufferWgs84 = GeometryEngine::project(bufferGeom, SpatialReference::wgs84());
-
-  // test the buffer against all the target geometries
-  for (const Geometry& target : targetGeometries)
+  const double thresholdDistance = distance();
+  return [location, targetGeometries, thresholdDistance]()
   {
-    Geometry targetWgs84 = GeometryEngine::project(target, SpatialReference::wgs84());
-    if (GeometryEngine::intersects(bufferWgs84, targetWgs84))
-      return true;
-  }
+    // buffer the source position by the distance for an accurate within distance test
+    const Geometry bufferGeom = GeometryEngine::bufferGeodetic(location, thresholdDistance, LinearUnit::meters(), 1.0,
+                                                               GeodeticCurveType::Geodesic);
+    const Geometry bufferWgs84 = GeometryEngine::project(bufferGeom, SpatialReference::wgs84());
+
+    // test the buffer against all the target geometries
+    for (const Geometry& target : targetGeometries)
+    {
+      Geometry targetWgs84 = GeometryEngine::project(target, SpatialReference::wgs84());
+      if (GeometryEngine::intersects(bufferWgs84, targetWgs84))
+        return true;
+    }
 
-  return false;
+    return false;
+  };
 }
 
+/*!
+  \brief Returns whether the WGS84 \a changedArea lies within the threshold distance
+  of the source location.
+
+  This is a conservative test used to skip re-testing the query when an unrelated
+  target element changes.
+ */
+bool WithinDistanceAlertConditionData::isQueryAreaAffected(const Envelope& changedArea) const
+{
+  if (changedArea.isEmpty())
+    return true;
+
+  const Point sourceWgs84 = GeometryEngine::project(sourceLocation(), SpatialReference::wgs84());
+
+  // convert the distance to degrees, with a margin for the approximation
+  constexpr double metersPerDegree = 111320.0;
+  constexpr double degreesToRadians = M_PI / 180.0;
+  const double latDelta = 1.5 * distance() / metersPerDegree;
+  const double lonDelta = latDelta / std::max(std::cos(sourceWgs84.y() * degreesToRadians), 0.01);
+
+  return changedArea.xMin() <= sourceWgs84.x() + lonDelta &&
+         changedArea.xMax() >= sourceWgs84.x() - lonDelta &&
+         changedArea.yMin() <= sourceWgs84.y() + latDelta &&
+         changedArea.yMax() >= sourceWgs84.y() - latDelta;
+}
 
 } // Dsa
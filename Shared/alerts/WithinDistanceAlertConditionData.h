@@ -41,6 +41,8 @@ public:
   double distance() const;
 
   bool matchesQuery() const override;
+  std::function<bool()> queryFunction() const override;
+  bool isQueryAreaAffected(const Esri::ArcGISRuntime::Envelope& changedArea) const override;
 
 private:
   double m_distance = 0.0;
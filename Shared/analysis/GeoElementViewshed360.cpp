@@ -25,7 +25,12 @@
 // C++ API headers
 #include "AnalysisOverlay.h"
 #include "AttributeListModel.h"
+#include "GeoElement.h"
 #include "GeoElementViewshed.h"
+#include "Point.h"
+
+// Qt headers
+#include <QTimer>
 
 // STL headers
 #include <cmath>
@@ -66,6 +71,18 @@ GeoElementViewshed360::GeoElementViewshed360(GeoElement* geoElement, AnalysisOve
   m_headingAttribute(headingAttribute),
   m_pitchAttribute(pitchAttribute)
 {
+  connect(m_geoElementSignaler.data(), &GeoElementSignaler::geometryChanged, this, &Viewshed360::locationChanged);
+
+  // the heading and pitch attributes are only read again when the attributes change
+  AttributeListModel* attributes = geoElement ? geoElement->attributes() : nullptr;
+  if (attributes && (!m_headingAttribute.isEmpty() || !m_pitchAttribute.isEmpty()))
+  {
+    connect(attributes, &AttributeListModel::dataChanged, this, &GeoElementViewshed360::refreshAttributes);
+    connect(attributes, &AttributeListModel::modelReset, this, &GeoElementViewshed360::refreshAttributes);
+    connect(attributes, &AttributeListModel::rowsInserted, this, &GeoElementViewshed360::refreshAttributes);
+    connect(attributes, &AttributeListModel::rowsRemoved, this, &GeoElementViewshed360::refreshAttributes);
+    refreshAttributes();
+  }
 }
 
 /*!
@@ -83,9 +100,24 @@ GeoElement* GeoElementViewshed360::geoElement() const
   return m_geoElementSignaler.isNull() ? nullptr : m_geoElementSignaler.data()->geoElement();
 }
 
+/*!
+  \brief Returns the location of the \l Esri::ArcGISRuntime::GeoElement.
+
+  Returns an empty point if the GeoElement has been deleted.
+ */
+Point GeoElementViewshed360::location() const
+{
+  if (m_geoElementSignaler.isNull())
+    return Point();
+
+  return Point(m_geoElementSignaler->geoElement()->geometry());
+}
+
 /*!
   \brief Returns the heading attribute of the \l Esri::ArcGISRuntime::GeoElement in degrees.
 
+  The value is cached and refreshed when the attributes of the GeoElement change.
+
   If not set, this returns \c NAN.
  */
 double GeoElementViewshed360::heading() const
@@ -96,13 +128,14 @@ double GeoElementViewshed360::heading() const
   if (m_geoElementSignaler.isNull())
     return NAN;
 
-  return m_geoElementSignaler->geoElement()->attributes()->attributeValue(m_headingAttribute).toDouble();
+  return m_heading;
 }
 
 /*!
   \brief Sets the heading attribute of the \l Esri::ArcGISRuntime::GeoElement to \a heading.
 
-  The supplied value should be in degrees.
+  The supplied value should be in degrees. Attribute writes are batched and applied
+  to the GeoElement in a single update.
  */
 void GeoElementViewshed360::setHeading(double heading)
 {
@@ -115,17 +148,11 @@ void GeoElementViewshed360::setHeading(double heading)
   }
   else
   {
-    if (m_geoElementSignaler.isNull())
+    if (m_geoElementSignaler.isNull() || m_heading == heading)
       return;
 
-    auto attributes = m_geoElementSignaler->geoElement()->attributes();
-    if (attributes->attributeValue(m_headingAttribute).toDouble() == heading)
-      return;
-
-    if (attributes->containsAttribute(m_headingAttribute))
-      attributes->replaceAttribute(m_headingAttribute, heading);
-    else
-      attributes->insertAttribute(m_headingAttribute, heading);
+    m_heading = heading;
+    queueAttribute(m_headingAttribute, heading);
   }
 
   emit headingChanged();
@@ -134,6 +161,8 @@ void GeoElementViewshed360::setHeading(double heading)
 /*!
   \brief Returns the pitch attribute of the \l Esri::ArcGISRuntime::GeoElement in degrees.
 
+  The value is cached and refreshed when the attributes of the GeoElement change.
+
   If not set, this returns \c NAN.
  */
 double GeoElementViewshed360::pitch() const
@@ -144,13 +173,14 @@ double GeoElementViewshed360::pitch() const
   if (m_geoElementSignaler.isNull())
     return NAN;
 
-  return m_geoElementSignaler->geoElement()->attributes()->attributeValue(m_pitchAttribute).toDouble();
+  return m_pitch;
 }
 
 /*!
   \brief Sets the pitch attribute of the \l Esri::ArcGISRuntime::GeoElement to \a pitch.
 
-  The supplied value should be in degrees.
+  The supplied value should be in degrees. Attribute writes are batched and applied
+  to the GeoElement in a single update.
  */
 void GeoElementViewshed360::setPitch(double pitch)
 {
@@ -163,17 +193,11 @@ void GeoElementViewshed360::setPitch(double pitch)
   }
   else
   {
-    if (m_geoElementSignaler.isNull())
+    if (m_geoElementSignaler.isNull() || m_pitch == pitch)
       return;
 
-    auto attributes = m_geoElementSignaler->geoElement()->attributes();
-    if (attributes->attributeValue(m_pitchAttribute).toDouble() == pitch)
-      return;
-
-    if (attributes->containsAttribute(m_pitchAttribute))
-      attributes->replaceAttribute(m_pitchAttribute, pitch);
-    else
-      attributes->insertAttribute(m_pitchAttribute, pitch);
+    m_pitch = pitch;
+    queueAttribute(m_pitchAttribute, pitch);
   }
 
   emit pitchChanged();
@@ -246,4 +270,98 @@ QString GeoElementViewshed360::pitchAttribute() const
   return m_pitchAttribute;
 }
 
+/*!
+  \internal
+
+  Re-reads the heading and pitch attributes after the attributes of the GeoElement change.
+  Attributes with a write pending keep their cached value.
+ */
+void GeoElementViewshed360::refreshAttributes()
+{
+  if (m_updatingAttributes || m_geoElementSignaler.isNull())
+    return;
+
+  AttributeListModel* attributes = m_geoElementSignaler->geoElement()->attributes();
+  if (!attributes)
+    return;
+
+  if (!m_headingAttribute.isEmpty() && !m_pendingAttributes.contains(m_headingAttribute))
+  {
+    const double heading = attributes->attributeValue(m_headingAttribute).toDouble();
+    if (heading != m_heading)
+    {
+      m_heading = heading;
+      emit headingChanged();
+    }
+  }
+
+  if (!m_pitchAttribute.isEmpty() && !m_pendingAttributes.contains(m_pitchAttribute))
+  {
+    const double pitch = attributes->attributeValue(m_pitchAttribute).toDouble();
+    if (pitch != m_pitch)
+    {
+      m_pitch = pitch;
+      emit pitchChanged();
+    }
+  }
+}
+
+/*!
+  \internal
+
+  Queues \a value to be written to the attribute \a attributeName.
+ */
+void GeoElementViewshed360::queueAttribute(const QString& attributeName, double value)
+{
+  m_pendingAttributes.insert(attributeName, value);
+
+  if (m_flushScheduled)
+    return;
+
+  m_flushScheduled = true;
+  QTimer::singleShot(0, this, &GeoElementViewshed360::flushAttributes);
+}
+
+/*!
+  \internal
+
+  Writes the queued attribute values to the GeoElement in a single update.
+ */
+void GeoElementViewshed360::flushAttributes()
+{
+  m_flushScheduled = false;
+
+  if (m_pendingAttributes.isEmpty() || m_geoElementSignaler.isNull())
+  {
+    m_pendingAttributes.clear();
+    return;
+  }
+
+  AttributeListModel* attributes = m_geoElementSignaler->geoElement()->attributes();
+  if (!attributes)
+  {
+    m_pendingAttributes.clear();
+    return;
+  }
+
+  // the values are already cached, so the change notifications for this update are ignored
+  m_updatingAttributes = true;
+
+  if (m_pendingAttributes.size() == 1 && attributes->containsAttribute(m_pendingAttributes.firstKey()))
+  {
+    attributes->replaceAttribute(m_pendingAttributes.firstKey(), m_pendingAttributes.first());
+  }
+  else
+  {
+    QVariantMap attributesMap = attributes->attributesMap();
+    for (auto it = m_pendingAttributes.cbegin(); it != m_pendingAttributes.cend(); ++it)
+      attributesMap.insert(it.key(), it.value());
+
+    attributes->setAttributesMap(attributesMap);
+  }
+
+  m_updatingAttributes = false;
+  m_pendingAttributes.clear();
+}
+
 } // Dsa
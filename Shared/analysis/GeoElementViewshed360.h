@@ -20,6 +20,12 @@
 // example app headers
 #include "Viewshed360.h"
 
+// Qt headers
+#include <QVariantMap>
+
+// STL headers
+#include <cmath>
+
 namespace Esri {
   namespace ArcGISRuntime {
     class GeoElement;
@@ -40,6 +46,8 @@ public:
 
   Esri::ArcGISRuntime::GeoElement* geoElement() const;
 
+  Esri::ArcGISRuntime::Point location() const override;
+
   double heading() const override;
   void setHeading(double heading) override;
 
@@ -60,9 +68,18 @@ private:
   Q_DISABLE_COPY(GeoElementViewshed360)
   GeoElementViewshed360() = delete;
 
+  void refreshAttributes();
+  void queueAttribute(const QString& attributeName, double value);
+  void flushAttributes();
+
   QPointer<GeoElementSignaler> m_geoElementSignaler;
   QString m_headingAttribute;
   QString m_pitchAttribute;
+  double m_heading = NAN;
+  double m_pitch = NAN;
+  QVariantMap m_pendingAttributes;
+  bool m_flushScheduled = false;
+  bool m_updatingAttributes = false;
 };
 
 } // Dsa
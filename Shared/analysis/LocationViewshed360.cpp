@@ -59,10 +59,40 @@ constexpr double c_defaultMaxDistance = 500.0;
   \endlist
  */
 LocationViewshed360::LocationViewshed360(const Point& point, GraphicsOverlay* graphicsOverlay, AnalysisOverlay* analysisOverlay, QObject* parent) :
-  Viewshed360(new LocationViewshed(point, c_defaultHeading, c_defaultPitch, c_defaultHorizontalAngle,
-                                   c_defaultVerticalAngle, c_defaultMinDistance, c_defaultMaxDistance, parent), analysisOverlay, parent),
+  LocationViewshed360(new LocationViewshed(point, c_defaultHeading, c_defaultPitch, c_defaultHorizontalAngle,
+                                           c_defaultVerticalAngle, c_defaultMinDistance, c_defaultMaxDistance, parent),
+                      point, graphicsOverlay, analysisOverlay, parent)
+{
+}
+
+/*!
+  \brief Constructor for a 360 degree viewshed which re-uses an existing \a viewshed analysis.
+
+  The \a viewshed is reset to the default values and moved to \a point. This allows
+  analyses to be pooled rather than created for every new viewshed.
+
+  \list
+    \li \a viewshed - The \l Esri::ArcGISRuntime::LocationViewshed to re-use.
+    \li \a point - The \l Esri::ArcGISRuntime::Point which the viewshehd will be centered upon.
+    \li \a graphicsOverlay - The \l Esri::ArcGISRuntime::GraphicsOverlay which will contains the viewshed direction graphic.
+    \li \a analysisOverlay - The \l Esri::ArcGISRuntime::AnalysisOverlay which contains the viewshed.
+    \li \a parent - An optional parent.
+  \endlist
+ */
+LocationViewshed360::LocationViewshed360(LocationViewshed* viewshed, const Point& point, GraphicsOverlay* graphicsOverlay,
+                                         AnalysisOverlay* analysisOverlay, QObject* parent) :
+  Viewshed360(viewshed, analysisOverlay, parent),
   m_graphicsOverlay(graphicsOverlay)
 {
+  viewshed->setLocation(point);
+  viewshed->setHeading(c_defaultHeading);
+  viewshed->setPitch(c_defaultPitch);
+  viewshed->setHorizontalAngle(c_defaultHorizontalAngle);
+  viewshed->setVerticalAngle(c_defaultVerticalAngle);
+  viewshed->setMinDistance(c_defaultMinDistance);
+  viewshed->setMaxDistance(c_defaultMaxDistance);
+  viewshed->setVisible(true);
+
   m_locationViewshedGraphic = new Graphic(point, parent);
   constexpr double headingOffset = -180.0;
   m_locationViewshedGraphic->attributes()->insertAttribute(ViewshedController::VIEWSHED_HEADING_ATTRIBUTE, headingOffset);
@@ -85,6 +115,14 @@ LocationViewshed360::~LocationViewshed360()
     m_graphicsOverlay->graphics()->removeOne(m_locationViewshedGraphic);
 }
 
+/*!
+  \brief Returns the location of the observer, which is the \l point.
+ */
+Point LocationViewshed360::location() const
+{
+  return point();
+}
+
 /*!
   \brief Returns the \l Esri::ArcGISRuntime::Point which the viewshed is centered upon.
  */
@@ -100,6 +138,8 @@ void LocationViewshed360::setPoint(const Point& point)
 {
   static_cast<LocationViewshed*>(viewshed())->setLocation(point);
   m_locationViewshedGraphic->setGeometry(point);
+
+  emit locationChanged();
 }
 
 /*!
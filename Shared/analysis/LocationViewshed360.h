@@ -25,6 +25,7 @@ namespace Esri {
     class Point;
     class GraphicsOverlay;
     class Graphic;
+    class LocationViewshed;
   }
 }
 
@@ -38,8 +39,14 @@ public:
   LocationViewshed360(const Esri::ArcGISRuntime::Point& point,
                 Esri::ArcGISRuntime::GraphicsOverlay* graphicsOverlay,
                 Esri::ArcGISRuntime::AnalysisOverlay* analysisOverlay, QObject* parent = nullptr);
+  LocationViewshed360(Esri::ArcGISRuntime::LocationViewshed* viewshed,
+                const Esri::ArcGISRuntime::Point& point,
+                Esri::ArcGISRuntime::GraphicsOverlay* graphicsOverlay,
+                Esri::ArcGISRuntime::AnalysisOverlay* analysisOverlay, QObject* parent = nullptr);
   ~LocationViewshed360();
 
+  Esri::ArcGISRuntime::Point location() const override;
+
   Esri::ArcGISRuntime::Point point() const;
   void setPoint(const Esri::ArcGISRuntime::Point& point);
 
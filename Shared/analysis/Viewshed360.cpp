@@ -36,6 +36,10 @@ namespace Dsa {
 
   When in 360 degree mode the \l horizontalAngle is set to 360 degrees.
 
+  The analysis is only drawn while the viewshed is \l visible and not \l suppressed.
+  Viewsheds are suppressed by the \l ViewshedController to keep the cost of
+  rendering within its budget.
+
   \sa Esri::ArcGISRuntime::Viewshed
   */
 
@@ -79,7 +83,7 @@ void Viewshed360::removeFromOverlay()
  */
 bool Viewshed360::isVisible() const
 {
-  return m_viewshed->isVisible();
+  return m_visible;
 }
 
 /*!
@@ -87,14 +91,45 @@ bool Viewshed360::isVisible() const
  */
 void Viewshed360::setVisible(bool visible)
 {
-  if (m_viewshed->isVisible() == visible)
+  if (m_visible == visible)
     return;
 
-  m_viewshed->setVisible(visible);
+  m_visible = visible;
+  m_viewshed->setVisible(m_visible && !m_suppressed);
 
   emit visibleChanged();
 }
 
+/*!
+  \property Viewshed360::suppressed
+  \brief Returns whether drawing the viewshed is suppressed, even though it is \l visible.
+ */
+bool Viewshed360::isSuppressed() const
+{
+  return m_suppressed;
+}
+
+/*!
+  \brief Sets whether drawing the viewshed is \a suppressed.
+
+  This does not change the \l visible property.
+ */
+void Viewshed360::setSuppressed(bool suppressed)
+{
+  if (m_suppressed == suppressed)
+    return;
+
+  m_suppressed = suppressed;
+  m_viewshed->setVisible(m_visible && !m_suppressed);
+
+  emit suppressedChanged();
+}
+
+/*!
+  \fn Esri::ArcGISRuntime::Point Viewshed360::location() const
+  \brief Returns the location of the observer of the viewshed.
+ */
+
 /*!
   \property Viewshed360::name
   \brief Returns the name of the viewshed.
@@ -391,6 +426,16 @@ AnalysisOverlay* Viewshed360::analysisOverlay() const
   \brief Signal emitted when the name property changes.
  */
 
+/*!
+  \fn void Viewshed360::locationChanged();
+  \brief Signal emitted when the location of the observer changes.
+ */
+
+/*!
+  \fn void Viewshed360::suppressedChanged();
+  \brief Signal emitted when the suppressed property changes.
+ */
+
 /*!
   \fn void Viewshed360::visibleChanged();
   \brief Signal emitted when the visible property changes.
@@ -25,6 +25,7 @@ namespace Esri {
   namespace ArcGISRuntime {
     class Viewshed;
     class AnalysisOverlay;
+    class Point;
   }
 }
 
@@ -35,6 +36,7 @@ class Viewshed360 : public QObject
   Q_OBJECT
 
   Q_PROPERTY(bool visible READ isVisible WRITE setVisible NOTIFY visibleChanged)
+  Q_PROPERTY(bool suppressed READ isSuppressed NOTIFY suppressedChanged)
   Q_PROPERTY(QString name READ name WRITE setName NOTIFY nameChanged)
   Q_PROPERTY(double minDistance READ minDistance WRITE setMinDistance NOTIFY minDistanceChanged)
   Q_PROPERTY(double maxDistance READ maxDistance WRITE setMaxDistance NOTIFY maxDistanceChanged)
@@ -56,6 +58,11 @@ public:
   bool isVisible() const;
   virtual void setVisible(bool visible);
 
+  bool isSuppressed() const;
+  void setSuppressed(bool suppressed);
+
+  virtual Esri::ArcGISRuntime::Point location() const = 0;
+
   QString name() const;
   void setName(const QString& name);
 
@@ -93,6 +100,8 @@ public:
 
 signals:
   void visibleChanged();
+  void suppressedChanged();
+  void locationChanged();
   void nameChanged();
   void minDistanceChanged();
   void maxDistanceChanged();
@@ -119,6 +128,8 @@ private:
   QPointer<Esri::ArcGISRuntime::AnalysisOverlay> m_analysisOverlay;
 
   QString m_name;
+  bool m_visible = true;
+  bool m_suppressed = false;
   bool m_is360Mode = true;
   double m_lastHorizontalAngle = 120.0;
 };
@@ -27,6 +27,7 @@
 #include "LocationController.h"
 #include "LocationDisplay3d.h"
 #include "LocationViewshed360.h"
+#include "MessagesPickIndex.h"
 #include "ViewshedListModel.h"
 #include "GeoElementUtils.h"
 
@@ -35,15 +36,23 @@
 #include "ToolResourceProvider.h"
 
 // C++ API headers
+#include "Envelope.h"
 #include "GeoElementViewshed.h"
+#include "GeometryEngine.h"
 #include "GlobeCameraController.h"
 #include "LocationViewshed.h"
 #include "OrbitLocationCameraController.h"
 #include "SceneQuickView.h"
 #include "SimpleMarkerSceneSymbol.h"
 #include "SimpleRenderer.h"
+#include "Viewpoint.h"
+
+// Qt headers
+#include <QElapsedTimer>
+#include <QTimer>
 
 // STL headers
+#include <algorithm>
 #include <cmath>
 
 using namespace Esri::ArcGISRuntime;
@@ -52,12 +61,22 @@ namespace Dsa {
 
 const QString ViewshedController::VIEWSHED_HEADING_ATTRIBUTE = QStringLiteral("heading");
 const QString ViewshedController::VIEWSHED_PITCH_ATTRIBUTE = QStringLiteral("pitch");
+const QString ViewshedController::VIEWSHED_BUDGET_PROPERTYNAME = QStringLiteral("ViewshedBudget");
 
 static int s_viewshedCount = 0;
 
 constexpr double c_defaultOffsetZ = 5.0;
 constexpr double c_defaultIdentifyTolerance = 5.0;
 
+// viewsheds whose range ends further than this from the camera (in meters) are not drawn
+constexpr double c_maxCameraDistance = 25000.0;
+
+// the delay used to coalesce changes before re-applying the budget, in milliseconds
+constexpr int c_budgetUpdateInterval = 250;
+
+// the maximum number of analyses kept for re-use
+constexpr int c_maxPooledAnalyses = 8;
+
 /*!
   \class Dsa::ViewshedController
   \inmodule Dsa
@@ -74,6 +93,17 @@ constexpr double c_defaultIdentifyTolerance = 5.0;
 
   In addition, viewsheds can be either normal (up to 120 degrees of arc)
   or 360 degree mode.
+
+  The cost of rendering grows with the number of frusta drawn, so the tool keeps the
+  viewsheds within a \l viewshedBudget of frusta (see \l frustumCount). Viewsheds whose
+  range is off-screen, or ends more than 25km from the camera, are not drawn. The
+  remaining viewsheds are drawn nearest to the camera first until the budget is spent;
+  the active viewshed is always drawn. Viewsheds which are not drawn are
+  \l {Viewshed360::suppressed}{suppressed} without changing their visible property.
+
+  The \l Esri::ArcGISRuntime::LocationViewshed analyses of removed viewsheds are pooled
+  and re-used for new location viewsheds. The time spent creating analyses is recorded
+  by \l analysisCreationElapsed.
  */
 
 /*!
@@ -82,8 +112,13 @@ constexpr double c_defaultIdentifyTolerance = 5.0;
 ViewshedController::ViewshedController(QObject* parent) :
   Toolkit::AbstractTool(parent),
   m_analysisOverlay(new AnalysisOverlay(this)),
-  m_viewsheds(new ViewshedListModel(this))
+  m_viewsheds(new ViewshedListModel(this)),
+  m_budgetTimer(new QTimer(this))
 {
+  m_budgetTimer->setSingleShot(true);
+  m_budgetTimer->setInterval(c_budgetUpdateInterval);
+  connect(m_budgetTimer, &QTimer::timeout, this, &ViewshedController::updateBudget);
+
   connect(Toolkit::ToolResourceProvider::instance(), &Toolkit::ToolResourceProvider::geoViewChanged, this, [this]
   {
     setSceneView(dynamic_cast<SceneView*>(Toolkit::ToolResourceProvider::instance()->geoView()));
@@ -97,12 +132,15 @@ ViewshedController::ViewshedController(QObject* parent) :
 
     // remove viewshed from analysis overlay and delete object
     viewshedPtr->removeFromOverlay();
+    recycleAnalysis(viewshed);
 
     if (viewshed == m_locationDisplayViewshed)
     {
       m_locationDisplayViewshed = nullptr;
       emit locationDisplayViewshedActiveChanged();
     }
+
+    scheduleBudgetUpdate();
   });
 
   // this tool must be in the tool manager before adding analyses below
@@ -110,10 +148,7 @@ ViewshedController::ViewshedController(QObject* parent) :
 
   auto sceneView = dynamic_cast<SceneView*>(Toolkit::ToolResourceProvider::instance()->geoView());
   if (sceneView)
-  {
-    m_sceneView = sceneView;
-    m_sceneView->analysisOverlays()->append(m_analysisOverlay);
-  }
+    setSceneView(sceneView);
 }
 
 /*!
@@ -135,6 +170,16 @@ void ViewshedController::setSceneView(SceneView* sceneView)
 
   if (!m_sceneView->analysisOverlays()->contains(m_analysisOverlay))
     m_sceneView->analysisOverlays()->append(m_analysisOverlay);
+
+  // viewsheds move on and off screen as the camera changes
+  if (m_viewpointConn)
+    disconnect(m_viewpointConn);
+
+  SceneQuickView* sceneQuickView = dynamic_cast<SceneQuickView*>(m_sceneView);
+  if (sceneQuickView)
+    m_viewpointConn = connect(sceneQuickView, &SceneQuickView::viewpointChanged, this, &ViewshedController::scheduleBudgetUpdate);
+
+  scheduleBudgetUpdate();
 }
 
 /*!
@@ -172,6 +217,18 @@ void ViewshedController::onMouseClicked(QMouseEvent& event)
   }
   case AddGeoElementViewshed360:
   {
+    // a message graphic under the position can be picked without an identify task,
+    // when the index could place every message graphic exactly
+    MessagesPickIndex* pickIndex = MessagesPickIndex::instance();
+    const QList<MessagesPickIndex::PickResult> pickResults = pickIndex->hasApproximatePlacement(m_sceneView)
+        ? QList<MessagesPickIndex::PickResult>()
+        : pickIndex->pick(m_sceneView, event.pos(), c_defaultIdentifyTolerance, 1);
+    if (!pickResults.isEmpty())
+    {
+      addGeoElementViewshed360(pickResults.first().graphic);
+      break;
+    }
+
     if (!m_identifyConn)
     {
       // connect to the completion of the identify operation.
@@ -249,11 +306,14 @@ void ViewshedController::addLocationDisplayViewshed()
     return;
 
   Graphic* locationGraphic = locationController->locationDisplay()->locationGraphic();
+
+  QElapsedTimer creationTimer;
+  creationTimer.start();
   m_locationDisplayViewshed = new GeoElementViewshed360(locationGraphic, m_analysisOverlay, VIEWSHED_HEADING_ATTRIBUTE, VIEWSHED_PITCH_ATTRIBUTE, this);
   m_locationDisplayViewshed->setName(QStringLiteral("Location Display Viewshed"));
   m_locationDisplayViewshed->setOffsetZ(c_defaultOffsetZ);
-  m_analysisOverlay->analyses()->append(m_locationDisplayViewshed->viewshed());
-  m_viewsheds->append(m_locationDisplayViewshed);
+  addViewshed(m_locationDisplayViewshed);
+  recordAnalysisCreation(creationTimer.nsecsElapsed(), false);
 
   m_activeViewshed = m_locationDisplayViewshed;
   emit locationDisplayViewshedActiveChanged();
@@ -295,11 +355,15 @@ void ViewshedController::addLocationViewshed360(const Esri::ArcGISRuntime::Point
     }
   }
 
-  auto locationViewshed360 = new LocationViewshed360(point, m_graphicsOverlay, m_analysisOverlay, this);
+  QElapsedTimer creationTimer;
+  creationTimer.start();
+  LocationViewshed* pooledAnalysis = takePooledAnalysis();
+  auto locationViewshed360 = pooledAnalysis ? new LocationViewshed360(pooledAnalysis, point, m_graphicsOverlay, m_analysisOverlay, this)
+                                            : new LocationViewshed360(point, m_graphicsOverlay, m_analysisOverlay, this);
   s_viewshedCount++;
   locationViewshed360->setName(QString("Viewshed %1").arg(QString::number(s_viewshedCount)));
-  m_analysisOverlay->analyses()->append(locationViewshed360->viewshed());
-  m_viewsheds->append(locationViewshed360);
+  addViewshed(locationViewshed360);
+  recordAnalysisCreation(creationTimer.nsecsElapsed(), pooledAnalysis != nullptr);
 
   // clear any existing camera contollers.
   if (m_followCamCtrllr)
@@ -334,6 +398,8 @@ void ViewshedController::addGeoElementViewshed360(GeoElement* geoElement)
 {
   removeActiveViewshed();
 
+  QElapsedTimer creationTimer;
+  creationTimer.start();
   auto geoElementViewshed360 = new GeoElementViewshed360(geoElement, m_analysisOverlay, QString(), QString(), this);
   s_viewshedCount++;
   geoElementViewshed360->setName(QString("Viewshed %1").arg(QString::number(s_viewshedCount)));
@@ -341,8 +407,8 @@ void ViewshedController::addGeoElementViewshed360(GeoElement* geoElement)
     GeoElementUtils::setParent(geoElement, geoElementViewshed360);
 
   geoElementViewshed360->setOffsetZ(c_defaultOffsetZ);
-  m_analysisOverlay->analyses()->append(geoElementViewshed360->viewshed());
-  m_viewsheds->append(geoElementViewshed360);
+  addViewshed(geoElementViewshed360);
+  recordAnalysisCreation(creationTimer.nsecsElapsed(), false);
 
   m_activeViewshed = geoElementViewshed360;
   updateActiveViewshed();
@@ -417,6 +483,109 @@ QString ViewshedController::toolName() const
   return QStringLiteral("viewshed");
 }
 
+/*! \brief Sets any values in \a properties which are relevant for the viewshed tool.
+ *
+ * This tool will use the following key/value pairs in the \a properties map if they are set:
+ *
+ * \list
+ *  \li \c ViewshedBudget - The maximum number of viewshed frusta drawn at once (see \l viewshedBudget).
+ * \endlist
+ */
+void ViewshedController::setProperties(const QVariantMap& properties)
+{
+  auto budgetFindIt = properties.find(VIEWSHED_BUDGET_PROPERTYNAME);
+  if (budgetFindIt != properties.end())
+  {
+    bool ok = false;
+    const int budget = budgetFindIt.value().toInt(&ok);
+    if (ok)
+      setViewshedBudget(budget);
+  }
+}
+
+/*!
+  \property ViewshedController::viewshedBudget
+  \brief Returns the maximum number of frusta which the viewsheds may draw at once.
+
+  A value of \c 0 or less means the number of viewsheds is not limited, although
+  off-screen and distant viewsheds are still not drawn. The default is \c 8.
+ */
+int ViewshedController::viewshedBudget() const
+{
+  return m_viewshedBudget;
+}
+
+/*!
+  \brief Sets the maximum number of frusta which the viewsheds may draw at once to \a viewshedBudget.
+ */
+void ViewshedController::setViewshedBudget(int viewshedBudget)
+{
+  if (m_viewshedBudget == viewshedBudget)
+    return;
+
+  m_viewshedBudget = viewshedBudget;
+  emit viewshedBudgetChanged();
+
+  updateBudget();
+}
+
+/*!
+  \property ViewshedController::viewshedCost
+  \brief Returns the number of frusta drawn by the viewsheds which are not suppressed.
+ */
+int ViewshedController::viewshedCost() const
+{
+  return m_viewshedCost;
+}
+
+/*!
+  \brief Returns the approximate number of frusta rendered for \a viewshed.
+
+  A 360 degree viewshed is rendered as 4 frusta; otherwise one frustum is used for
+  every 120 degrees of horizontal angle.
+ */
+int ViewshedController::frustumCount(Viewshed360* viewshed)
+{
+  if (!viewshed)
+    return 0;
+
+  constexpr int frusta360Mode = 4;
+  if (viewshed->is360Mode())
+    return frusta360Mode;
+
+  constexpr double frustumAngle = 120.0;
+  return std::max(1, static_cast<int>(std::ceil(viewshed->horizontalAngle() / frustumAngle)));
+}
+
+/*!
+  \property ViewshedController::analysisCreationElapsed
+  \brief Returns the total time spent creating viewshed analyses, in nanoseconds.
+
+  This includes the time taken to reset analyses re-used from the pool.
+ */
+qint64 ViewshedController::analysisCreationElapsed() const
+{
+  return m_analysisCreationElapsed;
+}
+
+/*!
+  \property ViewshedController::analysisCreationCount
+  \brief Returns the number of viewsheds created.
+ */
+int ViewshedController::analysisCreationCount() const
+{
+  return m_analysisCreationCount;
+}
+
+/*!
+  \property ViewshedController::pooledAnalysisCount
+  \brief Returns the number of viewsheds created by re-using a pooled analysis.
+ */
+int ViewshedController::pooledAnalysisCount() const
+{
+  return m_pooledAnalysisCount;
+}
+
 /*!
   \brief Returns the active viewshed.
  */
@@ -447,6 +616,7 @@ void ViewshedController::removeActiveViewshed()
 void ViewshedController::finishActiveViewshed()
 {
   m_activeViewshed = nullptr;
+  scheduleBudgetUpdate();
 }
 
 /*!
@@ -735,6 +905,192 @@ void ViewshedController::setActiveViewshed360Mode(bool is360Mode)
   m_activeViewshed->set360Mode(is360Mode);
 }
 
+/*!
+  \internal
+
+  Adds the analysis of \a viewshed to the overlay and the viewshed to the list,
+  and re-applies the budget whenever the cost of drawing it could change.
+ */
+void ViewshedController::addViewshed(Viewshed360* viewshed)
+{
+  m_analysisOverlay->analyses()->append(viewshed->viewshed());
+  m_viewsheds->append(viewshed);
+
+  connect(viewshed, &Viewshed360::visibleChanged, this, &ViewshedController::scheduleBudgetUpdate);
+  connect(viewshed, &Viewshed360::is360ModeChanged, this, &ViewshedController::scheduleBudgetUpdate);
+  connect(viewshed, &Viewshed360::horizontalAngleChanged, this, &ViewshedController::scheduleBudgetUpdate);
+  connect(viewshed, &Viewshed360::maxDistanceChanged, this, &ViewshedController::scheduleBudgetUpdate);
+  connect(viewshed, &Viewshed360::locationChanged, this, &ViewshedController::scheduleBudgetUpdate);
+}
+
+/*!
+  \internal
+
+  Returns the analysis of the removed \a viewshed to the pool, or deletes it
+  if it cannot be re-used.
+ */
+void ViewshedController::recycleAnalysis(Viewshed360* viewshed)
+{
+  Viewshed* analysis = viewshed->viewshed();
+  if (!analysis)
+    return;
+
+  // a GeoElementViewshed is bound to its GeoElement, so only location viewsheds can be re-used
+  LocationViewshed* locationAnalysis = dynamic_cast<LocationViewshed*>(analysis);
+  if (locationAnalysis && m_analysisPool.size() < c_maxPooledAnalyses)
+  {
+    m_analysisPool.append(locationAnalysis);
+    return;
+  }
+
+  analysis->deleteLater();
+}
+
+/*!
+  \internal
+
+  Returns a pooled analysis, or \c nullptr if the pool is empty.
+ */
+LocationViewshed* ViewshedController::takePooledAnalysis()
+{
+  return m_analysisPool.isEmpty() ? nullptr : m_analysisPool.takeLast();
+}
+
+/*!
+  \internal
+
+  Records that creating an analysis took \a elapsedNs nanoseconds, and whether it was \a pooled.
+ */
+void ViewshedController::recordAnalysisCreation(qint64 elapsedNs, bool pooled)
+{
+  m_analysisCreationElapsed += elapsedNs;
+  ++m_analysisCreationCount;
+
+  if (pooled)
+    ++m_pooledAnalysisCount;
+
+  emit statisticsChanged();
+}
+
+/*!
+  \internal
+
+  Coalesces changes to the camera and the viewsheds into a single budget update.
+ */
+void ViewshedController::scheduleBudgetUpdate()
+{
+  if (!m_budgetTimer->isActive())
+    m_budgetTimer->start();
+}
+
+/*!
+  \internal
+
+  Decides which viewsheds are drawn, suppressing those which are off-screen, distant
+  or beyond the budget.
+ */
+void ViewshedController::updateBudget()
+{
+  m_budgetTimer->stop();
+
+  Point cameraLocation;
+  Envelope visibleExtent;
+  if (m_sceneView)
+  {
+    cameraLocation = m_sceneView->currentViewpointCamera().location();
+    const Geometry visibleArea = m_sceneView->currentViewpoint(ViewpointType::BoundingGeometry).targetGeometry();
+    if (!visibleArea.isEmpty())
+      visibleExtent = GeometryEngine::project(visibleArea.extent(), SpatialReference::wgs84());
+  }
+
+  struct Candidate
+  {
+    Viewshed360* viewshed = nullptr;
+    double distance = 0.0;
+  };
+
+  QList<Candidate> candidates;
+  for (int i = 0; i < m_viewsheds->rowCount(); ++i)
+  {
+    Viewshed360* viewshed = m_viewsheds->at(i);
+    if (!viewshed)
+      continue;
+
+    // a hidden viewshed draws nothing, so it does not use any of the budget
+    if (!viewshed->isVisible())
+    {
+      viewshed->setSuppressed(false);
+      continue;
+    }
+
+    Candidate candidate;
+    candidate.viewshed = viewshed;
+
+    const Point location = viewshed->location();
+    if (!location.isEmpty())
+    {
+      const Point locationWgs84 = GeometryEngine::project(location, SpatialReference::wgs84());
+
+      // test whether the range of the viewshed overlaps the visible area
+      if (!visibleExtent.isEmpty())
+      {
+        constexpr double metersPerDegree = 111320.0;
+        const double rangeY = viewshed->maxDistance() / metersPerDegree;
+        const double rangeX = rangeY / std::max(0.01, std::cos(locationWgs84.y() * M_PI / 180.0));
+        if (locationWgs84.x() + rangeX < visibleExtent.xMin() || locationWgs84.x() - rangeX > visibleExtent.xMax() ||
+            locationWgs84.y() + rangeY < visibleExtent.yMin() || locationWgs84.y() - rangeY > visibleExtent.yMax())
+        {
+          viewshed->setSuppressed(viewshed != m_activeViewshed);
+          continue;
+        }
+      }
+
+      if (!cameraLocation.isEmpty())
+      {
+        const Point cameraWgs84 = GeometryEngine::project(cameraLocation, SpatialReference::wgs84());
+        candidate.distance = DsaUtility::distance3D(cameraWgs84, locationWgs84);
+        if (candidate.distance - viewshed->maxDistance() > c_maxCameraDistance)
+        {
+          viewshed->setSuppressed(viewshed != m_activeViewshed);
+          continue;
+        }
+      }
+    }
+
+    candidates.append(candidate);
+  }
+
+  // the active viewshed is always drawn, then the nearest viewsheds within the budget
+  std::sort(candidates.begin(), candidates.end(), [this](const Candidate& a, const Candidate& b)
+  {
+    if ((a.viewshed == m_activeViewshed) != (b.viewshed == m_activeViewshed))
+      return a.viewshed == m_activeViewshed;
+
+    return a.distance < b.distance;
+  });
+
+  int cost = 0;
+  for (const Candidate& candidate : qAsConst(candidates))
+  {
+    const int candidateCost = frustumCount(candidate.viewshed);
+    const bool overBudget = m_viewshedBudget > 0 && cost + candidateCost > m_viewshedBudget;
+    if (overBudget && candidate.viewshed != m_activeViewshed)
+    {
+      candidate.viewshed->setSuppressed(true);
+      continue;
+    }
+
+    candidate.viewshed->setSuppressed(false);
+    cost += candidateCost;
+  }
+
+  if (m_viewshedCost == cost)
+    return;
+
+  m_viewshedCost = cost;
+  emit viewshedCostChanged();
+}
+
 /*!
   \internal
  */
@@ -764,6 +1120,9 @@ void ViewshedController::updateActiveViewshedSignals()
  */
 void ViewshedController::updateActiveViewshed()
 {
+  // the active viewshed is always drawn, so apply the budget straight away
+  updateBudget();
+
   if (!m_activeViewshed)
   {
     disconnectActiveViewshedSignals();
@@ -890,6 +1249,21 @@ void ViewshedController::emitActiveViewshedSignals()
   \brief Signal emitted when currently active viewshed enabled changes.
  */
 
+/*!
+  \fn void ViewshedController::viewshedCostChanged();
+  \brief Signal emitted when the viewshedCost property changes.
+ */
+
+/*!
+  \fn void ViewshedController::statisticsChanged();
+  \brief Signal emitted when the analysis creation statistics change.
+ */
+
+/*!
+  \fn void ViewshedController::viewshedBudgetChanged();
+  \brief Signal emitted when the viewshedBudget property changes.
+ */
+
 /*!
   \fn void ViewshedController::activeModeChanged();
   \brief Signal emitted when the active mode changes.
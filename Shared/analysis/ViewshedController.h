@@ -25,8 +25,10 @@
 
 // Qt headers
 #include <QAbstractListModel>
+#include <QList>
 
 class QMouseEvent;
+class QTimer;
 
 namespace Esri {
   namespace ArcGISRuntime {
@@ -35,6 +37,7 @@ namespace Esri {
     class GeoElement;
     class GlobeCameraController;
     class GraphicsOverlay;
+    class LocationViewshed;
     class OrbitLocationCameraController;
   }
 }
@@ -51,6 +54,11 @@ class ViewshedController : public Esri::ArcGISRuntime::Toolkit::AbstractTool
 
   Q_PROPERTY(ViewshedActiveMode activeMode READ activeMode WRITE setActiveMode NOTIFY activeModeChanged)
   Q_PROPERTY(QAbstractListModel* viewsheds READ viewsheds CONSTANT)
+  Q_PROPERTY(int viewshedBudget READ viewshedBudget WRITE setViewshedBudget NOTIFY viewshedBudgetChanged)
+  Q_PROPERTY(int viewshedCost READ viewshedCost NOTIFY viewshedCostChanged)
+  Q_PROPERTY(qint64 analysisCreationElapsed READ analysisCreationElapsed NOTIFY statisticsChanged)
+  Q_PROPERTY(int analysisCreationCount READ analysisCreationCount NOTIFY statisticsChanged)
+  Q_PROPERTY(int pooledAnalysisCount READ pooledAnalysisCount NOTIFY statisticsChanged)
 
   // active viewshed properties
   Q_PROPERTY(bool activeViewshedEnabled READ isActiveViewshedEnabled NOTIFY activeViewshedEnabledChanged)
@@ -71,6 +79,9 @@ class ViewshedController : public Esri::ArcGISRuntime::Toolkit::AbstractTool
 
 signals:
   void activeModeChanged();
+  void viewshedBudgetChanged();
+  void viewshedCostChanged();
+  void statisticsChanged();
 
   // active viewshed signals
   void activeViewshedEnabledChanged();
@@ -102,6 +113,7 @@ public:
 
   static const QString VIEWSHED_HEADING_ATTRIBUTE;
   static const QString VIEWSHED_PITCH_ATTRIBUTE;
+  static const QString VIEWSHED_BUDGET_PROPERTYNAME;
 
   explicit ViewshedController(QObject* parent = nullptr);
   ~ViewshedController();
@@ -120,6 +132,17 @@ public:
   QAbstractListModel* viewsheds() const;
 
   QString toolName() const override;
+  void setProperties(const QVariantMap& properties) override;
+
+  int viewshedBudget() const;
+  void setViewshedBudget(int viewshedBudget);
+
+  int viewshedCost() const;
+  static int frustumCount(Viewshed360* viewshed);
+
+  qint64 analysisCreationElapsed() const;
+  int analysisCreationCount() const;
+  int pooledAnalysisCount() const;
 
   // active viewshed methods
   Viewshed360* activeViewshed() const;
@@ -166,6 +189,13 @@ public slots:
 private:
   void connectMouseSignals();
 
+  void addViewshed(Viewshed360* viewshed);
+  void recycleAnalysis(Viewshed360* viewshed);
+  Esri::ArcGISRuntime::LocationViewshed* takePooledAnalysis();
+  void recordAnalysisCreation(qint64 elapsedNs, bool pooled);
+  void scheduleBudgetUpdate();
+  void updateBudget();
+
   void updateActiveViewshed();
   void updateActiveViewshedSignals();
   void disconnectActiveViewshedSignals();
@@ -188,6 +218,15 @@ private:
   QMetaObject::Connection m_identifyConn;
 
   QList<QMetaObject::Connection> m_activeViewshedConns;
+
+  int m_viewshedBudget = 8;
+  int m_viewshedCost = 0;
+  QTimer* m_budgetTimer = nullptr;
+  QMetaObject::Connection m_viewpointConn;
+  QList<Esri::ArcGISRuntime::LocationViewshed*> m_analysisPool;
+  qint64 m_analysisCreationElapsed = 0;
+  int m_analysisCreationCount = 0;
+  int m_pooledAnalysisCount = 0;
 };
 
 } // Dsa
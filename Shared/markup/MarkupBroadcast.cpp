@@ -39,6 +39,7 @@ namespace Dsa {
 const QString MarkupBroadcast::MARKUPCONFIG_PROPERTYNAME = QStringLiteral("MarkupConfig");
 const QString MarkupBroadcast::ROOTDATA_PROPERTYNAME = QStringLiteral("RootDataDirectory");
 const QString MarkupBroadcast::UDPPORT_PROPERTYNAME = QStringLiteral("port");
+const QString MarkupBroadcast::MULTICASTGROUP_PROPERTYNAME = QStringLiteral("multicastGroup");
 const QString MarkupBroadcast::USERNAME_PROPERTYNAME = QStringLiteral("UserName");
 const QString MarkupBroadcast::NAMEKEY = QStringLiteral("name");
 const QString MarkupBroadcast::MARKUPKEY = QStringLiteral("markup");
@@ -50,6 +51,11 @@ const QString MarkupBroadcast::SHAREDBYKEY = QStringLiteral("sharedBy");
   \inherits Toolkit::AbstractTool
   \brief Tool controller for broadcasting markups.
 
+  Markups are broadcast on the \c port of the \c MarkupConfig property. If the
+  config also sets a \c multicastGroup, markups are sent to that group instead,
+  and the group is joined to receive them. Addresses which are not multicast
+  addresses are ignored.
+
   \sa DataSender
   \sa DataListener
  */
@@ -128,6 +134,10 @@ void MarkupBroadcast::setProperties(const QVariantMap& properties)
     if (ok)
       m_udpPort = newPort;
   }
+
+  const QHostAddress multicastGroup(markupPortConfig.value(MULTICASTGROUP_PROPERTYNAME).toString());
+  m_multicastGroup = multicastGroup.isMulticast() ? multicastGroup : QHostAddress();
+
   updateDataSender();
   updateDataListener();
 }
@@ -152,7 +162,16 @@ void MarkupBroadcast::updateDataSender()
     return;
 
   QUdpSocket* udpSocket = new QUdpSocket(m_dataSender);
-  udpSocket->connectToHost(QHostAddress::Broadcast, m_udpPort, QIODevice::WriteOnly);
+  if (m_multicastGroup.isNull())
+  {
+    udpSocket->connectToHost(QHostAddress::Broadcast, m_udpPort, QIODevice::WriteOnly);
+  }
+  else
+  {
+    // markups sent by this host are recognized when they are received back
+    udpSocket->setSocketOption(QAbstractSocket::MulticastLoopbackOption, 1);
+    udpSocket->connectToHost(m_multicastGroup, m_udpPort, QIODevice::WriteOnly);
+  }
   m_dataSender->setDevice(udpSocket);
 }
 
@@ -165,7 +184,16 @@ void MarkupBroadcast::updateDataListener()
     return;
 
   QUdpSocket* udpSocket = new QUdpSocket(this);
-  udpSocket->bind(m_udpPort, QUdpSocket::DontShareAddress | QUdpSocket::ReuseAddressHint);
+  if (m_multicastGroup.isNull())
+  {
+    udpSocket->bind(m_udpPort, QUdpSocket::DontShareAddress | QUdpSocket::ReuseAddressHint);
+  }
+  else
+  {
+    // a dual-stack socket cannot join IPv4 groups on some platforms
+    udpSocket->bind(QHostAddress::AnyIPv4, m_udpPort, QUdpSocket::DontShareAddress | QUdpSocket::ReuseAddressHint);
+    udpSocket->joinMulticastGroup(m_multicastGroup);
+  }
   m_dataListener->setDevice(udpSocket);
 }
 
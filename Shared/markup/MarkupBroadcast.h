@@ -20,6 +20,9 @@
 // toolkit headers
 #include "AbstractTool.h"
 
+// Qt headers
+#include <QHostAddress>
+
 class QJsonObject;
 class QJsonDocument;
 
@@ -53,6 +56,7 @@ private:
   static const QString MARKUPCONFIG_PROPERTYNAME;
   static const QString ROOTDATA_PROPERTYNAME;
   static const QString UDPPORT_PROPERTYNAME;
+  static const QString MULTICASTGROUP_PROPERTYNAME;
   static const QString USERNAME_PROPERTYNAME;
   static const QString MARKUPKEY;
   static const QString NAMEKEY;
@@ -62,6 +66,7 @@ private:
   DataSender* m_dataSender;
   DataListener* m_dataListener;
   int m_udpPort = -1;
+  QHostAddress m_multicastGroup;
 };
 
 } // Dsa
@@ -21,14 +21,22 @@
 #include "Message.h"
 
 // C++ API headers
+#include "ImmutablePartCollection.h"
+#include "Part.h"
+#include "PartCollection.h"
 #include "Point.h"
 #include "PolygonBuilder.h"
 #include "PolylineBuilder.h"
 
 // Qt headers
-#include <QDomDocument>
+#include <QDataStream>
+#include <QHash>
+#include <QVector>
 #include <QXmlStreamReader>
 
+// STL headers
+#include <cstring>
+
 namespace Dsa {
 
 const QString Message::COT_ROOT_ELEMENT_NAME{QStringLiteral("events")};
@@ -56,6 +64,78 @@ const QString Message::SIDC_NAME{QStringLiteral("sidc")};
 
 using namespace Esri::ArcGISRuntime;
 
+// compact binary messages start with this tag, which can never begin an XML document
+static const char s_binaryMessageMagic[] = {'D', 'S', 'A', 'M'};
+static const int s_binaryMessageMagicSize = sizeof(s_binaryMessageMagic);
+
+// the layout following the tag; bump when it changes
+static const quint8 s_binaryMessageVersion = 2;
+
+// geometry kinds of a compact binary message
+enum class BinaryGeometry : quint8
+{
+  None = 0,
+  Point,
+  Polyline,
+  Polygon
+};
+
+static const quint8 s_binaryGeometryHasZ = 0x01;
+
+// strings are written as UTF-8 with a 16-bit length, which is far shorter than QDataStream's UTF-16
+static void writeBinaryString(QDataStream& stream, const QString& value)
+{
+  const QByteArray utf8 = value.toUtf8().left(0xFFFF);
+  stream << static_cast<quint16>(utf8.size());
+  stream.writeRawData(utf8.constData(), utf8.size());
+}
+
+static QString readBinaryString(QDataStream& stream)
+{
+  quint16 size = 0;
+  stream >> size;
+  if (stream.status() != QDataStream::Ok)
+    return QString();
+
+  QByteArray utf8(size, Qt::Uninitialized);
+  if (stream.readRawData(utf8.data(), size) != size)
+  {
+    stream.setStatus(QDataStream::ReadPastEnd);
+    return QString();
+  }
+
+  return QString::fromUtf8(utf8);
+}
+
+// each part keeps its own points, so polylines with several paths and polygons with holes survive
+template <typename T>
+static void appendParts(const T& multipart, QVector<QVector<Point>>& parts)
+{
+  const ImmutablePartCollection multipartParts = multipart.parts();
+  for (int partIndex = 0; partIndex < multipartParts.size() && parts.size() < 0xFFFF; ++partIndex)
+  {
+    const ImmutablePart part = multipartParts.part(partIndex);
+    QVector<Point> points;
+    for (int pointIndex = 0; pointIndex < part.pointCount() && points.size() < 0xFFFF; ++pointIndex)
+      points.append(part.point(pointIndex));
+
+    parts.append(points);
+  }
+}
+
+// interned message types shared by every parsed Message and feed
+static QHash<QString, int>& messageTypeKeys()
+{
+  static QHash<QString, int> keys;
+  return keys;
+}
+
+static QStringList& messageTypes()
+{
+  static QStringList types;
+  return types;
+}
+
 /*!
   \class Dsa::Message
   \inmodule Dsa
@@ -144,49 +224,44 @@ bool Message::operator==(const Message& other) const
 /*!
   \brief Static method to create a message from a QByteArray \a message.
 
-  Demetermines if the provided bytes contain a CoT event
-  or a GeoMessage and then forwards to the appropriate factory
+  Demetermines if the provided bytes contain a compact binary message,
+  a CoT event or a GeoMessage and then forwards to the appropriate factory.
+  Only the leading tag or first element is read to make this decision,
+  so the bytes are not parsed twice.
+
+  If \a acceptType is supplied, it is called with the interned
+  message type key as soon as the type is known and, if it returns
+  \c false, an empty Message is returned without building its geometry.
  */
-Message Message::create(const QByteArray& message)
+Message Message::create(const QByteArray& message, const MessageTypeFilter& acceptType)
 {
-  QDomDocument doc;
-  if (!doc.setContent(message))
-    return Message();
-
-  // check root element name
-  QDomElement parentElement = doc.firstChildElement(COT_ROOT_ELEMENT_NAME);
-  if (!parentElement.isNull())
-  {
-    return createFromCoTMessage(message);
-  }
+  if (isBinaryMessage(message))
+    return createFromBinaryMessage(message, acceptType);
 
-  parentElement = doc.firstChildElement(GEOMESSAGE_ROOT_ELEMENT_NAME);
-  if (!parentElement.isNull())
-  {
-    return createFromGeoMessage(message);
-  }
+  QXmlStreamReader reader(message);
+  if (!reader.readNextStartElement())
+    return Message();
 
-  // fall back to individual element name
-  parentElement = doc.firstChildElement(COT_ELEMENT_NAME);
-  if (!parentElement.isNull())
-  {
-    return createFromCoTMessage(message);
-  }
+  // check root element name, falling back to individual element name
+  const auto rootName = reader.name();
+  if (rootName == COT_ROOT_ELEMENT_NAME || rootName == COT_ELEMENT_NAME)
+    return createFromCoTMessage(message, acceptType);
 
-  parentElement = doc.firstChildElement(GEOMESSAGE_ELEMENT_NAME);
-  if (!parentElement.isNull())
-  {
-    return createFromGeoMessage(message);
-  }
+  if (rootName == GEOMESSAGE_ROOT_ELEMENT_NAME || rootName == GEOMESSAGE_ELEMENT_NAME)
+    return createFromGeoMessage(message, acceptType);
 
   return Message();
 }
 
 /*!
   \brief Static method to create from a Cot (Cursor on Target) QByteArray \a message.
+
+  If \a acceptType rejects the message type key, an empty Message is returned.
  */
-Message Message::createFromCoTMessage(const QByteArray& message)
+Message Message::createFromCoTMessage(const QByteArray& message, const MessageTypeFilter& acceptType)
 {
+  static const int cotTypeKey = internMessageType(QStringLiteral("cot"));
+
   // parse CoT XML bytes and build up a Message object from the
   // supplied information
   Message cotMessage;
@@ -205,6 +280,10 @@ Message Message::createFromCoTMessage(const QByteArray& message)
       {
         inCoTMessageElement = true;
 
+        // skip unwanted messages before any further parsing
+        if (acceptType && !acceptType(cotTypeKey))
+          return Message();
+
         const auto attrs = reader.attributes();
         const auto type = attrs.value(COT_TYPE_NAME).toString();
         // convert the CoT type to a sidc symbol code
@@ -216,7 +295,8 @@ Message Message::createFromCoTMessage(const QByteArray& message)
         cotMessage.d->messageAction = MessageAction::Update;
 
         // CoT message type
-        cotMessage.d->messageType = QStringLiteral("cot");
+        cotMessage.d->messageTypeKey = cotTypeKey;
+        cotMessage.d->messageType = messageTypeFromKey(cotTypeKey);
 
         // store the sidc symbol id code as an attribute of
         // the Message as well as the symbol Id variable
@@ -261,6 +341,9 @@ Message Message::createFromCoTMessage(const QByteArray& message)
     reader.readNext();
   }
 
+  if (reader.hasError())
+    return Message();
+
   // assign the Message attributes
   cotMessage.d->attributes = attributes;
 
@@ -269,13 +352,17 @@ Message Message::createFromCoTMessage(const QByteArray& message)
 
 /*!
   \brief Static method to create from a GeoMessage QByteArray \a message.
+
+  If \a acceptType rejects the message type key, an empty Message is returned
+  before the geometry is built.
  */
-Message Message::createFromGeoMessage(const QByteArray& message)
+Message Message::createFromGeoMessage(const QByteArray& message, const MessageTypeFilter& acceptType)
 {
   // parse GeoMessage XML bytes and build up a Message object from the
   // supplied information
   Message geoMessage;
   QVariantMap attributes;
+  QString typeText;
   QString wkidText;
   QString controlPointsText;
   QString environmentText;
@@ -305,7 +392,7 @@ Message Message::createFromGeoMessage(const QByteArray& message)
 
       if (QStringRef::compare(reader.name(), GEOMESSAGE_TYPE_NAME, Qt::CaseInsensitive) == 0)
       {
-        geoMessage.d->messageType = reader.readElementText();
+        typeText = reader.readElementText();
       }
       else if (QStringRef::compare(reader.name(), GEOMESSAGE_ACTION_NAME, Qt::CaseInsensitive) == 0)
       {
@@ -351,11 +438,22 @@ Message Message::createFromGeoMessage(const QByteArray& message)
     reader.readNext();
   }
 
+  if (reader.hasError())
+    return Message();
+
   if (!environmentText.isEmpty())
   {
-    geoMessage.d->messageType += QString("_%1").arg(environmentText);
+    typeText += QLatin1Char('_') + environmentText;
   }
 
+  // share the interned type string when this type is known
+  const int typeKey = findMessageTypeKey(typeText);
+  if (acceptType && !acceptType(typeKey))
+    return Message();
+
+  geoMessage.d->messageTypeKey = typeKey;
+  geoMessage.d->messageType = typeKey == -1 ? typeText : messageTypeFromKey(typeKey);
+
   if (!controlPointsText.isEmpty())
   {
     const SpatialReference sr = wkidText.isEmpty() ? SpatialReference::wgs84() : SpatialReference(wkidText.toInt());
@@ -415,6 +513,152 @@ Message Message::createFromGeoMessage(const QByteArray& message)
   return geoMessage;
 }
 
+/*!
+  \brief Static method to create from a compact binary QByteArray \a message.
+
+  The bytes must have been written by \l toBinaryMessage. An empty Message
+  is returned if they are truncated or use an unknown version.
+
+  If \a acceptType rejects the message type key, an empty Message is returned
+  before the geometry is read.
+ */
+Message Message::createFromBinaryMessage(const QByteArray& message, const MessageTypeFilter& acceptType)
+{
+  if (!isBinaryMessage(message))
+    return Message();
+
+  QDataStream stream(message);
+  stream.skipRawData(s_binaryMessageMagicSize);
+
+  quint8 version = 0;
+  qint8 action = 0;
+  stream >> version >> action;
+  if (stream.status() != QDataStream::Ok || version != s_binaryMessageVersion)
+    return Message();
+
+  const QString typeText = readBinaryString(stream);
+  if (stream.status() != QDataStream::Ok)
+    return Message();
+
+  // share the interned type string when this type is known
+  const int typeKey = findMessageTypeKey(typeText);
+  if (acceptType && !acceptType(typeKey))
+    return Message();
+
+  Message binaryMessage;
+  binaryMessage.d->messageAction = action >= static_cast<qint8>(MessageAction::Update) && action <= static_cast<qint8>(MessageAction::Unselect) ?
+        static_cast<MessageAction>(action) : MessageAction::Unknown;
+  binaryMessage.d->messageTypeKey = typeKey;
+  binaryMessage.d->messageType = typeKey == -1 ? typeText : messageTypeFromKey(typeKey);
+  binaryMessage.d->messageId = readBinaryString(stream);
+  binaryMessage.d->messageName = readBinaryString(stream);
+  binaryMessage.d->symbolId = readBinaryString(stream);
+
+  quint8 geometryKind = 0;
+  quint8 geometryFlags = 0;
+  qint32 wkid = 0;
+  quint16 partCount = 0;
+  stream >> geometryKind >> geometryFlags >> wkid >> partCount;
+  if (stream.status() != QDataStream::Ok)
+    return Message();
+
+  const bool hasZ = geometryFlags & s_binaryGeometryHasZ;
+  const SpatialReference sr = wkid > 0 ? SpatialReference(wkid) : SpatialReference::wgs84();
+
+  switch (static_cast<BinaryGeometry>(geometryKind))
+  {
+  case BinaryGeometry::None:
+    break;
+  case BinaryGeometry::Point:
+  {
+    quint16 pointCount = 0;
+    stream >> pointCount;
+    if (partCount != 1 || pointCount != 1)
+      return Message();
+
+    double x = 0.0, y = 0.0, z = 0.0;
+    stream >> x >> y;
+    if (hasZ)
+      stream >> z;
+
+    binaryMessage.d->geometry = hasZ ? Point(x, y, z, sr) : Point(x, y, sr);
+    break;
+  }
+  case BinaryGeometry::Polyline:
+  case BinaryGeometry::Polygon:
+  {
+    QObject localParent;
+    MultipartBuilder* multiPartBuilder = nullptr;
+    if (static_cast<BinaryGeometry>(geometryKind) == BinaryGeometry::Polygon)
+      multiPartBuilder = new PolygonBuilder(sr, &localParent);
+    else
+      multiPartBuilder = new PolylineBuilder(sr, &localParent);
+
+    for (int partIndex = 0; partIndex < partCount && stream.status() == QDataStream::Ok; ++partIndex)
+    {
+      quint16 pointCount = 0;
+      stream >> pointCount;
+
+      Part* part = new Part(sr, &localParent);
+      for (int i = 0; i < pointCount && stream.status() == QDataStream::Ok; ++i)
+      {
+        double x = 0.0, y = 0.0, z = 0.0;
+        stream >> x >> y;
+        if (hasZ)
+        {
+          stream >> z;
+          part->addPoint(x, y, z);
+        }
+        else
+        {
+          part->addPoint(x, y);
+        }
+      }
+
+      multiPartBuilder->parts()->addPart(part);
+    }
+
+    binaryMessage.d->geometry = multiPartBuilder->toGeometry();
+    break;
+  }
+  default:
+    return Message();
+  }
+
+  quint16 attributeCount = 0;
+  stream >> attributeCount;
+
+  QVariantMap attributes;
+  for (int i = 0; i < attributeCount && stream.status() == QDataStream::Ok; ++i)
+  {
+    const QString key = readBinaryString(stream);
+    attributes.insert(key, readBinaryString(stream));
+  }
+
+  if (stream.status() != QDataStream::Ok)
+    return Message();
+
+  // the symbol ID is carried once and restored to the attributes a GeoMessage would have
+  if (!binaryMessage.d->symbolId.isEmpty())
+  {
+    attributes.insert(GEOMESSAGE_SIC_NAME, binaryMessage.d->symbolId);
+    attributes.insert(SIDC_NAME, binaryMessage.d->symbolId);
+  }
+
+  binaryMessage.d->attributes = attributes;
+
+  return binaryMessage;
+}
+
+/*!
+  \brief Returns whether \a message starts with the compact binary message tag.
+ */
+bool Message::isBinaryMessage(const QByteArray& message)
+{
+  return message.size() > s_binaryMessageMagicSize &&
+      memcmp(message.constData(), s_binaryMessageMagic, s_binaryMessageMagicSize) == 0;
+}
+
 /*!
   \brief Static method to convert a CoT type string \a cotType to a SIDC string.
  */
@@ -510,6 +754,66 @@ QString Message::fromMessageAction(MessageAction action)
   return QString();
 }
 
+/*!
+  \brief Static method to convert an \a encoding string to a MessageEncoding enum value.
+
+  \c "binary" selects the compact binary encoding. Any other value
+  selects the GeoMessage format.
+ */
+Message::MessageEncoding Message::toMessageEncoding(const QString& encoding)
+{
+  if (encoding.compare("binary", Qt::CaseInsensitive) == 0)
+    return MessageEncoding::Binary;
+
+  return MessageEncoding::GeoMessage;
+}
+
+/*!
+  \brief Returns the interned key for \a messageType, adding it if needed.
+
+  Keys are stable for the lifetime of the application and can be
+  compared and hashed instead of the type strings.
+ */
+int Message::internMessageType(const QString& messageType)
+{
+  auto& keys = messageTypeKeys();
+  auto it = keys.constFind(messageType);
+  if (it != keys.constEnd())
+    return it.value();
+
+  auto& types = messageTypes();
+  const int key = types.size();
+  types.append(messageType);
+  keys.insert(messageType, key);
+  return key;
+}
+
+/*!
+  \brief Returns the interned key for \a messageType, or \c -1 if it has
+  not been interned.
+
+  Unlike \l internMessageType, types received over the network are never
+  added by this lookup.
+ */
+int Message::findMessageTypeKey(const QString& messageType)
+{
+  return messageTypeKeys().value(messageType, -1);
+}
+
+/*!
+  \brief Returns the interned type string for \a messageTypeKey.
+
+  The returned string shares its data with every other copy of the type.
+ */
+QString Message::messageTypeFromKey(int messageTypeKey)
+{
+  const auto& types = messageTypes();
+  if (messageTypeKey < 0 || messageTypeKey >= types.size())
+    return QString();
+
+  return types.at(messageTypeKey);
+}
+
 /*!
   \brief Returns whether the message is empty.
  */
@@ -614,7 +918,27 @@ QString Message::messageType() const
  */
 void Message::setMessageType(const QString& messageType)
 {
-  d->messageType = messageType;
+  if (messageType.isEmpty())
+  {
+    d->messageTypeKey = -1;
+    d->messageType = messageType;
+    return;
+  }
+
+  d->messageTypeKey = internMessageType(messageType);
+  d->messageType = messageTypeFromKey(d->messageTypeKey);
+}
+
+/*!
+  \brief Returns the interned key of the message type.
+
+  Returns \c -1 if the message type has not been interned.
+
+  \sa internMessageType
+ */
+int Message::messageTypeKey() const
+{
+  return d->messageTypeKey;
 }
 
 /*!
@@ -692,6 +1016,99 @@ QByteArray Message::toGeoMessage() const
   return message;
 }
 
+/*!
+  \brief Returns the current message as QByteArray in the compact binary format.
+
+  The ID, type, name, symbol ID, geometry and the attributes a GeoMessage
+  would carry are written after a tag and version, so \l create can tell
+  the encodings apart. Position reports are typically a fraction of the
+  size of the equivalent GeoMessage and are read without an XML parser.
+ */
+QByteArray Message::toBinaryMessage() const
+{
+  QByteArray message;
+  QDataStream stream(&message, QIODevice::WriteOnly);
+
+  stream.writeRawData(s_binaryMessageMagic, s_binaryMessageMagicSize);
+  stream << s_binaryMessageVersion << static_cast<qint8>(messageAction());
+
+  writeBinaryString(stream, messageType());
+  writeBinaryString(stream, messageId());
+  writeBinaryString(stream, messageName());
+  writeBinaryString(stream, symbolId());
+
+  const Geometry geom = geometry();
+  BinaryGeometry geometryKind = BinaryGeometry::None;
+  QVector<QVector<Point>> parts;
+  switch (geom.geometryType())
+  {
+  case GeometryType::Point:
+    geometryKind = BinaryGeometry::Point;
+    parts.append(QVector<Point>{geometry_cast<Point>(geom)});
+    break;
+  case GeometryType::Polyline:
+    geometryKind = BinaryGeometry::Polyline;
+    appendParts(geometry_cast<Polyline>(geom), parts);
+    break;
+  case GeometryType::Polygon:
+    geometryKind = BinaryGeometry::Polygon;
+    appendParts(geometry_cast<Polygon>(geom), parts);
+    break;
+  default:
+    break;
+  }
+
+  const bool hasZ = geom.hasZ();
+  stream << static_cast<quint8>(geometryKind)
+         << static_cast<quint8>(hasZ ? s_binaryGeometryHasZ : 0)
+         << static_cast<qint32>(geom.isEmpty() ? 0 : geom.spatialReference().wkid())
+         << static_cast<quint16>(parts.size());
+
+  for (const QVector<Point>& points : parts)
+  {
+    stream << static_cast<quint16>(points.size());
+    for (const Point& point : points)
+    {
+      stream << point.x() << point.y();
+      if (hasZ)
+        stream << point.z();
+    }
+  }
+
+  // attributes which start with "_" are stored in member variables, and the symbol ID is already written
+  const auto attribs = attributes();
+  QVariantMap binaryAttributes;
+  for (QVariantMap::const_iterator iter = attribs.constBegin(); iter != attribs.constEnd(); ++iter)
+  {
+    const auto key = iter.key();
+    if (key.startsWith("_") || key == GEOMESSAGE_SIC_NAME || key == SIDC_NAME)
+      continue;
+
+    binaryAttributes.insert(key, iter.value());
+  }
+
+  stream << static_cast<quint16>(qMin(binaryAttributes.size(), 0xFFFF));
+  int written = 0;
+  for (QVariantMap::const_iterator iter = binaryAttributes.constBegin(); iter != binaryAttributes.constEnd() && written < 0xFFFF; ++iter, ++written)
+  {
+    writeBinaryString(stream, iter.key());
+    writeBinaryString(stream, iter.value().toString());
+  }
+
+  return message;
+}
+
+/*!
+  \brief Returns the current message as QByteArray in the given \a encoding.
+ */
+QByteArray Message::encode(MessageEncoding encoding) const
+{
+  if (encoding == MessageEncoding::Binary)
+    return toBinaryMessage();
+
+  return toGeoMessage();
+}
+
 /*!
   \internal
  */
@@ -719,6 +1136,7 @@ MessageData::MessageData(const MessageData& other) :
   messageId(other.messageId),
   messageName(other.messageName),
   messageType(other.messageType),
+  messageTypeKey(other.messageTypeKey),
   symbolId(other.symbolId)
 {
 }
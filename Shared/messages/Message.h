@@ -24,6 +24,9 @@
 #include <QSharedData>
 #include <QVariantMap>
 
+// STL headers
+#include <functional>
+
 namespace Dsa {
 
 class MessageData;
@@ -63,6 +66,12 @@ public:
     Unknown = -1
   };
 
+  enum class MessageEncoding
+  {
+    GeoMessage = 0,
+    Binary
+  };
+
   Message();
   Message(MessageAction messageAction, const Esri::ArcGISRuntime::Geometry& geometry);
   Message(const Message& other);
@@ -74,13 +83,23 @@ public:
 
   bool operator==(const Message& other) const;
 
-  static Message create(const QByteArray& message);
-  static Message createFromCoTMessage(const QByteArray& message);
-  static Message createFromGeoMessage(const QByteArray& message);
+  using MessageTypeFilter = std::function<bool(int messageTypeKey)>;
+
+  static Message create(const QByteArray& message, const MessageTypeFilter& acceptType = MessageTypeFilter());
+  static Message createFromCoTMessage(const QByteArray& message, const MessageTypeFilter& acceptType = MessageTypeFilter());
+  static Message createFromGeoMessage(const QByteArray& message, const MessageTypeFilter& acceptType = MessageTypeFilter());
+  static Message createFromBinaryMessage(const QByteArray& message, const MessageTypeFilter& acceptType = MessageTypeFilter());
+
+  static bool isBinaryMessage(const QByteArray& message);
+
+  static int internMessageType(const QString& messageType);
+  static int findMessageTypeKey(const QString& messageType);
+  static QString messageTypeFromKey(int messageTypeKey);
 
   static QString cotTypeToSidc(const QString& cotType);
   static MessageAction toMessageAction(const QString& action);
   static QString fromMessageAction(MessageAction action);
+  static MessageEncoding toMessageEncoding(const QString& encoding);
 
   bool isEmpty() const;
 
@@ -101,11 +120,14 @@ public:
 
   QString messageType() const;
   void setMessageType(const QString& messageType);
+  int messageTypeKey() const;
 
   QString symbolId() const;
   void setSymbolId(const QString& symbolId);
 
   QByteArray toGeoMessage() const;
+  QByteArray toBinaryMessage() const;
+  QByteArray encode(MessageEncoding encoding) const;
 
 private:
   QSharedDataPointer<MessageData> d;
@@ -125,6 +147,7 @@ public:
   QString messageId;
   QString messageName;
   QString messageType;
+  int messageTypeKey = -1;
   QString symbolId;
 };
 
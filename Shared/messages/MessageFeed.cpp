@@ -103,6 +103,8 @@ void MessageFeed::setFeedVisible(bool feedVisible)
   m_feedVisible = feedVisible;
 
   updateOverlay();
+
+  emit feedVisibleChanged();
 }
 
 /*!
@@ -150,4 +152,132 @@ void MessageFeed::setThumbnailUrl(const QUrl& thumbnailUrl)
   m_thumbnailUrl = thumbnailUrl;
 }
 
+/*!
+  \brief Returns the multicast group this feed is sent to, or a null
+  address if it is broadcast.
+ */
+QHostAddress MessageFeed::multicastGroup() const
+{
+  return m_multicastGroup;
+}
+
+/*!
+  \brief Sets the multicast group this feed is sent to to \a multicastGroup.
+
+  The group is only joined while the feed is visible.
+
+  \sa MessageFeedsController
+ */
+void MessageFeed::setMulticastGroup(const QHostAddress& multicastGroup)
+{
+  m_multicastGroup = multicastGroup;
+}
+
+/*!
+  \brief Returns the maximum age in seconds of a track in this feed
+  which has not been updated, or \c 0 if tracks never expire.
+ */
+int MessageFeed::maximumAge() const
+{
+  return m_messagesOverlay ? m_messagesOverlay->maximumAge() : 0;
+}
+
+/*!
+  \brief Sets the maximum age in seconds of a track in this feed which
+  has not been updated to \a maximumAge.
+ */
+void MessageFeed::setMaximumAge(int maximumAge)
+{
+  if (m_messagesOverlay)
+    m_messagesOverlay->setMaximumAge(maximumAge);
+}
+
+/*!
+  \brief Returns the minimum time in milliseconds between two updates
+  applied to the same track in this feed.
+ */
+int MessageFeed::minimumUpdateInterval() const
+{
+  return m_messagesOverlay ? m_messagesOverlay->minimumUpdateInterval() : 0;
+}
+
+/*!
+  \brief Sets the minimum time in milliseconds between two updates applied
+  to the same track in this feed to \a minimumUpdateInterval.
+ */
+void MessageFeed::setMinimumUpdateInterval(int minimumUpdateInterval)
+{
+  if (m_messagesOverlay)
+    m_messagesOverlay->setMinimumUpdateInterval(minimumUpdateInterval);
+}
+
+/*!
+  \brief Returns the number of recent positions shown in the trail of
+  each track in this feed, or \c 0 if no trails are shown.
+ */
+int MessageFeed::trailLength() const
+{
+  return m_messagesOverlay ? m_messagesOverlay->trailLength() : 0;
+}
+
+/*!
+  \brief Sets the number of recent positions shown in the trail of each
+  track in this feed to \a trailLength.
+ */
+void MessageFeed::setTrailLength(int trailLength)
+{
+  if (m_messagesOverlay)
+    m_messagesOverlay->setTrailLength(trailLength);
+}
+
+/*!
+  \brief Returns the scale beyond which the tracks of this feed are
+  clustered, or \c 0 if they are never clustered.
+ */
+double MessageFeed::clusterScale() const
+{
+  return m_messagesOverlay ? m_messagesOverlay->clusterScale() : 0.0;
+}
+
+/*!
+  \brief Sets the scale beyond which the tracks of this feed are
+  clustered to \a clusterScale.
+ */
+void MessageFeed::setClusterScale(double clusterScale)
+{
+  if (m_messagesOverlay)
+    m_messagesOverlay->setClusterScale(clusterScale);
+}
+
+/*!
+  \brief Returns the number of tracks currently shown for this feed.
+ */
+int MessageFeed::liveTrackCount() const
+{
+  return m_messagesOverlay ? m_messagesOverlay->liveCount() : 0;
+}
+
+/*!
+  \brief Returns the number of tracks of this feed which have expired.
+ */
+quint64 MessageFeed::expiredTrackCount() const
+{
+  return m_messagesOverlay ? m_messagesOverlay->expiredCount() : 0;
+}
+
+/*!
+  \brief Returns the number of updates to tracks of this feed which were
+  replaced by a newer update before being applied.
+ */
+quint64 MessageFeed::droppedUpdateCount() const
+{
+  return m_messagesOverlay ? m_messagesOverlay->droppedUpdateCount() : 0;
+}
+
+// Signal Documentation
+/*!
+  \fn void MessageFeed::feedVisibleChanged();
+  \brief Signal emitted when the visibility of this feed changes.
+ */
+
 } // Dsa
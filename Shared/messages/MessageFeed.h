@@ -18,6 +18,7 @@
 #define MESSAGEFEED_H
 
 // Qt headers
+#include <QHostAddress>
 #include <QObject>
 #include <QUrl>
 
@@ -49,6 +50,28 @@ public:
   QUrl thumbnailUrl() const;
   void setThumbnailUrl(const QUrl& thumbnailUrl);
 
+  QHostAddress multicastGroup() const;
+  void setMulticastGroup(const QHostAddress& multicastGroup);
+
+  int maximumAge() const;
+  void setMaximumAge(int maximumAge);
+
+  int minimumUpdateInterval() const;
+  void setMinimumUpdateInterval(int minimumUpdateInterval);
+
+  int trailLength() const;
+  void setTrailLength(int trailLength);
+
+  double clusterScale() const;
+  void setClusterScale(double clusterScale);
+
+  int liveTrackCount() const;
+  quint64 expiredTrackCount() const;
+  quint64 droppedUpdateCount() const;
+
+signals:
+  void feedVisibleChanged();
+
 private:
   Q_DISABLE_COPY(MessageFeed)
 
@@ -59,6 +82,7 @@ private:
   bool m_feedVisible = true;
   MessagesOverlay* m_messagesOverlay = nullptr;
   QUrl m_thumbnailUrl;
+  QHostAddress m_multicastGroup;
 };
 
 } // Dsa
@@ -23,15 +23,29 @@ namespace Dsa {
 
 const QString MessageFeedConstants::OBSERVATION_REPORT_CONFIG_PROPERTYNAME = QStringLiteral("ObservationReportConfig");
 const QString MessageFeedConstants::OBSERVATION_REPORT_CONFIG_PORT = QStringLiteral("port");
+const QString MessageFeedConstants::OBSERVATION_REPORT_CONFIG_ENCODING = QStringLiteral("encoding");
+const QString MessageFeedConstants::OBSERVATION_REPORT_CONFIG_MULTICAST_GROUP = QStringLiteral("multicastGroup");
 const QString MessageFeedConstants::LOCATION_BROADCAST_CONFIG_PROPERTYNAME = QStringLiteral("LocationBroadcastConfig");
 const QString MessageFeedConstants::LOCATION_BROADCAST_CONFIG_MESSAGE_TYPE = QStringLiteral("messageType");
 const QString MessageFeedConstants::LOCATION_BROADCAST_CONFIG_PORT = QStringLiteral("port");
+const QString MessageFeedConstants::LOCATION_BROADCAST_CONFIG_MINIMUM_INTERVAL = QStringLiteral("minimumInterval");
+const QString MessageFeedConstants::LOCATION_BROADCAST_CONFIG_DISTANCE_THRESHOLD = QStringLiteral("distanceThreshold");
+const QString MessageFeedConstants::LOCATION_BROADCAST_CONFIG_ENCODING = QStringLiteral("encoding");
 const QString MessageFeedConstants::MESSAGE_FEEDS_PROPERTYNAME = QStringLiteral("MessageFeeds");
 const QString MessageFeedConstants::MESSAGE_FEEDS_NAME = QStringLiteral("name");
 const QString MessageFeedConstants::MESSAGE_FEEDS_TYPE= QStringLiteral("type");
 const QString MessageFeedConstants::MESSAGE_FEEDS_RENDERER = QStringLiteral("renderer");
 const QString MessageFeedConstants::MESSAGE_FEEDS_THUMBNAIL = QStringLiteral("thumbnail");
 const QString MessageFeedConstants::MESSAGE_FEEDS_PLACEMENT = QStringLiteral("placement");
+const QString MessageFeedConstants::MESSAGE_FEEDS_MULTICAST_GROUP = QStringLiteral("multicastGroup");
+const QString MessageFeedConstants::MESSAGE_FEEDS_MAX_AGE = QStringLiteral("maxAge");
+const QString MessageFeedConstants::MESSAGE_FEEDS_MINIMUM_UPDATE_INTERVAL = QStringLiteral("minimumUpdateInterval");
+const QString MessageFeedConstants::MESSAGE_FEEDS_TRAIL_LENGTH = QStringLiteral("trailLength");
+const QString MessageFeedConstants::MESSAGE_FEEDS_CLUSTER_SCALE = QStringLiteral("clusterScale");
+const QString MessageFeedConstants::MESSAGE_FEEDS_SYMBOL_CACHE = QStringLiteral("symbolCache");
+const QString MessageFeedConstants::MESSAGE_FEEDS_PREWARM_SYMBOLS = QStringLiteral("prewarmSymbols");
 const QString MessageFeedConstants::MESSAGE_FEED_UDP_PORTS_PROPERTYNAME = QStringLiteral("MessageFeedUdpPorts");
+const QString MessageFeedConstants::MESSAGE_FEED_CAPTURE_FILE_PROPERTYNAME = QStringLiteral("MessageFeedCaptureFile");
+const QString MessageFeedConstants::MESSAGE_FEED_STATISTICS_INTERVAL_PROPERTYNAME = QStringLiteral("MessageFeedStatisticsInterval");
 
 } // Dsa
@@ -29,16 +29,30 @@ class MessageFeedConstants
 public:
   static const QString OBSERVATION_REPORT_CONFIG_PROPERTYNAME;
   static const QString OBSERVATION_REPORT_CONFIG_PORT;
+  static const QString OBSERVATION_REPORT_CONFIG_ENCODING;
+  static const QString OBSERVATION_REPORT_CONFIG_MULTICAST_GROUP;
   static const QString LOCATION_BROADCAST_CONFIG_PROPERTYNAME;
   static const QString LOCATION_BROADCAST_CONFIG_MESSAGE_TYPE;
   static const QString LOCATION_BROADCAST_CONFIG_PORT;
+  static const QString LOCATION_BROADCAST_CONFIG_MINIMUM_INTERVAL;
+  static const QString LOCATION_BROADCAST_CONFIG_DISTANCE_THRESHOLD;
+  static const QString LOCATION_BROADCAST_CONFIG_ENCODING;
   static const QString MESSAGE_FEEDS_PROPERTYNAME;
   static const QString MESSAGE_FEEDS_NAME;
   static const QString MESSAGE_FEEDS_TYPE;
   static const QString MESSAGE_FEEDS_RENDERER;
   static const QString MESSAGE_FEEDS_THUMBNAIL;
   static const QString MESSAGE_FEEDS_PLACEMENT;
+  static const QString MESSAGE_FEEDS_MULTICAST_GROUP;
+  static const QString MESSAGE_FEEDS_MAX_AGE;
+  static const QString MESSAGE_FEEDS_MINIMUM_UPDATE_INTERVAL;
+  static const QString MESSAGE_FEEDS_TRAIL_LENGTH;
+  static const QString MESSAGE_FEEDS_CLUSTER_SCALE;
+  static const QString MESSAGE_FEEDS_SYMBOL_CACHE;
+  static const QString MESSAGE_FEEDS_PREWARM_SYMBOLS;
   static const QString MESSAGE_FEED_UDP_PORTS_PROPERTYNAME;
+  static const QString MESSAGE_FEED_CAPTURE_FILE_PROPERTYNAME;
+  static const QString MESSAGE_FEED_STATISTICS_INTERVAL_PROPERTYNAME;
 };
 
 } // Dsa
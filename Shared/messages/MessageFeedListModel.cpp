@@ -20,6 +20,7 @@
 #include "MessageFeedListModel.h"
 
 // example app headers
+#include "Message.h"
 #include "MessageFeed.h"
 
 namespace Dsa {
@@ -76,6 +77,22 @@ void MessageFeedListModel::setupRoles()
   m_roles[MessageFeedThumbnailUrlRole] = "thumbnailUrl";
 }
 
+/*!
+  \internal
+
+  Re-indexes the feeds by message type, keeping the first feed of each type.
+ */
+void MessageFeedListModel::rebuildTypeIndex()
+{
+  m_messageFeedsByTypeKey.clear();
+  for (MessageFeed* messageFeed : qAsConst(m_messageFeeds))
+  {
+    const int typeKey = Message::internMessageType(messageFeed->feedMessageType());
+    if (!m_messageFeedsByTypeKey.contains(typeKey))
+      m_messageFeedsByTypeKey.insert(typeKey, messageFeed);
+  }
+}
+
 /*!
   \brief Returns whether the model is empty.
  */
@@ -93,8 +110,12 @@ void MessageFeedListModel::append(MessageFeed* messageFeed)
     return;
 
   beginInsertRows(QModelIndex(), rowCount(), rowCount());
-  m_messageTypes.append(messageFeed->feedMessageType());
   m_messageFeeds.append(messageFeed);
+
+  // the first feed of a type receives its messages
+  const int typeKey = Message::internMessageType(messageFeed->feedMessageType());
+  if (!m_messageFeedsByTypeKey.contains(typeKey))
+    m_messageFeedsByTypeKey.insert(typeKey, messageFeed);
   endInsertRows();
 }
 
@@ -116,11 +137,19 @@ MessageFeed* MessageFeedListModel::at(int index) const
  */
 MessageFeed* MessageFeedListModel::messageFeedByType(const QString& type) const
 {
-  int index = m_messageTypes.indexOf(type);
-  if (index == -1)
-    return nullptr;
+  return messageFeedByTypeKey(Message::findMessageTypeKey(type));
+}
+
+/*!
+  \brief Returns a \l MessageFeed for the interned message \a typeKey if one is found.
 
-  return m_messageFeeds[index];
+  If no feed of the supplied type is found, returns \c nullptr.
+
+  \sa Message::messageTypeKey
+ */
+MessageFeed* MessageFeedListModel::messageFeedByTypeKey(int typeKey) const
+{
+  return m_messageFeedsByTypeKey.value(typeKey, nullptr);
 }
 
 /*!
@@ -129,8 +158,8 @@ MessageFeed* MessageFeedListModel::messageFeedByType(const QString& type) const
 void MessageFeedListModel::clear()
 {
   beginResetModel();
-  m_messageTypes.clear();
   m_messageFeeds.clear();
+  m_messageFeedsByTypeKey.clear();
   endResetModel();
 }
 
@@ -216,6 +245,7 @@ bool MessageFeedListModel::setData(const QModelIndex& index, const QVariant& val
     if (messageFeed->feedMessageType() != val)
     {
       messageFeed->setFeedMessageType(val);
+      rebuildTypeIndex();
 
       isDataChanged = true;
     }
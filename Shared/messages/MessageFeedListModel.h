@@ -47,6 +47,7 @@ public:
   MessageFeed* at(int index) const;
 
   MessageFeed* messageFeedByType(const QString& type) const;
+  MessageFeed* messageFeedByTypeKey(int typeKey) const;
 
   void clear();
 
@@ -64,10 +65,11 @@ private:
   Q_DISABLE_COPY(MessageFeedListModel)
 
   void setupRoles();
+  void rebuildTypeIndex();
 
   QHash<int, QByteArray> m_roles;
-  QStringList m_messageTypes;
   QList<MessageFeed*> m_messageFeeds;
+  QHash<int, MessageFeed*> m_messageFeedsByTypeKey;
 };
 
 } // Dsa
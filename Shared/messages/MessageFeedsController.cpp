@@ -21,7 +21,9 @@
 #include "MessageFeedsController.h"
 
 // example app headers
+#include "AlertEvaluator.h"
 #include "AppConstants.h"
+#include "DataCapture.h"
 #include "DataListener.h"
 #include "DataSender.h"
 #include "LocationBroadcast.h"
@@ -29,7 +31,9 @@
 #include "MessageFeed.h"
 #include "MessageFeedConstants.h"
 #include "MessageFeedListModel.h"
+#include "MessageSymbolCache.h"
 #include "MessagesOverlay.h"
+#include "MessagesPickIndex.h"
 
 // toolkit headers
 #include "ToolManager.h"
@@ -42,21 +46,50 @@
 #include "SimpleRenderer.h"
 
 // Qt headers
+#include <QDebug>
+#include <QElapsedTimer>
 #include <QFileInfo>
 #include <QJsonArray>
+#include <QSet>
+#include <QTimer>
 #include <QUdpSocket>
 
+// STL headers
+#include <algorithm>
+
 using namespace Esri::ArcGISRuntime;
 
 namespace Dsa {
 
+// the UDP socket a data listener reads from, if any
+static QUdpSocket* listenerSocket(DataListener* dataListener)
+{
+  return dataListener ? qobject_cast<QUdpSocket*>(dataListener->device()) : nullptr;
+}
+
 const QString MessageFeedsController::RESOURCE_DIRECTORY_PROPERTYNAME = "ResourceDirectory";
 
+// identical datagrams received within this many milliseconds are dropped
+static const qint64 s_duplicateWindow = 1000;
+
 /*!
   \class Dsa::MessageFeedsController
   \inmodule Dsa
   \inherits Toolkit::AbstractTool
   \brief Tool controller for working with the list of message feeds.
+
+  Chatty sources often resend identical messages, and the same broadcast
+  can arrive on more than one port. A datagram whose content is identical
+  to one accepted within the last second is dropped before it is parsed.
+
+  A feed may be sent to a multicast group instead of being broadcast. The
+  group is joined on every data listener's socket only while a visible feed
+  uses it, so hidden feeds are filtered out by the network interface rather
+  than received and skipped.
+
+  The ingest counters (such as \l messagesReceivedCount and \l averageRoutingCost)
+  are exposed as properties. While \l statisticsInterval is set, they are
+  reported every interval through \l statisticsChanged and the debug log.
  */
 
 /*!
@@ -65,8 +98,14 @@ const QString MessageFeedsController::RESOURCE_DIRECTORY_PROPERTYNAME = "Resourc
 MessageFeedsController::MessageFeedsController(QObject* parent) :
   Toolkit::AbstractTool(parent),
   m_messageFeeds(new MessageFeedListModel(this)),
-  m_locationBroadcast(new LocationBroadcast(this))
+  m_locationBroadcast(new LocationBroadcast(this)),
+  m_dataCapture(new DataCapture(this)),
+  m_statisticsTimer(new QTimer(this))
 {
+  m_ingestClock.start();
+
+  connect(m_statisticsTimer, &QTimer::timeout, this, &MessageFeedsController::reportStatistics);
+
   connect(Toolkit::ToolResourceProvider::instance(), &Toolkit::ToolResourceProvider::geoViewChanged, this, [this]
   {
     setGeoView(Toolkit::ToolResourceProvider::instance()->geoView());
@@ -126,24 +165,305 @@ void MessageFeedsController::addDataListener(DataListener* dataListener)
 
   m_dataListeners.append(dataListener);
 
-  connect(dataListener, &DataListener::dataReceived, this, [this](const QByteArray& data)
+  // record the datagram as received, before any of it is filtered
+  connect(dataListener, &DataListener::dataReceived, this, [this, dataListener](const QByteArray& data)
   {
-    Message m = Message::create(data);
-    if (m.isEmpty())
+    if (!m_dataCapture->isCapturing())
       return;
 
-    if (m_locationBroadcast->isEnabled())
+    QUdpSocket* udpSocket = listenerSocket(dataListener);
+    m_dataCapture->capture(data, udpSocket ? udpSocket->localPort() : 0);
+  });
+
+  connect(dataListener, &DataListener::dataReceived, this, &MessageFeedsController::routeMessage);
+
+  QUdpSocket* udpSocket = listenerSocket(dataListener);
+  if (udpSocket)
+  {
+    for (const QHostAddress& group : m_multicastGroups)
+      udpSocket->joinMulticastGroup(group);
+  }
+}
+
+/*!
+  \internal
+
+  Parses \a data and adds the message to the overlay of its feed.
+
+  Messages for unknown or hidden feeds are skipped as soon as their type
+  is parsed, before their geometry is built. The time spent parsing and
+  routing each message is accumulated in \l routingElapsed.
+ */
+void MessageFeedsController::routeMessage(const QByteArray& data)
+{
+  QElapsedTimer routingTimer;
+  routingTimer.start();
+  ++m_messagesReceivedCount;
+  m_bytesReceivedCount += static_cast<quint64>(data.size());
+  if (Message::isBinaryMessage(data))
+    ++m_binaryMessagesReceivedCount;
+
+  // our own location broadcast echoes back to us, so drop it before anything is parsed
+  if (m_locationBroadcast->isOwnData(data))
+  {
+    ++m_ownMessagesDiscardedCount;
+    m_routingElapsed += routingTimer.nsecsElapsed();
+    return;
+  }
+
+  if (isDuplicate(data))
+  {
+    ++m_duplicatesDroppedCount;
+    m_routingElapsed += routingTimer.nsecsElapsed();
+    return;
+  }
+
+  MessageFeed* messageFeed = nullptr;
+  bool skipped = false;
+  Message m = Message::create(data, [this, &messageFeed, &skipped](int messageTypeKey)
+  {
+    messageFeed = m_messageFeeds->messageFeedByTypeKey(messageTypeKey);
+    skipped = !messageFeed || !messageFeed->isFeedVisible();
+    return !skipped;
+  });
+
+  // do not display our own location broadcast message, should an echo no longer match the sent bytes
+  if (!m.isEmpty() && m_locationBroadcast->isEnabled() &&
+      m_locationBroadcast->message().messageId() == m.messageId())
+  {
+    skipped = true;
+  }
+
+  m_routingElapsed += routingTimer.nsecsElapsed();
+
+  if (skipped)
+  {
+    ++m_messagesSkippedCount;
+    return;
+  }
+
+  if (m.isEmpty() || !messageFeed)
+    return;
+
+  ++m_messagesRoutedCount;
+  messageFeed->messagesOverlay()->addMessage(m);
+}
+
+/*!
+  \internal
+
+  Returns whether a datagram with the same content as \a data was accepted
+  within the duplicate window, and otherwise records \a data as accepted.
+
+  The window is measured from the first accepted copy, so a source which
+  keeps resending the same content still gets one copy through per window.
+ */
+bool MessageFeedsController::isDuplicate(const QByteArray& data)
+{
+  const qint64 now = m_ingestClock.elapsed();
+
+  // forget datagrams which are outside the window, at most once per window
+  if (now - m_lastDatagramPurge > s_duplicateWindow)
+  {
+    for (auto it = m_recentDatagrams.begin(); it != m_recentDatagrams.end();)
     {
-      if (m_locationBroadcast->message().messageId() == m.messageId()) // do not display our own location broadcast message
-        return;
+      if (now - it.value() > s_duplicateWindow)
+        it = m_recentDatagrams.erase(it);
+      else
+        ++it;
     }
 
-    MessageFeed* messageFeed = m_messageFeeds->messageFeedByType(m.messageType());
-    if (!messageFeed)
-      return;
+    m_lastDatagramPurge = now;
+  }
 
-    messageFeed->messagesOverlay()->addMessage(m);
-  });
+  // the content hash combined with the length is a cheap key for identical datagrams
+  const quint64 key = (static_cast<quint64>(qHash(data)) << 32) | static_cast<quint32>(data.size());
+
+  auto findIt = m_recentDatagrams.find(key);
+  if (findIt != m_recentDatagrams.end() && now - findIt.value() <= s_duplicateWindow)
+    return true;
+
+  m_recentDatagrams.insert(key, now);
+  return false;
+}
+
+/*!
+  \property MessageFeedsController::messagesReceivedCount
+  \brief Returns the number of messages received from the data listeners.
+ */
+quint64 MessageFeedsController::messagesReceivedCount() const
+{
+  return m_messagesReceivedCount;
+}
+
+/*!
+  \property MessageFeedsController::messagesRoutedCount
+  \brief Returns the number of messages added to the overlay of a feed.
+ */
+quint64 MessageFeedsController::messagesRoutedCount() const
+{
+  return m_messagesRoutedCount;
+}
+
+/*!
+  \property MessageFeedsController::messagesSkippedCount
+  \brief Returns the number of messages skipped because their feed is
+  unknown or hidden, or because they are our own location broadcast.
+ */
+quint64 MessageFeedsController::messagesSkippedCount() const
+{
+  return m_messagesSkippedCount;
+}
+
+/*!
+  \property MessageFeedsController::duplicatesDroppedCount
+  \brief Returns the number of datagrams dropped because identical content
+  was received within the last second.
+ */
+quint64 MessageFeedsController::duplicatesDroppedCount() const
+{
+  return m_duplicatesDroppedCount;
+}
+
+/*!
+  \property MessageFeedsController::ownMessagesDiscardedCount
+  \brief Returns the number of datagrams discarded before parsing because
+  they were sent by our own location broadcast.
+ */
+quint64 MessageFeedsController::ownMessagesDiscardedCount() const
+{
+  return m_ownMessagesDiscardedCount;
+}
+
+/*!
+  \property MessageFeedsController::bytesReceivedCount
+  \brief Returns the total size in bytes of the messages received from the
+  data listeners.
+
+  Together with \l messagesReceivedCount and \l averageRoutingCost, this
+  compares the size and parse cost of the message encodings in use.
+ */
+quint64 MessageFeedsController::bytesReceivedCount() const
+{
+  return m_bytesReceivedCount;
+}
+
+/*!
+  \property MessageFeedsController::binaryMessagesReceivedCount
+  \brief Returns the number of received messages which use the compact
+  binary encoding.
+
+  \sa Message::toBinaryMessage
+ */
+quint64 MessageFeedsController::binaryMessagesReceivedCount() const
+{
+  return m_binaryMessagesReceivedCount;
+}
+
+/*!
+  \brief Returns the total time in nanoseconds spent parsing and routing
+  received messages.
+
+  Time spent updating the overlays is not included.
+ */
+qint64 MessageFeedsController::routingElapsed() const
+{
+  return m_routingElapsed;
+}
+
+/*!
+  \property MessageFeedsController::averageRoutingCost
+  \brief Returns the average time in nanoseconds spent parsing and
+  routing a received message.
+ */
+qint64 MessageFeedsController::averageRoutingCost() const
+{
+  return m_messagesReceivedCount == 0 ? 0 : m_routingElapsed / static_cast<qint64>(m_messagesReceivedCount);
+}
+
+/*!
+  \property MessageFeedsController::statisticsInterval
+  \brief The interval in seconds at which the ingest counters are reported.
+
+  \c 0 (the default) stops the reports.
+ */
+int MessageFeedsController::statisticsInterval() const
+{
+  return m_statisticsTimer->isActive() ? m_statisticsTimer->interval() / 1000 : 0;
+}
+
+void MessageFeedsController::setStatisticsInterval(int statisticsInterval)
+{
+  statisticsInterval = std::max(0, statisticsInterval);
+  if (statisticsInterval == this->statisticsInterval())
+    return;
+
+  if (statisticsInterval > 0)
+    m_statisticsTimer->start(statisticsInterval * 1000);
+  else
+    m_statisticsTimer->stop();
+
+  emit statisticsIntervalChanged();
+}
+
+/*!
+  \internal
+
+  Notifies and logs the current values of the ingest counters, and logs the
+  track counts of each feed, the hit rate of each symbol cache in use, the activity
+  of the pick index and the throughput of the alert evaluator.
+ */
+void MessageFeedsController::reportStatistics()
+{
+  emit statisticsChanged();
+
+  qDebug() << "Message feeds:"
+           << "received" << m_messagesReceivedCount
+           << "routed" << m_messagesRoutedCount
+           << "skipped" << m_messagesSkippedCount
+           << "duplicates" << m_duplicatesDroppedCount
+           << "own" << m_ownMessagesDiscardedCount
+           << "bytes" << m_bytesReceivedCount
+           << "binary" << m_binaryMessagesReceivedCount
+           << "average routing cost (ns)" << averageRoutingCost();
+
+  // feeds rendered with the same dictionary style share one symbol cache
+  QSet<MessageSymbolCache*> symbolCaches;
+  for (int i = 0; i < m_messageFeeds->rowCount(); ++i)
+  {
+    const MessageFeed* feed = m_messageFeeds->at(i);
+    if (feed)
+    {
+      qDebug() << "Message feed:" << feed->feedName()
+               << "live tracks" << feed->liveTrackCount()
+               << "expired tracks" << feed->expiredTrackCount()
+               << "dropped updates" << feed->droppedUpdateCount();
+    }
+
+    MessageSymbolCache* symbolCache = feed && feed->messagesOverlay() ? feed->messagesOverlay()->symbolCache() : nullptr;
+    if (!symbolCache || symbolCaches.contains(symbolCache))
+      continue;
+
+    symbolCaches.insert(symbolCache);
+    qDebug() << "Message symbol cache:"
+             << "symbols" << symbolCache->size()
+             << "hits" << symbolCache->hitCount()
+             << "misses" << symbolCache->missCount()
+             << "hit rate" << symbolCache->hitRate();
+  }
+
+  const MessagesPickIndex* pickIndex = MessagesPickIndex::instance();
+  qDebug() << "Message pick index:"
+           << "picks" << pickIndex->pickCount()
+           << "rebuilds" << pickIndex->rebuildCount();
+
+  const AlertEvaluator* alertEvaluator = AlertEvaluator::instance();
+  qDebug() << "Alert evaluator:"
+           << "workers" << alertEvaluator->workerCount()
+           << "evaluations" << alertEvaluator->evaluationCount()
+           << "evaluations per second" << alertEvaluator->evaluationsPerSecond()
+           << "last batch" << alertEvaluator->lastBatchSize()
+           << "last batch (ms)" << alertEvaluator->lastBatchElapsed();
 }
 
 /*!
@@ -161,6 +481,98 @@ void MessageFeedsController::removeDataListener(DataListener* dataListener)
   m_dataListeners.removeOne(dataListener);
 
   disconnect(dataListener, &DataListener::dataReceived, this, nullptr);
+
+  QUdpSocket* udpSocket = listenerSocket(dataListener);
+  if (udpSocket)
+  {
+    for (const QHostAddress& group : m_multicastGroups)
+      udpSocket->leaveMulticastGroup(group);
+  }
+}
+
+/*!
+  \brief Starts recording every datagram received by the data listeners,
+  with its arrival time and port, to the file at \a filePath.
+
+  Returns \c false if the file could not be opened. The capture can be
+  replayed with the message simulator to apply the same load again.
+
+  \sa DataCapture
+ */
+bool MessageFeedsController::startCapture(const QString& filePath)
+{
+  return m_dataCapture->start(filePath);
+}
+
+/*!
+  \brief Stops recording received datagrams.
+ */
+void MessageFeedsController::stopCapture()
+{
+  m_dataCapture->stop();
+}
+
+/*!
+  \brief Returns whether received datagrams are being recorded.
+ */
+bool MessageFeedsController::isCapturing() const
+{
+  return m_dataCapture->isCapturing();
+}
+
+/*!
+  \brief Returns the multicast groups currently joined by the data listeners.
+
+  \sa MessageFeed::multicastGroup
+ */
+QList<QHostAddress> MessageFeedsController::multicastGroups() const
+{
+  return m_multicastGroups;
+}
+
+/*!
+  \internal
+
+  Joins the multicast groups of the visible feeds on every data listener's
+  socket and leaves the groups which no visible feed uses any more.
+
+  The location broadcast is sent to the group of the feed it appears in,
+  whether or not that feed is shown here.
+ */
+void MessageFeedsController::updateMulticastGroups()
+{
+  QList<QHostAddress> groups;
+  for (int i = 0; i < m_messageFeeds->rowCount(); ++i)
+  {
+    const MessageFeed* feed = m_messageFeeds->at(i);
+    const QHostAddress group = feed->multicastGroup();
+    if (!group.isNull() && feed->isFeedVisible() && !groups.contains(group))
+      groups.append(group);
+  }
+
+  for (DataListener* dataListener : m_dataListeners)
+  {
+    QUdpSocket* udpSocket = listenerSocket(dataListener);
+    if (!udpSocket)
+      continue;
+
+    for (const QHostAddress& group : m_multicastGroups)
+    {
+      if (!groups.contains(group))
+        udpSocket->leaveMulticastGroup(group);
+    }
+
+    for (const QHostAddress& group : groups)
+    {
+      if (!m_multicastGroups.contains(group))
+        udpSocket->joinMulticastGroup(group);
+    }
+  }
+
+  m_multicastGroups = groups;
+
+  const MessageFeed* broadcastFeed = m_messageFeeds->messageFeedByType(m_locationBroadcast->messageType());
+  m_locationBroadcast->setMulticastGroup(broadcastFeed ? broadcastFeed->multicastGroup() : QHostAddress());
 }
 
 /*!
@@ -194,6 +606,50 @@ void MessageFeedsController::setupFeeds()
     MessagesOverlay* overlay = new MessagesOverlay(m_geoView, createRenderer(rendererInfo, this), feedType, toSurfacePlacement(surfacePlacement), this);
     MessageFeed* feed = new MessageFeed(feedName, feedType, overlay, this);
 
+    // tracks which are not updated within the optional maximum age (in seconds) are removed
+    if (messageFeedJsonObject.contains(MessageFeedConstants::MESSAGE_FEEDS_MAX_AGE))
+      feed->setMaximumAge(messageFeedJsonObject[MessageFeedConstants::MESSAGE_FEEDS_MAX_AGE].toInt());
+
+    // updates to a track arriving within the optional minimum interval (in milliseconds) are coalesced
+    if (messageFeedJsonObject.contains(MessageFeedConstants::MESSAGE_FEEDS_MINIMUM_UPDATE_INTERVAL))
+      feed->setMinimumUpdateInterval(messageFeedJsonObject[MessageFeedConstants::MESSAGE_FEEDS_MINIMUM_UPDATE_INTERVAL].toInt());
+
+    // the optional trail length is the number of recent positions drawn behind each track
+    if (messageFeedJsonObject.contains(MessageFeedConstants::MESSAGE_FEEDS_TRAIL_LENGTH))
+      feed->setTrailLength(messageFeedJsonObject[MessageFeedConstants::MESSAGE_FEEDS_TRAIL_LENGTH].toInt());
+
+    // the optional multicast group is only joined while the feed is visible
+    if (messageFeedJsonObject.contains(MessageFeedConstants::MESSAGE_FEEDS_MULTICAST_GROUP))
+    {
+      const QString multicastGroup = messageFeedJsonObject[MessageFeedConstants::MESSAGE_FEEDS_MULTICAST_GROUP].toString();
+      const QHostAddress groupAddress(multicastGroup);
+      if (groupAddress.isMulticast())
+        feed->setMulticastGroup(groupAddress);
+      else
+        emit toolErrorOccurred(QStringLiteral("Invalid multicast group"), QString("%1 is not a multicast address for feed %2").arg(multicastGroup, feedName));
+    }
+
+    connect(feed, &MessageFeed::feedVisibleChanged, this, &MessageFeedsController::updateMulticastGroups);
+
+    // dense feeds may be drawn as clusters when zoomed out beyond the optional cluster scale
+    if (messageFeedJsonObject.contains(MessageFeedConstants::MESSAGE_FEEDS_CLUSTER_SCALE))
+      feed->setClusterScale(messageFeedJsonObject[MessageFeedConstants::MESSAGE_FEEDS_CLUSTER_SCALE].toDouble());
+
+    // dictionary symbols may be resolved once per SIDC and shared between the graphics
+    if (messageFeedJsonObject[MessageFeedConstants::MESSAGE_FEEDS_SYMBOL_CACHE].toBool())
+    {
+      DictionaryRenderer* dictionaryRenderer = dynamic_cast<DictionaryRenderer*>(overlay->renderer());
+      MessageSymbolCache* symbolCache = dictionaryRenderer ? MessageSymbolCache::forStyle(dictionaryRenderer->dictionarySymbolStyle()) : nullptr;
+      if (symbolCache)
+      {
+        symbolCache->prewarm(messageFeedJsonObject[MessageFeedConstants::MESSAGE_FEEDS_PREWARM_SYMBOLS].toVariant().toStringList());
+        overlay->setSymbolCache(symbolCache);
+      }
+    }
+
+    // the point graphics of the feed can be picked without an identify task
+    MessagesPickIndex::instance()->addOverlay(overlay);
+
     if (!rendererThumbnail.isEmpty())
     {
       if (QFile::exists(QString(":/Resources/icons/xhdpi/message/%1").arg(rendererThumbnail)))
@@ -207,6 +663,8 @@ void MessageFeedsController::setupFeeds()
     m_messageFeeds->append(feed);
   }
 
+  updateMulticastGroups();
+
   // only needs to be cached until the geoView is ready
   m_messageFeedProperties.clear();
 }
@@ -218,8 +676,20 @@ void MessageFeedsController::setupFeeds()
   \list
     \li \c ResourceDirectory - The resource directory where symbol style files are located.
     \li \c MessageFeedUdpPorts - The UDP ports for listening to message feeds.
-    \li \c MessageFeeds - A list of message feed configurations.
-    \li \c LocationBroadcastConfig - The location broadcast configuration details.
+    \li \c MessageFeedCaptureFile - An optional file to record the received datagrams to,
+    conventionally with the \c .dsacap extension.
+    \li \c MessageFeedStatisticsInterval - An optional interval in seconds at which
+    the ingest counters are logged (see \l statisticsInterval).
+    \li \c MessageFeeds - A list of message feed configurations. Each feed may set
+    a \c maxAge in seconds after which tracks which have not been updated are removed,
+    a \c minimumUpdateInterval in milliseconds below which updates to a track are coalesced,
+    a \c trailLength for the number of recent positions drawn behind each track,
+    a \c multicastGroup which is joined only while the feed is visible,
+    a \c clusterScale beyond which the tracks are drawn as clusters, and
+    \c symbolCache to share one symbol per SIDC between the tracks of a dictionary
+    rendered feed, with the SIDCs listed in \c prewarmSymbols resolved up front.
+    \li \c LocationBroadcastConfig - The location broadcast configuration details, including
+    an optional message \c encoding of \c "geomessage" (the default) or \c "binary".
     \li \c UserName - the name of the user to be broadcast.
   \endlist
  */
@@ -239,13 +709,23 @@ void MessageFeedsController::setProperties(const QVariantMap& properties)
     const auto messageFeedUdpPorts = properties[MessageFeedConstants::MESSAGE_FEED_UDP_PORTS_PROPERTYNAME].toStringList();
     for (const auto& udpPort : messageFeedUdpPorts)
     {
+      // bind to IPv4 explicitly so that IPv4 multicast groups can be joined on every platform
       QUdpSocket* udpSocket = new QUdpSocket(this);
-      udpSocket->bind(udpPort.toInt(), QUdpSocket::DontShareAddress | QUdpSocket::ReuseAddressHint);
+      udpSocket->bind(QHostAddress::AnyIPv4, udpPort.toInt(), QUdpSocket::DontShareAddress | QUdpSocket::ReuseAddressHint);
 
       addDataListener(new DataListener(udpSocket, this));
     }
+
+    // optionally record the received traffic so that it can be replayed
+    const QString captureFile = properties[MessageFeedConstants::MESSAGE_FEED_CAPTURE_FILE_PROPERTYNAME].toString();
+    if (!captureFile.isEmpty() && !startCapture(captureFile))
+      emit toolErrorOccurred(QStringLiteral("Failed to start message capture"), QString("Could not open %1 for writing").arg(captureFile));
   }
 
+  auto statisticsIntervalFindIt = properties.find(MessageFeedConstants::MESSAGE_FEED_STATISTICS_INTERVAL_PROPERTYNAME);
+  if (statisticsIntervalFindIt != properties.end())
+    setStatisticsInterval(statisticsIntervalFindIt.value().toInt());
+
   // only setup message feeds at startup
   if (m_geoView && m_messageFeeds->rowCount() == 0)
   {
@@ -253,12 +733,24 @@ void MessageFeedsController::setProperties(const QVariantMap& properties)
   }
 
   const auto locationBroadcastConfig = properties[MessageFeedConstants::LOCATION_BROADCAST_CONFIG_PROPERTYNAME].toMap();
+  if (locationBroadcastConfig.contains(MessageFeedConstants::LOCATION_BROADCAST_CONFIG_MINIMUM_INTERVAL))
+    m_locationBroadcast->setMinimumInterval(locationBroadcastConfig.value(MessageFeedConstants::LOCATION_BROADCAST_CONFIG_MINIMUM_INTERVAL).toInt());
+
+  if (locationBroadcastConfig.contains(MessageFeedConstants::LOCATION_BROADCAST_CONFIG_DISTANCE_THRESHOLD))
+    m_locationBroadcast->setDistanceThreshold(locationBroadcastConfig.value(MessageFeedConstants::LOCATION_BROADCAST_CONFIG_DISTANCE_THRESHOLD).toDouble());
+
+  if (locationBroadcastConfig.contains(MessageFeedConstants::LOCATION_BROADCAST_CONFIG_ENCODING))
+    m_locationBroadcast->setMessageEncoding(Message::toMessageEncoding(locationBroadcastConfig.value(MessageFeedConstants::LOCATION_BROADCAST_CONFIG_ENCODING).toString()));
+
   if (locationBroadcastConfig.contains(MessageFeedConstants::LOCATION_BROADCAST_CONFIG_MESSAGE_TYPE) &&
       locationBroadcastConfig.contains(MessageFeedConstants::LOCATION_BROADCAST_CONFIG_PORT))
   {
     m_locationBroadcast->setMessageType(locationBroadcastConfig.value(MessageFeedConstants::LOCATION_BROADCAST_CONFIG_MESSAGE_TYPE).toString());
     m_locationBroadcast->setUdpPort(locationBroadcastConfig.value(MessageFeedConstants::LOCATION_BROADCAST_CONFIG_PORT).toInt());
   }
+
+  // the location broadcast follows the multicast group of its feed
+  updateMulticastGroups();
 }
 
 /*!
@@ -467,6 +959,16 @@ Renderer* MessageFeedsController::createRenderer(const QString& rendererInfo, QO
   \brief Signal emitted when the \l locationBroadcastInDistress property changes.
  */
 
+/*!
+  \fn void MessageFeedsController::statisticsChanged();
+  \brief Signal emitted every \l statisticsInterval seconds with the current ingest counters.
+ */
+
+/*!
+  \fn void MessageFeedsController::statisticsIntervalChanged();
+  \brief Signal emitted when the \l statisticsInterval property changes.
+ */
+
 } // Dsa
 
 /*!
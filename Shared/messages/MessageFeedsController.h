@@ -22,8 +22,13 @@
 
 // Qt headers
 #include <QAbstractListModel>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QHostAddress>
 #include <QVariantList>
 
+class QTimer;
+
 namespace Esri {
   namespace ArcGISRuntime {
     class GeoView;
@@ -34,6 +39,7 @@ namespace Esri {
 
 namespace Dsa {
 
+class DataCapture;
 class DataListener;
 
 class LocationBroadcast;
@@ -48,6 +54,15 @@ class MessageFeedsController : public Esri::ArcGISRuntime::Toolkit::AbstractTool
   Q_PROPERTY(bool locationBroadcastEnabled READ isLocationBroadcastEnabled WRITE setLocationBroadcastEnabled NOTIFY locationBroadcastEnabledChanged)
   Q_PROPERTY(int locationBroadcastFrequency READ locationBroadcastFrequency WRITE setLocationBroadcastFrequency NOTIFY locationBroadcastFrequencyChanged)
   Q_PROPERTY(bool locationBroadcastInDistress READ isLocationBroadcastInDistress WRITE setLocationBroadcastInDistress NOTIFY locationBroadcastInDistressChanged)
+  Q_PROPERTY(quint64 messagesReceivedCount READ messagesReceivedCount NOTIFY statisticsChanged)
+  Q_PROPERTY(quint64 messagesRoutedCount READ messagesRoutedCount NOTIFY statisticsChanged)
+  Q_PROPERTY(quint64 messagesSkippedCount READ messagesSkippedCount NOTIFY statisticsChanged)
+  Q_PROPERTY(quint64 duplicatesDroppedCount READ duplicatesDroppedCount NOTIFY statisticsChanged)
+  Q_PROPERTY(quint64 ownMessagesDiscardedCount READ ownMessagesDiscardedCount NOTIFY statisticsChanged)
+  Q_PROPERTY(quint64 bytesReceivedCount READ bytesReceivedCount NOTIFY statisticsChanged)
+  Q_PROPERTY(quint64 binaryMessagesReceivedCount READ binaryMessagesReceivedCount NOTIFY statisticsChanged)
+  Q_PROPERTY(qint64 averageRoutingCost READ averageRoutingCost NOTIFY statisticsChanged)
+  Q_PROPERTY(int statisticsInterval READ statisticsInterval WRITE setStatisticsInterval NOTIFY statisticsIntervalChanged)
 
 public:
   static const QString RESOURCE_DIRECTORY_PROPERTYNAME;
@@ -63,6 +78,12 @@ public:
   void addDataListener(DataListener* dataListener);
   void removeDataListener(DataListener* dataListener);
 
+  QList<QHostAddress> multicastGroups() const;
+
+  Q_INVOKABLE bool startCapture(const QString& filePath);
+  Q_INVOKABLE void stopCapture();
+  Q_INVOKABLE bool isCapturing() const;
+
   QString toolName() const override;
   void setProperties(const QVariantMap& properties) override;
 
@@ -82,23 +103,58 @@ public:
 
   static Esri::ArcGISRuntime::SurfacePlacement toSurfacePlacement(const QString& surfacePlacement);
 
+  quint64 messagesReceivedCount() const;
+  quint64 messagesRoutedCount() const;
+  quint64 messagesSkippedCount() const;
+  quint64 duplicatesDroppedCount() const;
+  quint64 ownMessagesDiscardedCount() const;
+  quint64 bytesReceivedCount() const;
+  quint64 binaryMessagesReceivedCount() const;
+  qint64 routingElapsed() const;
+  qint64 averageRoutingCost() const;
+
+  int statisticsInterval() const;
+  void setStatisticsInterval(int statisticsInterval);
+
 signals:
   void locationBroadcastEnabledChanged();
   void locationBroadcastFrequencyChanged();
   void locationBroadcastInDistressChanged();
+  void statisticsChanged();
+  void statisticsIntervalChanged();
   void toolErrorOccurred(const QString& errorMessage, const QString& additionalMessage);
 
 private:
   void setupFeeds();
+  void routeMessage(const QByteArray& data);
+  bool isDuplicate(const QByteArray& data);
+  void updateMulticastGroups();
+  void reportStatistics();
   Esri::ArcGISRuntime::Renderer* createRenderer(const QString& rendererInfo, QObject* parent = nullptr) const;
 
   Esri::ArcGISRuntime::GeoView* m_geoView = nullptr;
 
   MessageFeedListModel* m_messageFeeds = nullptr;
   QList<DataListener*> m_dataListeners;
+  QList<QHostAddress> m_multicastGroups;
   QString m_resourcePath;
   LocationBroadcast* m_locationBroadcast = nullptr;
+  DataCapture* m_dataCapture = nullptr;
+  QTimer* m_statisticsTimer = nullptr;
   QVariantList m_messageFeedProperties;
+  quint64 m_messagesReceivedCount = 0;
+  quint64 m_messagesRoutedCount = 0;
+  quint64 m_messagesSkippedCount = 0;
+  quint64 m_duplicatesDroppedCount = 0;
+  quint64 m_ownMessagesDiscardedCount = 0;
+  quint64 m_bytesReceivedCount = 0;
+  quint64 m_binaryMessagesReceivedCount = 0;
+  qint64 m_routingElapsed = 0;
+
+  // content keys of recently accepted datagrams and when they were accepted
+  QHash<quint64, qint64> m_recentDatagrams;
+  QElapsedTimer m_ingestClock;
+  qint64 m_lastDatagramPurge = 0;
 };
 
 } // Dsa
@@ -0,0 +1,398 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+// PCH header
+#include "pch.hpp"
+
+#include "MessageSymbolCache.h"
+
+// C++ API headers
+#include "DictionarySymbolStyle.h"
+#include "Symbol.h"
+#include "SymbolStyleSearchParameters.h"
+#include "SymbolStyleSearchResult.h"
+#include "SymbolStyleSearchResultListModel.h"
+#include "TaskWatcher.h"
+
+using namespace Esri::ArcGISRuntime;
+
+namespace Dsa {
+
+/*!
+  \class Dsa::MessageSymbolCache
+  \inmodule Dsa
+  \inherits QObject
+  \brief A cache of the symbols of a \l Esri::ArcGISRuntime::DictionarySymbolStyle,
+  keyed by symbol ID code (SIDC).
+
+  Thousands of message graphics typically share a few dozen distinct SIDCs. The
+  symbol for each SIDC is resolved once from the style and shared by every graphic
+  which uses it, instead of each graphic being resolved from its attributes by a
+  \l Esri::ArcGISRuntime::DictionaryRenderer.
+
+  Symbols are resolved asynchronously. \l symbol returns \c nullptr for a key which
+  has not been resolved yet, and \l symbolResolved is emitted once it is available.
+  Keys which the style cannot resolve are remembered, so they are only searched for
+  once.
+
+  The graphical modifiers are part of the SIDC itself, so the key is the normalized
+  SIDC. Text modifiers such as the unique designation are not drawn by cached symbols.
+
+  The symbols of a style are not keyed by complete SIDCs. Before resolving any key,
+  the cache reads the keys of every symbol in the style once. Each SIDC is then matched
+  to the style key which agrees with it in the most positions, where \c * and \c - in
+  a style key match any character, and the symbol is searched for by that style key.
+  SIDCs which share a style key share its symbol. SIDCs which match no style key are
+  left to the feed's renderer.
+ */
+
+/*!
+  \brief Returns the cache shared by every feed using the \a style.
+
+  The cache is created on first use and is destroyed with the style.
+ */
+MessageSymbolCache* MessageSymbolCache::forStyle(DictionarySymbolStyle* style)
+{
+  static QHash<DictionarySymbolStyle*, MessageSymbolCache*> s_caches;
+
+  if (!style)
+    return nullptr;
+
+  auto findIt = s_caches.constFind(style);
+  if (findIt != s_caches.constEnd())
+    return findIt.value();
+
+  MessageSymbolCache* cache = new MessageSymbolCache(style);
+  s_caches.insert(style, cache);
+  connect(style, &QObject::destroyed, [style]()
+  {
+    s_caches.remove(style);
+  });
+
+  return cache;
+}
+
+/*!
+  \internal
+ */
+MessageSymbolCache::MessageSymbolCache(DictionarySymbolStyle* style):
+  QObject(style),
+  m_style(style)
+{
+  connect(m_style, &DictionarySymbolStyle::searchSymbolsCompleted, this, &MessageSymbolCache::onSearchCompleted);
+}
+
+/*!
+  \brief Destructor.
+ */
+MessageSymbolCache::~MessageSymbolCache()
+{
+}
+
+/*!
+  \brief Returns the cache key for the symbol ID code \a symbolId.
+ */
+QString MessageSymbolCache::symbolKey(const QString& symbolId)
+{
+  return symbolId.trimmed().toUpper();
+}
+
+/*!
+  \brief Returns the cached symbol for \a key.
+
+  If the symbol has not been resolved, \c nullptr is returned and the symbol
+  is requested from the style.
+ */
+Symbol* MessageSymbolCache::symbol(const QString& key)
+{
+  auto findIt = m_symbols.constFind(key);
+  if (findIt != m_symbols.constEnd() && findIt.value())
+  {
+    ++m_hitCount;
+    return findIt.value();
+  }
+
+  ++m_missCount;
+
+  if (findIt == m_symbols.constEnd())
+    resolve(key);
+
+  return nullptr;
+}
+
+/*!
+  \brief Requests the symbols for \a keys, so that they are available before
+  the first graphics which use them arrive.
+ */
+void MessageSymbolCache::prewarm(const QStringList& keys)
+{
+  for (const QString& key : keys)
+  {
+    const QString symbolKey = MessageSymbolCache::symbolKey(key);
+    if (!symbolKey.isEmpty() && !m_symbols.contains(symbolKey))
+      resolve(symbolKey);
+  }
+}
+
+/*!
+  \brief Returns the number of keys which have been resolved, including
+  those which the style could not resolve.
+ */
+int MessageSymbolCache::size() const
+{
+  return m_symbols.size();
+}
+
+/*!
+  \brief Returns the number of times a cached symbol was returned.
+ */
+quint64 MessageSymbolCache::hitCount() const
+{
+  return m_hitCount;
+}
+
+/*!
+  \brief Returns the number of times no cached symbol was available.
+ */
+quint64 MessageSymbolCache::missCount() const
+{
+  return m_missCount;
+}
+
+/*!
+  \brief Returns the proportion of requests which returned a cached symbol.
+ */
+double MessageSymbolCache::hitRate() const
+{
+  const quint64 requests = m_hitCount + m_missCount;
+  return requests == 0 ? 0.0 : static_cast<double>(m_hitCount) / requests;
+}
+
+/*!
+  \internal
+
+  Resolves the symbol for \a key, unless it is already being resolved. Keys requested
+  before the style keys have been read wait for them.
+ */
+void MessageSymbolCache::resolve(const QString& key)
+{
+  if (m_resolvingKeys.contains(key))
+    return;
+
+  m_resolvingKeys.insert(key);
+
+  if (!m_styleKeysLoaded)
+  {
+    m_waitingKeys.append(key);
+    loadStyleKeys();
+    return;
+  }
+
+  searchStyleKey(key);
+}
+
+/*!
+  \internal
+
+  Searches the style for the symbol of the style key matching \a key.
+ */
+void MessageSymbolCache::searchStyleKey(const QString& key)
+{
+  const QString styleKey = styleKeyFor(key);
+  if (styleKey.isEmpty())
+  {
+    m_resolvingKeys.remove(key);
+    m_symbols.insert(key, nullptr);
+    return;
+  }
+
+  // the style key has already been searched for on behalf of another SIDC
+  auto symbolIt = m_styleKeySymbols.constFind(styleKey);
+  if (symbolIt != m_styleKeySymbols.constEnd())
+  {
+    m_resolvingKeys.remove(key);
+    m_symbols.insert(key, symbolIt.value());
+    if (symbolIt.value())
+      emit symbolResolved(key, symbolIt.value());
+
+    return;
+  }
+
+  auto pendingIt = m_pendingKeys.find(styleKey);
+  if (pendingIt != m_pendingKeys.end())
+  {
+    if (!pendingIt.value().contains(key))
+      pendingIt.value().append(key);
+
+    return;
+  }
+
+  SymbolStyleSearchParameters parameters;
+  parameters.setKeys(QStringList{styleKey});
+  parameters.setKeysStrictlyMatch(true);
+
+  const TaskWatcher watcher = m_style->searchSymbols(parameters);
+  if (!watcher.isValid())
+  {
+    m_resolvingKeys.remove(key);
+    m_symbols.insert(key, nullptr);
+    return;
+  }
+
+  m_pendingKeys.insert(styleKey, QStringList{key});
+  m_pendingSearches.insert(watcher.taskId(), styleKey);
+}
+
+/*!
+  \internal
+
+  Searches the style for all of its symbols, so that their keys can be read.
+ */
+void MessageSymbolCache::loadStyleKeys()
+{
+  if (!m_styleKeysTaskId.isNull())
+    return;
+
+  const TaskWatcher watcher = m_style->searchSymbols(SymbolStyleSearchParameters());
+  if (!watcher.isValid())
+  {
+    // without its keys, nothing can be resolved from the style
+    m_styleKeysLoaded = true;
+    for (const QString& key : qAsConst(m_waitingKeys))
+    {
+      m_resolvingKeys.remove(key);
+      m_symbols.insert(key, nullptr);
+    }
+
+    m_waitingKeys.clear();
+    return;
+  }
+
+  m_styleKeysTaskId = watcher.taskId();
+}
+
+/*!
+  \internal
+
+  Returns the style key which best matches the SIDC \a key, or an empty string if none does.
+
+  A style key matches if each of its characters is the same as the SIDC's, or is a
+  \c * or \c - placeholder. The match with the most identical characters is returned.
+ */
+QString MessageSymbolCache::styleKeyFor(const QString& key) const
+{
+  QString bestKey;
+  int bestScore = -1;
+  for (const QString& styleKey : m_styleKeys)
+  {
+    if (styleKey.isEmpty() || styleKey.size() > key.size())
+      continue;
+
+    int score = 0;
+    bool matches = true;
+    for (int i = 0; i < styleKey.size(); ++i)
+    {
+      const QChar styleChar = styleKey.at(i);
+      if (styleChar == key.at(i))
+        ++score;
+      else if (styleChar != QLatin1Char('*') && styleChar != QLatin1Char('-'))
+      {
+        matches = false;
+        break;
+      }
+    }
+
+    if (matches && score > bestScore)
+    {
+      bestKey = styleKey;
+      bestScore = score;
+    }
+  }
+
+  return bestKey;
+}
+
+/*!
+  \internal
+
+  Reads the style keys from the search for all symbols, or stores the symbol found by
+  the search \a taskId for every SIDC waiting for it.
+ */
+void MessageSymbolCache::onSearchCompleted(QUuid taskId, SymbolStyleSearchResultListModel* results)
+{
+  if (taskId == m_styleKeysTaskId)
+  {
+    if (results)
+    {
+      const QList<SymbolStyleSearchResult> searchResults = results->searchResults();
+      m_styleKeys.reserve(searchResults.size());
+      for (const SymbolStyleSearchResult& searchResult : searchResults)
+        m_styleKeys.append(searchResult.key().trimmed().toUpper());
+
+      results->setParent(this);
+      results->deleteLater();
+    }
+
+    m_styleKeysTaskId = QUuid();
+    m_styleKeysLoaded = true;
+
+    const QStringList waitingKeys = m_waitingKeys;
+    m_waitingKeys.clear();
+    for (const QString& key : waitingKeys)
+      searchStyleKey(key);
+
+    return;
+  }
+
+  const QString styleKey = m_pendingSearches.take(taskId);
+  if (styleKey.isEmpty())
+    return;
+
+  const QStringList keys = m_pendingKeys.take(styleKey);
+
+  Symbol* symbol = nullptr;
+  if (results)
+  {
+    const QList<SymbolStyleSearchResult> searchResults = results->searchResults();
+    if (!searchResults.isEmpty())
+      symbol = searchResults.first().symbol();
+
+    if (symbol)
+      symbol->setParent(this);
+
+    results->setParent(this);
+    results->deleteLater();
+  }
+
+  m_styleKeySymbols.insert(styleKey, symbol);
+
+  for (const QString& key : keys)
+  {
+    m_resolvingKeys.remove(key);
+    m_symbols.insert(key, symbol);
+
+    if (symbol)
+      emit symbolResolved(key, symbol);
+  }
+}
+
+} // Dsa
+
+// Signal Documentation
+/*!
+  \fn void MessageSymbolCache::symbolResolved(const QString& key, Esri::ArcGISRuntime::Symbol* symbol);
+  \brief Signal emitted when the \a symbol for \a key has been resolved.
+ */
@@ -0,0 +1,86 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef MESSAGESYMBOLCACHE_H
+#define MESSAGESYMBOLCACHE_H
+
+// Qt headers
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QUuid>
+#include <QVariantMap>
+
+namespace Esri {
+namespace ArcGISRuntime {
+class DictionarySymbolStyle;
+class Symbol;
+class SymbolStyleSearchResultListModel;
+}
+}
+
+namespace Dsa {
+
+class MessageSymbolCache : public QObject
+{
+  Q_OBJECT
+
+public:
+  static MessageSymbolCache* forStyle(Esri::ArcGISRuntime::DictionarySymbolStyle* style);
+
+  ~MessageSymbolCache();
+
+  static QString symbolKey(const QString& symbolId);
+
+  Esri::ArcGISRuntime::Symbol* symbol(const QString& key);
+  void prewarm(const QStringList& keys);
+
+  int size() const;
+  quint64 hitCount() const;
+  quint64 missCount() const;
+  double hitRate() const;
+
+signals:
+  void symbolResolved(const QString& key, Esri::ArcGISRuntime::Symbol* symbol);
+
+private:
+  explicit MessageSymbolCache(Esri::ArcGISRuntime::DictionarySymbolStyle* style);
+
+  void resolve(const QString& key);
+  void searchStyleKey(const QString& key);
+  void loadStyleKeys();
+  QString styleKeyFor(const QString& key) const;
+  void onSearchCompleted(QUuid taskId, Esri::ArcGISRuntime::SymbolStyleSearchResultListModel* results);
+
+  Esri::ArcGISRuntime::DictionarySymbolStyle* m_style = nullptr;
+
+  // a null symbol records a key which the style could not resolve
+  QHash<QString, Esri::ArcGISRuntime::Symbol*> m_symbols;
+  QStringList m_styleKeys;
+  QHash<QString, Esri::ArcGISRuntime::Symbol*> m_styleKeySymbols;
+  QUuid m_styleKeysTaskId;
+  bool m_styleKeysLoaded = false;
+  QStringList m_waitingKeys;
+  QSet<QString> m_resolvingKeys;
+  QHash<QUuid, QString> m_pendingSearches;
+  QHash<QString, QStringList> m_pendingKeys;
+  quint64 m_hitCount = 0;
+  quint64 m_missCount = 0;
+};
+
+} // Dsa
+
+#endif // MESSAGESYMBOLCACHE_H
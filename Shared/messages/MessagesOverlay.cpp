@@ -21,16 +21,38 @@
 
 // example app headers
 #include "Message.h"
+#include "MessageSymbolCache.h"
 
 // C++ API headers
+#include "CompositeSymbol.h"
 #include "GeoView.h"
 #include "GraphicsOverlay.h"
+#include "MapQuickView.h"
+#include "Point.h"
+#include "PolylineBuilder.h"
 #include "Renderer.h"
+#include "SceneQuickView.h"
+#include "SimpleLineSymbol.h"
+#include "SimpleMarkerSymbol.h"
+#include "SimpleRenderer.h"
+#include "TextSymbol.h"
+
+// Qt headers
+#include <QTimer>
+
+// STL headers
+#include <cmath>
 
 using namespace Esri::ArcGISRuntime;
 
 namespace Dsa {
 
+// the most positions kept for the trail of a single track
+static const int s_maximumTrailLength = 500;
+
+// approximate length of a degree at the equator, used to size cluster cells
+static const double s_metersPerDegree = 111320.0;
+
 /*!
   \class Dsa::MessagesOverlay
   \inmodule Dsa
@@ -40,6 +62,32 @@ namespace Dsa {
 
   The overlay currently only supports messages containing a
   point geometry type.
+
+  If a \l minimumUpdateInterval is set, updates to a graphic which arrive
+  sooner than that after its last update are held back, and only the
+  latest of them is applied once the interval has passed.
+
+  If a \l maximumAge is set, graphics which have not been updated
+  for that long are removed. The message IDs are kept in order of
+  their last update, so each expiry pass only visits the graphics
+  it removes.
+
+  If a \l trailLength is set, the most recent positions of each track
+  are kept in a fixed size ring buffer. The trails are drawn as
+  polylines in a single \l trailsOverlay. They are rebuilt at most once
+  a second, and only for the tracks which moved. Positions closer than
+  \l trailTolerance to the simplified trail are dropped.
+
+  If a \l clusterScale is set, and the view is zoomed out beyond it,
+  the graphics are replaced by one aggregate graphic for each cell of a
+  grid of \l clusterCellSize pixels at the current scale. The grid is
+  anchored to the map, so panning does not change it, and it is only
+  rebuilt when the zoom changes the cell size by a power of two. Track
+  moves only update the cells they leave and enter.
+
+  If a \l symbolCache is set, each graphic is given the shared symbol for
+  its SIDC rather than being resolved by the dictionary renderer. Graphics
+  whose symbol has not been resolved yet are drawn by the renderer.
  */
 
 /*!
@@ -60,8 +108,31 @@ MessagesOverlay::MessagesOverlay(GeoView* geoView, Renderer* renderer, const QSt
   m_geoView(geoView),
   m_renderer(renderer),
   m_surfacePlacement(surfacePlacement),
-  m_graphicsOverlay(new GraphicsOverlay(this))
+  m_graphicsOverlay(new GraphicsOverlay(this)),
+  m_expiryTimer(new QTimer(this)),
+  m_updateTimer(new QTimer(this)),
+  m_trailTimer(new QTimer(this)),
+  m_clusterTimer(new QTimer(this)),
+  m_clusterGridTimer(new QTimer(this))
 {
+  m_clock.start();
+  m_expiryTimer->setInterval(1000);
+  connect(m_expiryTimer, &QTimer::timeout, this, &MessagesOverlay::removeExpired);
+
+  m_updateTimer->setSingleShot(true);
+  connect(m_updateTimer, &QTimer::timeout, this, &MessagesOverlay::flushPendingUpdates);
+
+  m_trailTimer->setInterval(1000);
+  connect(m_trailTimer, &QTimer::timeout, this, &MessagesOverlay::refreshTrails);
+
+  m_clusterTimer->setSingleShot(true);
+  m_clusterTimer->setInterval(250);
+  connect(m_clusterTimer, &QTimer::timeout, this, &MessagesOverlay::refreshClusters);
+
+  m_clusterGridTimer->setSingleShot(true);
+  m_clusterGridTimer->setInterval(250);
+  connect(m_clusterGridTimer, &QTimer::timeout, this, &MessagesOverlay::updateClusterGrid);
+
   m_graphicsOverlay->setOverlayId(messageType);
   m_graphicsOverlay->setRenderingMode(GraphicsRenderingMode::Dynamic);
   m_graphicsOverlay->setSceneProperties(LayerSceneProperties(m_surfacePlacement));
@@ -116,6 +187,9 @@ void MessagesOverlay::setSurfacePlacement(SurfacePlacement surfacePlacement)
   m_surfacePlacement = surfacePlacement;
 
   m_graphicsOverlay->setSceneProperties(LayerSceneProperties(m_surfacePlacement));
+
+  if (m_trailsOverlay)
+    m_trailsOverlay->setSceneProperties(LayerSceneProperties(m_surfacePlacement));
 }
 
 /*!
@@ -196,11 +270,12 @@ bool MessagesOverlay::addMessage(const Message& message)
     }
   }
 
-  if (m_existingGraphics.contains(messageId))
+  auto existingIt = m_existingGraphics.find(messageId);
+  if (existingIt != m_existingGraphics.end())
   {
     // update existing graphic attributes and geometry
     // if the graphic already exists in the hash
-    Graphic* graphic = m_existingGraphics[messageId];
+    Graphic* graphic = existingIt.value().graphic;
 
     switch (messageAction)
     {
@@ -208,14 +283,47 @@ bool MessagesOverlay::addMessage(const Message& message)
     case Message::MessageAction::Select:
     case Message::MessageAction::Unselect:
     {
+      // hold back updates which arrive faster than the minimum update interval
+      if (messageAction == Message::MessageAction::Update && !m_flushingUpdates && m_minimumUpdateInterval > 0 &&
+          m_clock.elapsed() - existingIt.value().lastUpdate < m_minimumUpdateInterval)
+      {
+        if (m_pendingUpdates.contains(messageId))
+          ++m_droppedUpdateCount;
+
+        m_pendingUpdates.insert(messageId, message);
+        if (!m_updateTimer->isActive())
+          m_updateTimer->start(m_minimumUpdateInterval);
+
+        return true;
+      }
+
+      // any held back update is older than this one
+      if (m_pendingUpdates.remove(messageId) > 0)
+        ++m_droppedUpdateCount;
+
       const Geometry geom = graphic->geometry();
       if (geom.geometryType() != geometry.geometryType())
         return false;
 
       if (!(geom == geometry))
+      {
         graphic->setGeometry(geometry);
+        recordTrailPoint(existingIt.value(), geometry);
+        if (m_clustered)
+        {
+          removeFromCluster(existingIt.value());
+          addToCluster(existingIt.value(), geometry);
+        }
+        emit graphicMoved(graphic);
+      }
 
-      graphic->attributes()->setAttributesMap(message.attributes());
+      // resent messages often carry identical attributes
+      const QVariantMap attributes = message.attributes();
+      if (graphic->attributes()->attributesMap() != attributes)
+        graphic->attributes()->setAttributesMap(attributes);
+
+      if (m_symbolCache && !symbolId.isEmpty())
+        applyCachedSymbol(existingIt.value(), symbolId);
 
       if (messageAction == Message::MessageAction::Select)
       {
@@ -226,11 +334,14 @@ bool MessagesOverlay::addMessage(const Message& message)
         graphic->setSelected(false);
       }
 
+      touch(existingIt.value());
       break;
     }
     case Message::MessageAction::Remove:
     {
-      m_graphicsOverlay->graphics()->removeOne(graphic);
+      m_pendingUpdates.remove(messageId);
+      removeTracked(existingIt);
+      emit graphicsChanged();
       break;
     }
     default:
@@ -250,7 +361,19 @@ bool MessagesOverlay::addMessage(const Message& message)
   // add new graphic
   Graphic* graphic = new Graphic(geometry, message.attributes(), this);
   m_graphicsOverlay->graphics()->append(graphic);
-  m_existingGraphics.insert(messageId, graphic);
+
+  TrackedGraphic trackedGraphic;
+  trackedGraphic.graphic = graphic;
+  trackedGraphic.lastUpdate = m_clock.elapsed();
+  trackedGraphic.recency = m_recency.insert(m_recency.end(), messageId);
+  auto trackedIt = m_existingGraphics.insert(messageId, trackedGraphic);
+  recordTrailPoint(trackedIt.value(), geometry);
+  if (m_clustered)
+    addToCluster(trackedIt.value(), geometry);
+
+  if (m_symbolCache)
+    applyCachedSymbol(trackedIt.value(), symbolId);
+  emit graphicsChanged();
 
   return true;
 }
@@ -260,7 +383,7 @@ bool MessagesOverlay::addMessage(const Message& message)
  */
 bool MessagesOverlay::isVisible() const
 {
-  return m_graphicsOverlay->isVisible();
+  return m_visible;
 }
 
 /*!
@@ -268,14 +391,899 @@ bool MessagesOverlay::isVisible() const
  */
 void MessagesOverlay::setVisible(bool visible)
 {
-  if (m_graphicsOverlay->isVisible() == visible)
+  if (m_visible == visible)
     return;
 
-  m_graphicsOverlay->setVisible(visible);
+  m_visible = visible;
+  updateVisibility();
 
   emit visibleChanged();
 }
 
+/*!
+  \brief Returns the maximum age in seconds of a graphic which has
+  not been updated.
+
+  A value of \c 0 means graphics never expire.
+ */
+int MessagesOverlay::maximumAge() const
+{
+  return m_maximumAge;
+}
+
+/*!
+  \brief Sets the maximum age in seconds of a graphic which has not
+  been updated to \a maximumAge.
+
+  Graphics older than this are removed about once a second. A value
+  of \c 0 disables expiry.
+ */
+void MessagesOverlay::setMaximumAge(int maximumAge)
+{
+  maximumAge = qMax(0, maximumAge);
+  if (m_maximumAge == maximumAge)
+    return;
+
+  m_maximumAge = maximumAge;
+
+  if (m_maximumAge > 0)
+    m_expiryTimer->start();
+  else
+    m_expiryTimer->stop();
+}
+
+/*!
+  \brief Returns the number of graphics currently in the overlay.
+ */
+int MessagesOverlay::liveCount() const
+{
+  return m_existingGraphics.size();
+}
+
+/*!
+  \brief Returns the number of graphics which have been removed
+  because they exceeded the \l maximumAge.
+ */
+quint64 MessagesOverlay::expiredCount() const
+{
+  return m_expiredCount;
+}
+
+/*!
+  \brief Removes the graphics which have not been updated within the
+  \l maximumAge and returns how many were removed.
+
+  Only the expired graphics are visited, and \l graphicsChanged is
+  emitted once for the whole batch.
+ */
+int MessagesOverlay::removeExpired()
+{
+  if (m_maximumAge <= 0)
+    return 0;
+
+  const qint64 cutoff = m_clock.elapsed() - static_cast<qint64>(m_maximumAge) * 1000;
+
+  int removed = 0;
+  while (!m_recency.empty())
+  {
+    auto it = m_existingGraphics.find(m_recency.front());
+
+    // the remaining graphics were all updated more recently
+    if (it.value().lastUpdate > cutoff)
+      break;
+
+    removeTracked(it);
+    ++removed;
+  }
+
+  if (removed == 0)
+    return 0;
+
+  m_expiredCount += static_cast<quint64>(removed);
+  emit graphicsChanged();
+
+  return removed;
+}
+
+/*!
+  \brief Returns the minimum time in milliseconds between two updates
+  applied to the same graphic.
+
+  A value of \c 0 applies every update as soon as it arrives.
+ */
+int MessagesOverlay::minimumUpdateInterval() const
+{
+  return m_minimumUpdateInterval;
+}
+
+/*!
+  \brief Sets the minimum time in milliseconds between two updates applied
+  to the same graphic to \a minimumUpdateInterval.
+ */
+void MessagesOverlay::setMinimumUpdateInterval(int minimumUpdateInterval)
+{
+  m_minimumUpdateInterval = qMax(0, minimumUpdateInterval);
+
+  if (m_minimumUpdateInterval == 0)
+    flushPendingUpdates();
+}
+
+/*!
+  \brief Returns the number of updates which were never applied because a
+  newer update for the same graphic replaced them.
+ */
+quint64 MessagesOverlay::droppedUpdateCount() const
+{
+  return m_droppedUpdateCount;
+}
+
+/*!
+  \internal
+
+  Applies the latest held back update for each graphic.
+ */
+void MessagesOverlay::flushPendingUpdates()
+{
+  m_updateTimer->stop();
+  if (m_pendingUpdates.isEmpty())
+    return;
+
+  const QHash<QString, Message> pendingUpdates = m_pendingUpdates;
+  m_pendingUpdates.clear();
+
+  m_flushingUpdates = true;
+  for (const Message& message : pendingUpdates)
+    addMessage(message);
+  m_flushingUpdates = false;
+}
+
+/*!
+  \internal
+
+  Records that \a trackedGraphic was updated now.
+ */
+void MessagesOverlay::touch(TrackedGraphic& trackedGraphic)
+{
+  trackedGraphic.lastUpdate = m_clock.elapsed();
+  m_recency.splice(m_recency.end(), m_recency, trackedGraphic.recency);
+}
+
+/*!
+  \internal
+
+  Removes the graphic at \a it from the overlay and stops tracking it.
+
+  The graphic is deleted, which also releases any alert data
+  created for it.
+ */
+void MessagesOverlay::removeTracked(QHash<QString, TrackedGraphic>::iterator it)
+{
+  Graphic* graphic = it.value().graphic;
+  if (it.value().trailSlot != -1)
+    releaseTrail(it.value().trailSlot);
+
+  if (m_clustered)
+    removeFromCluster(it.value());
+
+  m_pendingUpdates.remove(it.key());
+
+  m_recency.erase(it.value().recency);
+  m_existingGraphics.erase(it);
+
+  m_graphicsOverlay->graphics()->removeOne(graphic);
+  graphic->deleteLater();
+}
+
+/*!
+  \brief Returns the number of recent positions kept for the trail of each track.
+
+  A value of \c 0 means no trails are shown.
+ */
+int MessagesOverlay::trailLength() const
+{
+  return m_trailLength;
+}
+
+/*!
+  \brief Sets the number of recent positions kept for the trail of each
+  track to \a trailLength.
+
+  The length is limited to 500 positions. Changing the length discards
+  the existing trails.
+ */
+void MessagesOverlay::setTrailLength(int trailLength)
+{
+  trailLength = qBound(0, trailLength, s_maximumTrailLength);
+  if (m_trailLength == trailLength)
+    return;
+
+  resetTrails();
+  m_trailLength = trailLength;
+
+  if (m_trailLength == 0)
+  {
+    m_trailTimer->stop();
+    return;
+  }
+
+  if (!m_trailsOverlay)
+  {
+    SimpleLineSymbol* trailSymbol = new SimpleLineSymbol(SimpleLineSymbolStyle::Dash, QColor(Qt::darkGray), 2.0f, this);
+
+    // the overlay has no ID so it is not offered as an alert source or target
+    m_trailsOverlay = new GraphicsOverlay(this);
+    m_trailsOverlay->setRenderingMode(GraphicsRenderingMode::Dynamic);
+    m_trailsOverlay->setSceneProperties(LayerSceneProperties(m_surfacePlacement));
+    m_trailsOverlay->setRenderer(new SimpleRenderer(trailSymbol, this));
+    updateVisibility();
+
+    // draw the trails beneath the message graphics
+    GraphicsOverlayListModel* graphicsOverlays = m_geoView->graphicsOverlays();
+    graphicsOverlays->insert(qMax(0, graphicsOverlays->indexOf(m_graphicsOverlay)), m_trailsOverlay);
+  }
+
+  m_trailTimer->start();
+}
+
+/*!
+  \brief Returns the tolerance used to simplify the trails, in the units
+  of the spatial reference of the messages.
+ */
+double MessagesOverlay::trailTolerance() const
+{
+  return m_trailTolerance;
+}
+
+/*!
+  \brief Sets the tolerance used to simplify the trails to \a trailTolerance.
+
+  A value of \c 0 keeps every position.
+ */
+void MessagesOverlay::setTrailTolerance(double trailTolerance)
+{
+  m_trailTolerance = qMax(0.0, trailTolerance);
+}
+
+/*!
+  \brief Returns the overlay containing the trail graphics, or \c nullptr
+  if no \l trailLength has been set.
+ */
+GraphicsOverlay* MessagesOverlay::trailsOverlay() const
+{
+  return m_trailsOverlay;
+}
+
+/*!
+  \internal
+
+  Adds the point \a geometry to the ring buffer for \a trackedGraphic,
+  overwriting its oldest position once the buffer is full.
+ */
+void MessagesOverlay::recordTrailPoint(TrackedGraphic& trackedGraphic, const Geometry& geometry)
+{
+  if (m_trailLength == 0)
+    return;
+
+  if (trackedGraphic.trailSlot == -1)
+  {
+    if (!m_freeTrailSlots.isEmpty())
+    {
+      trackedGraphic.trailSlot = m_freeTrailSlots.takeLast();
+    }
+    else
+    {
+      trackedGraphic.trailSlot = m_trailRings.size();
+      m_trailRings.append(TrailRing());
+      m_trailPoints.resize(m_trailPoints.size() + m_trailLength);
+    }
+
+    m_trailRings[trackedGraphic.trailSlot].trackGraphic = trackedGraphic.graphic;
+  }
+
+  const int slot = trackedGraphic.trailSlot;
+  TrailRing& ring = m_trailRings[slot];
+
+  const Point point(geometry);
+  TrailPoint& trailPoint = m_trailPoints[slot * m_trailLength + ring.head];
+  trailPoint.x = point.x();
+  trailPoint.y = point.y();
+  trailPoint.z = point.hasZ() ? point.z() : 0.0;
+
+  ring.head = (ring.head + 1) % m_trailLength;
+  ring.size = qMin(ring.size + 1, m_trailLength);
+
+  if (!ring.dirty)
+  {
+    ring.dirty = true;
+    m_dirtyTrailSlots.append(slot);
+  }
+}
+
+/*!
+  \internal
+
+  Removes the trail graphic for \a trailSlot and makes the slot available for re-use.
+ */
+void MessagesOverlay::releaseTrail(int trailSlot)
+{
+  TrailRing& ring = m_trailRings[trailSlot];
+  if (ring.trailGraphic)
+  {
+    m_trailsOverlay->graphics()->removeOne(ring.trailGraphic);
+    ring.trailGraphic->deleteLater();
+  }
+
+  ring = TrailRing();
+  m_freeTrailSlots.append(trailSlot);
+}
+
+/*!
+  \internal
+
+  Removes every trail and releases the ring buffers.
+ */
+void MessagesOverlay::resetTrails()
+{
+  for (auto it = m_existingGraphics.begin(); it != m_existingGraphics.end(); ++it)
+    it.value().trailSlot = -1;
+
+  if (m_trailsOverlay)
+    m_trailsOverlay->graphics()->clear();
+
+  for (const TrailRing& ring : qAsConst(m_trailRings))
+  {
+    if (ring.trailGraphic)
+      ring.trailGraphic->deleteLater();
+  }
+
+  m_trailPoints.clear();
+  m_trailRings.clear();
+  m_freeTrailSlots.clear();
+  m_dirtyTrailSlots.clear();
+}
+
+/*!
+  \internal
+
+  Rebuilds the trail graphics of the tracks which moved since the last refresh.
+
+  The cost depends on the number of tracks which moved and the
+  \l trailLength, not on how many messages were received.
+ */
+void MessagesOverlay::refreshTrails()
+{
+  if (m_dirtyTrailSlots.isEmpty())
+    return;
+
+  QVector<TrailPoint> points;
+  QVector<bool> keep;
+
+  for (int slot : qAsConst(m_dirtyTrailSlots))
+  {
+    TrailRing& ring = m_trailRings[slot];
+    if (!ring.dirty)
+      continue;
+
+    ring.dirty = false;
+    if (ring.size < 2 || !ring.trackGraphic)
+      continue;
+
+    // unroll the ring from the oldest to the newest position
+    const TrailPoint* ringPoints = m_trailPoints.constData() + slot * m_trailLength;
+    const int oldest = (ring.head - ring.size + m_trailLength) % m_trailLength;
+    points.resize(ring.size);
+    for (int i = 0; i < ring.size; ++i)
+      points[i] = ringPoints[(oldest + i) % m_trailLength];
+
+    simplifyTrail(points, m_trailTolerance, keep);
+
+    const Geometry trackGeometry = ring.trackGraphic->geometry();
+    const bool hasZ = trackGeometry.hasZ();
+    PolylineBuilder builder(trackGeometry.spatialReference());
+    for (int i = 0; i < points.size(); ++i)
+    {
+      if (!keep.at(i))
+        continue;
+
+      const TrailPoint& point = points.at(i);
+      if (hasZ)
+        builder.addPoint(point.x, point.y, point.z);
+      else
+        builder.addPoint(point.x, point.y);
+    }
+
+    const Geometry trail = builder.toGeometry();
+    if (ring.trailGraphic)
+    {
+      ring.trailGraphic->setGeometry(trail);
+    }
+    else
+    {
+      ring.trailGraphic = new Graphic(trail, this);
+      m_trailsOverlay->graphics()->append(ring.trailGraphic);
+    }
+  }
+
+  m_dirtyTrailSlots.clear();
+}
+
+/*!
+  \brief Returns the scale beyond which the graphics are clustered.
+
+  A value of \c 0 means the graphics are never clustered.
+ */
+double MessagesOverlay::clusterScale() const
+{
+  return m_clusterScale;
+}
+
+/*!
+  \brief Sets the scale beyond which the graphics are clustered to \a clusterScale.
+
+  When the view is zoomed out further than this scale, aggregate
+  graphics replace the individual ones. A value of \c 0 disables clustering.
+ */
+void MessagesOverlay::setClusterScale(double clusterScale)
+{
+  clusterScale = qMax(0.0, clusterScale);
+  if (m_clusterScale == clusterScale)
+    return;
+
+  m_clusterScale = clusterScale;
+
+  if (m_clusterScale > 0.0)
+    connectView();
+
+  updateClusterGrid();
+}
+
+/*!
+  \brief Returns the size of a cluster cell in device independent pixels.
+ */
+int MessagesOverlay::clusterCellSize() const
+{
+  return m_clusterCellSize;
+}
+
+/*!
+  \brief Sets the size of a cluster cell in device independent pixels to
+  \a clusterCellSize.
+
+  The size is limited to between 16 and 512 pixels.
+ */
+void MessagesOverlay::setClusterCellSize(int clusterCellSize)
+{
+  clusterCellSize = qBound(16, clusterCellSize, 512);
+  if (m_clusterCellSize == clusterCellSize)
+    return;
+
+  m_clusterCellSize = clusterCellSize;
+
+  // force the grid to be rebuilt
+  m_clusterCellExtent = -1.0;
+  updateClusterGrid();
+}
+
+/*!
+  \brief Returns whether aggregate graphics are currently shown in place
+  of the individual graphics.
+ */
+bool MessagesOverlay::isClustered() const
+{
+  return m_clustered;
+}
+
+/*!
+  \brief Returns the number of aggregate graphics currently shown.
+ */
+int MessagesOverlay::clusterCount() const
+{
+  return m_clusters.size();
+}
+
+/*!
+  \brief Returns the overlay containing the aggregate graphics, or
+  \c nullptr if the graphics have never been clustered.
+ */
+GraphicsOverlay* MessagesOverlay::clustersOverlay() const
+{
+  return m_clustersOverlay;
+}
+
+/*!
+  \internal
+
+  Shows either the individual graphics and their trails, or the
+  aggregate graphics.
+ */
+void MessagesOverlay::updateVisibility()
+{
+  m_graphicsOverlay->setVisible(m_visible && !m_clustered);
+
+  if (m_trailsOverlay)
+    m_trailsOverlay->setVisible(m_visible && !m_clustered);
+
+  if (m_clustersOverlay)
+    m_clustersOverlay->setVisible(m_visible && m_clustered);
+}
+
+/*!
+  \internal
+
+  Checks the cluster grid whenever the viewpoint changes, at most every 250ms.
+ */
+void MessagesOverlay::connectView()
+{
+  if (m_viewConnected)
+    return;
+
+  auto scheduleGridUpdate = [this]()
+  {
+    if (!m_clusterGridTimer->isActive())
+      m_clusterGridTimer->start();
+  };
+
+  if (SceneQuickView* sceneView = dynamic_cast<SceneQuickView*>(m_geoView))
+    connect(sceneView, &SceneQuickView::viewpointChanged, this, scheduleGridUpdate);
+  else if (MapQuickView* mapView = dynamic_cast<MapQuickView*>(m_geoView))
+    connect(mapView, &MapQuickView::viewpointChanged, this, scheduleGridUpdate);
+  else
+    return;
+
+  m_viewConnected = true;
+}
+
+/*!
+  \internal
+
+  Works out the size of a cluster cell at the current scale and rebuilds
+  the clusters if it has changed.
+ */
+void MessagesOverlay::updateClusterGrid()
+{
+  double cellExtent = 0.0;
+  if (m_clusterScale > 0.0 && m_geoView)
+  {
+    const double scale = m_geoView->currentViewpoint(ViewpointType::CenterAndScale).targetScale();
+    if (scale > m_clusterScale)
+    {
+      // the ground size of a cell, at 96 device independent pixels per inch
+      cellExtent = m_clusterCellSize * scale * 0.0254 / 96.0;
+
+      // messages in geographic coordinates are binned in degrees
+      auto it = m_existingGraphics.constBegin();
+      if (it == m_existingGraphics.constEnd() || it.value().graphic->geometry().spatialReference().isGeographic())
+        cellExtent /= s_metersPerDegree;
+
+      // snap to a power of two so that small zooms keep the same grid
+      cellExtent = std::pow(2.0, std::round(std::log2(cellExtent)));
+    }
+  }
+
+  if (cellExtent == m_clusterCellExtent)
+    return;
+
+  m_clusterCellExtent = cellExtent;
+  rebuildClusters();
+}
+
+/*!
+  \internal
+
+  Discards the clusters and, if the current scale requires it, assigns
+  every graphic to a cell of the current grid.
+ */
+void MessagesOverlay::rebuildClusters()
+{
+  m_clusterTimer->stop();
+
+  if (m_clustersOverlay)
+    m_clustersOverlay->graphics()->clear();
+
+  for (const Cluster& cluster : qAsConst(m_clusters))
+  {
+    if (cluster.graphic)
+      cluster.graphic->deleteLater();
+  }
+
+  m_clusters.clear();
+  m_dirtyClusters.clear();
+
+  const bool clustered = m_clusterCellExtent > 0.0;
+  if (clustered)
+  {
+    if (!m_clustersOverlay)
+    {
+      m_clusterMarker = new SimpleMarkerSymbol(SimpleMarkerSymbolStyle::Circle, QColor(0, 90, 160, 200), 28.0f, this);
+
+      // the overlay has no ID so it is not offered as an alert source or target
+      m_clustersOverlay = new GraphicsOverlay(this);
+      m_clustersOverlay->setRenderingMode(GraphicsRenderingMode::Dynamic);
+      m_clustersOverlay->setSceneProperties(LayerSceneProperties(SurfacePlacement::Draped));
+
+      // draw the clusters above the message graphics
+      GraphicsOverlayListModel* graphicsOverlays = m_geoView->graphicsOverlays();
+      graphicsOverlays->insert(graphicsOverlays->indexOf(m_graphicsOverlay) + 1, m_clustersOverlay);
+    }
+
+    for (auto it = m_existingGraphics.begin(); it != m_existingGraphics.end(); ++it)
+      addToCluster(it.value(), it.value().graphic->geometry());
+
+    refreshClusters();
+  }
+
+  if (m_clustered == clustered)
+    return;
+
+  m_clustered = clustered;
+  updateVisibility();
+
+  emit clusteredChanged();
+}
+
+/*!
+  \internal
+
+  Adds the point \a geometry of \a trackedGraphic to the cluster for its cell.
+ */
+void MessagesOverlay::addToCluster(TrackedGraphic& trackedGraphic, const Geometry& geometry)
+{
+  const Point point(geometry);
+  trackedGraphic.clusterX = point.x();
+  trackedGraphic.clusterY = point.y();
+  m_clusterSpatialReference = point.spatialReference();
+
+  const quint64 key = clusterKey(trackedGraphic.clusterX, trackedGraphic.clusterY);
+  Cluster& cluster = m_clusters[key];
+  ++cluster.count;
+  cluster.sumX += trackedGraphic.clusterX;
+  cluster.sumY += trackedGraphic.clusterY;
+
+  markClusterDirty(key);
+}
+
+/*!
+  \internal
+
+  Removes the position last added for \a trackedGraphic from its cluster.
+ */
+void MessagesOverlay::removeFromCluster(const TrackedGraphic& trackedGraphic)
+{
+  const quint64 key = clusterKey(trackedGraphic.clusterX, trackedGraphic.clusterY);
+  auto it = m_clusters.find(key);
+  if (it == m_clusters.end())
+    return;
+
+  Cluster& cluster = it.value();
+  --cluster.count;
+  cluster.sumX -= trackedGraphic.clusterX;
+  cluster.sumY -= trackedGraphic.clusterY;
+
+  markClusterDirty(key);
+}
+
+/*!
+  \internal
+
+  Queues the cluster for \a key to be redrawn.
+ */
+void MessagesOverlay::markClusterDirty(quint64 key)
+{
+  Cluster& cluster = m_clusters[key];
+  if (cluster.dirty)
+    return;
+
+  cluster.dirty = true;
+  m_dirtyClusters.append(key);
+
+  if (!m_clusterTimer->isActive())
+    m_clusterTimer->start();
+}
+
+/*!
+  \internal
+
+  Updates the aggregate graphics of the clusters which changed.
+
+  The cost depends on the number of changed cells, which is bounded
+  by the number of cells on screen rather than the number of tracks.
+ */
+void MessagesOverlay::refreshClusters()
+{
+  for (quint64 key : qAsConst(m_dirtyClusters))
+  {
+    auto it = m_clusters.find(key);
+    if (it == m_clusters.end())
+      continue;
+
+    Cluster& cluster = it.value();
+    cluster.dirty = false;
+
+    if (cluster.count <= 0)
+    {
+      if (cluster.graphic)
+      {
+        m_clustersOverlay->graphics()->removeOne(cluster.graphic);
+        cluster.graphic->deleteLater();
+      }
+
+      m_clusters.erase(it);
+      continue;
+    }
+
+    const Point centroid(cluster.sumX / cluster.count, cluster.sumY / cluster.count, m_clusterSpatialReference);
+    if (!cluster.graphic)
+    {
+      cluster.graphic = new Graphic(centroid, this);
+      m_clustersOverlay->graphics()->append(cluster.graphic);
+    }
+    else
+    {
+      cluster.graphic->setGeometry(centroid);
+    }
+
+    if (cluster.shownCount == cluster.count)
+      continue;
+
+    // the symbols belong to the graphic, so they are released with it; the previous
+    // label and composite are released as soon as they are replaced
+    TextSymbol* label = new TextSymbol(QString::number(cluster.count), QColor(Qt::white), 12.0f,
+                                       HorizontalAlignment::Center, VerticalAlignment::Middle, cluster.graphic);
+    Symbol* previousSymbol = cluster.graphic->symbol();
+    cluster.graphic->setSymbol(new CompositeSymbol(QList<Symbol*>{m_clusterMarker, label}, cluster.graphic));
+    if (previousSymbol)
+      previousSymbol->deleteLater();
+
+    if (cluster.label)
+      cluster.label->deleteLater();
+
+    cluster.label = label;
+
+    cluster.shownCount = cluster.count;
+  }
+
+  m_dirtyClusters.clear();
+}
+
+/*!
+  \internal
+
+  Returns the key of the grid cell containing \a x and \a y.
+ */
+quint64 MessagesOverlay::clusterKey(double x, double y) const
+{
+  const qint32 column = static_cast<qint32>(std::floor(x / m_clusterCellExtent));
+  const qint32 row = static_cast<qint32>(std::floor(y / m_clusterCellExtent));
+  return (static_cast<quint64>(static_cast<quint32>(column)) << 32) | static_cast<quint32>(row);
+}
+
+/*!
+  \brief Returns the cache of shared symbols used for the graphics, or
+  \c nullptr if the graphics are drawn by the \l renderer.
+ */
+MessageSymbolCache* MessagesOverlay::symbolCache() const
+{
+  return m_symbolCache;
+}
+
+/*!
+  \brief Sets the cache of shared symbols used for the graphics to \a symbolCache.
+
+  Setting \c nullptr draws every graphic with the \l renderer again.
+ */
+void MessagesOverlay::setSymbolCache(MessageSymbolCache* symbolCache)
+{
+  if (m_symbolCache == symbolCache)
+    return;
+
+  if (m_symbolCache)
+    disconnect(m_symbolCache, nullptr, this, nullptr);
+
+  m_symbolCache = symbolCache;
+
+  if (m_symbolCache)
+    connect(m_symbolCache, &MessageSymbolCache::symbolResolved, this, &MessagesOverlay::onSymbolResolved);
+
+  for (auto it = m_existingGraphics.begin(); it != m_existingGraphics.end(); ++it)
+  {
+    TrackedGraphic& trackedGraphic = it.value();
+    trackedGraphic.symbolKey.clear();
+
+    if (m_symbolCache)
+      applyCachedSymbol(trackedGraphic, trackedGraphic.graphic->attributes()->attributeValue(Message::SIDC_NAME).toString());
+    else
+      trackedGraphic.graphic->setSymbol(nullptr);
+  }
+}
+
+/*!
+  \internal
+
+  Gives the graphic of \a trackedGraphic the cached symbol for \a symbolId,
+  if its SIDC has changed.
+ */
+void MessagesOverlay::applyCachedSymbol(TrackedGraphic& trackedGraphic, const QString& symbolId)
+{
+  const QString key = MessageSymbolCache::symbolKey(symbolId);
+  if (key == trackedGraphic.symbolKey)
+    return;
+
+  trackedGraphic.symbolKey = key;
+
+  // until the symbol is resolved the graphic is drawn by the renderer
+  trackedGraphic.graphic->setSymbol(m_symbolCache->symbol(key));
+}
+
+/*!
+  \internal
+
+  Gives the newly resolved \a symbol to the graphics waiting for \a key.
+ */
+void MessagesOverlay::onSymbolResolved(const QString& key, Symbol* symbol)
+{
+  for (auto it = m_existingGraphics.begin(); it != m_existingGraphics.end(); ++it)
+  {
+    TrackedGraphic& trackedGraphic = it.value();
+    if (trackedGraphic.symbolKey == key && trackedGraphic.graphic->symbol() != symbol)
+      trackedGraphic.graphic->setSymbol(symbol);
+  }
+}
+
+/*!
+  \internal
+
+  Marks in \a keep the \a points which are needed to draw the path
+  through them within \a tolerance, using the Douglas-Peucker algorithm.
+  The first and last points are always kept.
+ */
+void MessagesOverlay::simplifyTrail(const QVector<TrailPoint>& points, double tolerance, QVector<bool>& keep)
+{
+  const int count = points.size();
+  keep.fill(tolerance <= 0.0, count);
+  if (count == 0 || tolerance <= 0.0)
+    return;
+
+  keep[0] = true;
+  keep[count - 1] = true;
+
+  const double toleranceSquared = tolerance * tolerance;
+  QVector<QPair<int, int>> spans{qMakePair(0, count - 1)};
+  while (!spans.isEmpty())
+  {
+    const QPair<int, int> span = spans.takeLast();
+    const TrailPoint& start = points.at(span.first);
+    const TrailPoint& end = points.at(span.second);
+    const double dx = end.x - start.x;
+    const double dy = end.y - start.y;
+    const double lengthSquared = dx * dx + dy * dy;
+
+    // find the point furthest from the segment between the ends of the span
+    int furthest = -1;
+    double furthestSquared = toleranceSquared;
+    for (int i = span.first + 1; i < span.second; ++i)
+    {
+      const TrailPoint& point = points.at(i);
+      double t = lengthSquared > 0.0 ? ((point.x - start.x) * dx + (point.y - start.y) * dy) / lengthSquared : 0.0;
+      t = qBound(0.0, t, 1.0);
+      const double offsetX = point.x - (start.x + t * dx);
+      const double offsetY = point.y - (start.y + t * dy);
+      const double distanceSquared = offsetX * offsetX + offsetY * offsetY;
+      if (distanceSquared > furthestSquared)
+      {
+        furthest = i;
+        furthestSquared = distanceSquared;
+      }
+    }
+
+    if (furthest == -1)
+      continue;
+
+    keep[furthest] = true;
+    spans.append(qMakePair(span.first, furthest));
+    spans.append(qMakePair(furthest, span.second));
+  }
+}
+
 } // Dsa
 
 // Signal Documentation
@@ -284,6 +1292,22 @@ void MessagesOverlay::setVisible(bool visible)
   \brief Signal emitted when the visibility of the overlay changes.
  */
 
+/*!
+  \fn void MessagesOverlay::clusteredChanged();
+  \brief Signal emitted when aggregate graphics replace the individual
+  graphics, or the individual graphics are shown again.
+ */
+
+/*!
+  \fn void MessagesOverlay::graphicsChanged();
+  \brief Signal emitted when a graphic is added to or removed from the overlay.
+ */
+
+/*!
+  \fn void MessagesOverlay::graphicMoved(Esri::ArcGISRuntime::Graphic* graphic);
+  \brief Signal emitted when the geometry of \a graphic changes.
+ */
+
 /*!
   \fn void MessagesOverlay::errorOccurred(const QString& error);
   \brief Signal emitted when an \a error occurs.
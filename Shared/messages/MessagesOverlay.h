@@ -17,9 +17,22 @@
 #ifndef MESSAGESOVERLAY_H
 #define MESSAGESOVERLAY_H
 
+// example app headers
+#include "Message.h"
+
+// C++ API headers
+#include "SpatialReference.h"
+
 // Qt headers
+#include <QElapsedTimer>
 #include <QObject>
 #include <QPointer>
+#include <QVector>
+
+// STL headers
+#include <list>
+
+class QTimer;
 
 namespace Esri
 {
@@ -28,14 +41,18 @@ namespace Esri
     class GeoView;
     class Renderer;
     class GraphicsOverlay;
+    class Geometry;
     class Graphic;
+    class SimpleMarkerSymbol;
+    class Symbol;
+    class TextSymbol;
     enum class SurfacePlacement;
   }
 }
 
 namespace Dsa {
 
-class Message;
+class MessageSymbolCache;
 
 class MessagesOverlay : public QObject
 {
@@ -66,19 +83,160 @@ public:
   bool isVisible() const;
   void setVisible(bool visible);
 
+  int maximumAge() const;
+  void setMaximumAge(int maximumAge);
+
+  int liveCount() const;
+  quint64 expiredCount() const;
+
+  int removeExpired();
+
+  int minimumUpdateInterval() const;
+  void setMinimumUpdateInterval(int minimumUpdateInterval);
+
+  quint64 droppedUpdateCount() const;
+
+  int trailLength() const;
+  void setTrailLength(int trailLength);
+
+  double trailTolerance() const;
+  void setTrailTolerance(double trailTolerance);
+
+  Esri::ArcGISRuntime::GraphicsOverlay* trailsOverlay() const;
+
+  double clusterScale() const;
+  void setClusterScale(double clusterScale);
+
+  int clusterCellSize() const;
+  void setClusterCellSize(int clusterCellSize);
+
+  bool isClustered() const;
+  int clusterCount() const;
+
+  Esri::ArcGISRuntime::GraphicsOverlay* clustersOverlay() const;
+
+  MessageSymbolCache* symbolCache() const;
+  void setSymbolCache(MessageSymbolCache* symbolCache);
+
 signals:
   void visibleChanged();
+  void clusteredChanged();
+  void graphicsChanged();
+  void graphicMoved(Esri::ArcGISRuntime::Graphic* graphic);
   void errorOccurred(const QString& error);
 
 private:
   Q_DISABLE_COPY(MessagesOverlay)
 
+  struct TrackedGraphic
+  {
+    Esri::ArcGISRuntime::Graphic* graphic = nullptr;
+    qint64 lastUpdate = 0;
+    std::list<QString>::iterator recency;
+    int trailSlot = -1;
+    double clusterX = 0.0;
+    double clusterY = 0.0;
+    QString symbolKey;
+  };
+
+  struct TrailPoint
+  {
+    double x = 0.0;
+    double y = 0.0;
+    double z = 0.0;
+  };
+
+  struct TrailRing
+  {
+    Esri::ArcGISRuntime::Graphic* trackGraphic = nullptr;
+    Esri::ArcGISRuntime::Graphic* trailGraphic = nullptr;
+    int head = 0;
+    int size = 0;
+    bool dirty = false;
+  };
+
+  struct Cluster
+  {
+    Esri::ArcGISRuntime::Graphic* graphic = nullptr;
+    Esri::ArcGISRuntime::TextSymbol* label = nullptr;
+    int count = 0;
+    double sumX = 0.0;
+    double sumY = 0.0;
+    int shownCount = 0;
+    bool dirty = false;
+  };
+
+  void flushPendingUpdates();
+  void touch(TrackedGraphic& trackedGraphic);
+  void removeTracked(QHash<QString, TrackedGraphic>::iterator it);
+
+  void recordTrailPoint(TrackedGraphic& trackedGraphic, const Esri::ArcGISRuntime::Geometry& geometry);
+  void releaseTrail(int trailSlot);
+  void resetTrails();
+  void refreshTrails();
+  static void simplifyTrail(const QVector<TrailPoint>& points, double tolerance, QVector<bool>& keep);
+
+  void updateVisibility();
+  void connectView();
+  void updateClusterGrid();
+  void rebuildClusters();
+  void addToCluster(TrackedGraphic& trackedGraphic, const Esri::ArcGISRuntime::Geometry& geometry);
+  void removeFromCluster(const TrackedGraphic& trackedGraphic);
+  void markClusterDirty(quint64 key);
+  void refreshClusters();
+  quint64 clusterKey(double x, double y) const;
+
+  void applyCachedSymbol(TrackedGraphic& trackedGraphic, const QString& symbolId);
+  void onSymbolResolved(const QString& key, Esri::ArcGISRuntime::Symbol* symbol);
+
   Esri::ArcGISRuntime::GeoView* m_geoView = nullptr;
   QPointer<Esri::ArcGISRuntime::Renderer> m_renderer;
   Esri::ArcGISRuntime::SurfacePlacement m_surfacePlacement;
 
   Esri::ArcGISRuntime::GraphicsOverlay* m_graphicsOverlay = nullptr;
-  QHash<QString, Esri::ArcGISRuntime::Graphic*> m_existingGraphics;
+  QHash<QString, TrackedGraphic> m_existingGraphics;
+  bool m_visible = true;
+
+  // message IDs ordered from the least to the most recently updated
+  std::list<QString> m_recency;
+  QElapsedTimer m_clock;
+  QTimer* m_expiryTimer = nullptr;
+  int m_maximumAge = 0;
+  quint64 m_expiredCount = 0;
+
+  // the latest update for each message ID which arrived within the minimum update interval
+  QHash<QString, Message> m_pendingUpdates;
+  QTimer* m_updateTimer = nullptr;
+  int m_minimumUpdateInterval = 0;
+  quint64 m_droppedUpdateCount = 0;
+  bool m_flushingUpdates = false;
+
+  // ring buffers of recent positions, trailLength points per slot
+  Esri::ArcGISRuntime::GraphicsOverlay* m_trailsOverlay = nullptr;
+  QTimer* m_trailTimer = nullptr;
+  QVector<TrailPoint> m_trailPoints;
+  QVector<TrailRing> m_trailRings;
+  QVector<int> m_freeTrailSlots;
+  QVector<int> m_dirtyTrailSlots;
+  int m_trailLength = 0;
+  double m_trailTolerance = 0.00001;
+
+  // aggregate graphics for the cells of a world anchored grid, used beyond the cluster scale
+  Esri::ArcGISRuntime::GraphicsOverlay* m_clustersOverlay = nullptr;
+  Esri::ArcGISRuntime::SimpleMarkerSymbol* m_clusterMarker = nullptr;
+  QTimer* m_clusterTimer = nullptr;
+  QTimer* m_clusterGridTimer = nullptr;
+  QHash<quint64, Cluster> m_clusters;
+  QVector<quint64> m_dirtyClusters;
+  Esri::ArcGISRuntime::SpatialReference m_clusterSpatialReference;
+  double m_clusterScale = 0.0;
+  int m_clusterCellSize = 64;
+  double m_clusterCellExtent = 0.0;
+  bool m_clustered = false;
+  bool m_viewConnected = false;
+
+  // shared symbols resolved once per SIDC, used in place of the renderer when set
+  MessageSymbolCache* m_symbolCache = nullptr;
 };
 
 } // Dsa
@@ -0,0 +1,633 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+// PCH header
+#include "pch.hpp"
+
+#include "MessagesPickIndex.h"
+
+// example app headers
+#include "ElevationCache.h"
+#include "MessagesOverlay.h"
+
+// C++ API headers
+#include "GeoView.h"
+#include "Graphic.h"
+#include "GraphicListModel.h"
+#include "GraphicsOverlay.h"
+#include "GraphicsOverlayListModel.h"
+#include "LocationToScreenResult.h"
+#include "MapQuickView.h"
+#include "PictureMarkerSymbol.h"
+#include "Point.h"
+#include "SceneQuickView.h"
+#include "SimpleMarkerSymbol.h"
+#include "SimpleRenderer.h"
+
+// Qt headers
+#include <QQuickItem>
+
+// STL headers
+#include <algorithm>
+#include <cmath>
+
+using namespace Esri::ArcGISRuntime;
+
+namespace Dsa {
+
+// the size of a cell of the screen grid in device independent pixels
+static const double s_cellSize = 64.0;
+
+// half the size at which dictionary (mil2525) symbols are drawn, in device independent pixels
+static const double s_dictionarySymbolHalfSize = 24.0;
+
+// the maximum number of surface elevations requested by the index at any time
+static const int s_maximumElevationRequests = 256;
+
+// the id of the overlay showing the device's own location (see LocationDisplay3d)
+static const QString s_locationOverlayId = QStringLiteral("SCENEVIEWLOCATIONOVERLAY");
+
+/*!
+  \class Dsa::MessagesPickIndex
+  \inmodule Dsa
+  \inherits QObject
+  \brief A screen-space index of the point graphics shown by \l MessagesOverlay objects.
+
+  The location of every message graphic is already known, so the graphics under a screen
+  position can be found without a round-trip to the render engine. The screen position of
+  each graphic is stored in a uniform grid, which answers \l pick synchronously. A graphic
+  is hit anywhere within the square covered by its symbol.
+
+  The index is marked dirty whenever the viewpoint or size of a view changes, or
+  graphics are added to or removed from an overlay, and is rebuilt on the next \l pick.
+  During continuous navigation this means the screen positions are only recomputed
+  when something is actually picked. Graphics which move are only recorded, and just
+  those graphics are placed again on the next \l pick.
+
+  Only the overlays added with \l addOverlay are covered. Callers should fall back to
+  the engine's identify operations for layers, and for graphics overlays which are not
+  covered (see \l hasUncoveredGraphics).
+
+  \note Draped and relative graphics are placed on the surface using the elevation
+  held by the \l ElevationCache. Where no elevation is held yet it is requested, and
+  until it arrives the graphic can only be placed approximately, so callers should
+  also use the engine's identify operations (see \l hasApproximatePlacement).
+ */
+
+/*!
+  \brief Static method to return a singleton instance of the index.
+ */
+MessagesPickIndex* MessagesPickIndex::instance()
+{
+  static MessagesPickIndex s_instance;
+
+  return &s_instance;
+}
+
+/*!
+  \brief Constructor taking an optional \a parent.
+ */
+MessagesPickIndex::MessagesPickIndex(QObject* parent):
+  QObject(parent)
+{
+  connect(ElevationCache::instance(), &ElevationCache::elevationCompleted, this, &MessagesPickIndex::onElevationCompleted);
+  connect(ElevationCache::instance(), &ElevationCache::invalidated, this, [this]()
+  {
+    // requests in progress are discarded by the cache and will not complete
+    m_elevationTasks.clear();
+    invalidate();
+  });
+}
+
+/*!
+  \brief Destructor.
+ */
+MessagesPickIndex::~MessagesPickIndex()
+{
+}
+
+/*!
+  \brief Adds the graphics of \a overlay to the index.
+
+  The overlay is removed again when it is destroyed.
+ */
+void MessagesPickIndex::addOverlay(MessagesOverlay* overlay)
+{
+  if (!overlay || m_overlays.contains(overlay))
+    return;
+
+  m_overlays.append(overlay);
+  m_graphicsOverlays.insert(overlay->graphicsOverlay());
+
+  connect(overlay, &MessagesOverlay::graphicsChanged, this, &MessagesPickIndex::invalidate);
+  connect(overlay, &MessagesOverlay::graphicMoved, this, [this, overlay](Graphic* graphic)
+  {
+    if (!m_dirty)
+      m_movedGraphics.insert(graphic, overlay);
+  });
+  connect(overlay, &MessagesOverlay::visibleChanged, this, &MessagesPickIndex::invalidate);
+  connect(overlay, &MessagesOverlay::clusteredChanged, this, &MessagesPickIndex::invalidate);
+
+  GraphicsOverlay* graphicsOverlay = overlay->graphicsOverlay();
+  connect(overlay, &QObject::destroyed, this, [this, overlay, graphicsOverlay]()
+  {
+    m_overlays.removeAll(QPointer<MessagesOverlay>());
+    m_overlays.removeAll(overlay);
+    m_graphicsOverlays.remove(graphicsOverlay);
+    invalidate();
+  });
+
+  connectView(overlay->geoView());
+  invalidate();
+}
+
+/*!
+  \brief Removes the graphics of \a overlay from the index.
+ */
+void MessagesPickIndex::removeOverlay(MessagesOverlay* overlay)
+{
+  if (!overlay || !m_overlays.contains(overlay))
+    return;
+
+  disconnect(overlay, nullptr, this, nullptr);
+  m_overlays.removeAll(overlay);
+  m_graphicsOverlays.remove(overlay->graphicsOverlay());
+  invalidate();
+}
+
+/*!
+  \brief Returns whether the graphics of \a graphicsOverlay are covered by the index.
+
+  The trails and clusters overlays of the message overlays are also covered. Their
+  graphics have no attributes, so they never produce identify results.
+ */
+bool MessagesPickIndex::covers(GraphicsOverlay* graphicsOverlay) const
+{
+  if (!graphicsOverlay)
+    return false;
+
+  if (m_graphicsOverlays.contains(graphicsOverlay))
+    return true;
+
+  for (const QPointer<MessagesOverlay>& overlay : m_overlays)
+  {
+    if (overlay && (overlay->trailsOverlay() == graphicsOverlay || overlay->clustersOverlay() == graphicsOverlay))
+      return true;
+  }
+
+  return false;
+}
+
+/*!
+  \brief Returns whether \a geoView shows graphics which are not covered by the index.
+
+  When this is \c false, picking the index finds every graphic which an identify
+  of the graphics overlays of \a geoView could return.
+
+  Helper overlays without an id (such as the camera target of the follow tool) and
+  the overlay of the device's own location are not counted. They are still found by
+  an identify when nothing is picked.
+ */
+bool MessagesPickIndex::hasUncoveredGraphics(GeoView* geoView) const
+{
+  if (!geoView || !geoView->graphicsOverlays())
+    return false;
+
+  GraphicsOverlayListModel* graphicsOverlays = geoView->graphicsOverlays();
+  for (int i = 0; i < graphicsOverlays->size(); ++i)
+  {
+    GraphicsOverlay* graphicsOverlay = graphicsOverlays->at(i);
+    if (!graphicsOverlay || !graphicsOverlay->isVisible() || covers(graphicsOverlay))
+      continue;
+
+    if (graphicsOverlay->overlayId().isEmpty() || graphicsOverlay->overlayId() == s_locationOverlayId)
+      continue;
+
+    if (graphicsOverlay->graphics() && graphicsOverlay->graphics()->size() > 0)
+      return true;
+  }
+
+  return false;
+}
+
+/*!
+  \brief Returns whether some of the message graphics in \a geoView could only be placed
+  approximately, because the surface elevation beneath them is not yet known.
+
+  When this is \c true, a \l pick may miss graphics which an identify of the graphics
+  overlays of \a geoView would return.
+ */
+bool MessagesPickIndex::hasApproximatePlacement(GeoView* geoView)
+{
+  refresh();
+
+  return m_approximateViews.contains(geoView);
+}
+
+/*!
+  \brief Returns the message graphics in \a geoView whose symbols are within \a tolerance
+  (in device independent pixels) of \a screenPoint.
+
+  At most \a maximumResults graphics are returned from each overlay, matching the
+  behaviour of \l Esri::ArcGISRuntime::GeoView::identifyGraphicsOverlays. A negative
+  \a maximumResults returns every graphic. The results are ordered by their distance
+  from \a screenPoint, nearest first.
+ */
+QList<MessagesPickIndex::PickResult> MessagesPickIndex::pick(GeoView* geoView, const QPointF& screenPoint,
+                                                             double tolerance, int maximumResults)
+{
+  ++m_pickCount;
+
+  QList<PickResult> results;
+  if (!geoView || maximumResults == 0)
+    return results;
+
+  refresh();
+
+  // graphics are stored in the cell of their anchor, so search as far as the largest symbol reaches
+  tolerance = std::max(0.0, tolerance);
+  const double reach = tolerance + m_maximumHalfSize;
+  const int minColumn = static_cast<int>(std::floor((screenPoint.x() - reach) / s_cellSize));
+  const int maxColumn = static_cast<int>(std::floor((screenPoint.x() + reach) / s_cellSize));
+  const int minRow = static_cast<int>(std::floor((screenPoint.y() - reach) / s_cellSize));
+  const int maxRow = static_cast<int>(std::floor((screenPoint.y() + reach) / s_cellSize));
+
+  for (int column = minColumn; column <= maxColumn; ++column)
+  {
+    for (int row = minRow; row <= maxRow; ++row)
+    {
+      auto findIt = m_grid.constFind(cellKey(column, row));
+      if (findIt == m_grid.constEnd())
+        continue;
+
+      for (const int index : findIt.value())
+      {
+        const Entry& entry = m_entries.at(index);
+        if (!entry.graphic || entry.geoView != geoView)
+          continue;
+
+        const QPointF offset = entry.screenPoint - screenPoint;
+        const double extent = entry.halfSize + tolerance;
+        if (std::abs(offset.x()) > extent || std::abs(offset.y()) > extent)
+          continue;
+
+        const double distance = std::sqrt(offset.x() * offset.x() + offset.y() * offset.y());
+
+        PickResult result;
+        result.graphic = entry.graphic;
+        result.graphicsOverlay = entry.graphicsOverlay;
+        result.distance = distance;
+        results.append(result);
+      }
+    }
+  }
+
+  std::sort(results.begin(), results.end(), [](const PickResult& a, const PickResult& b)
+  {
+    return a.distance < b.distance;
+  });
+
+  if (maximumResults < 0)
+    return results;
+
+  // keep the nearest results from each overlay
+  QHash<GraphicsOverlay*, int> overlayCounts;
+  auto it = results.begin();
+  while (it != results.end())
+  {
+    int& count = overlayCounts[it->graphicsOverlay];
+    if (count >= maximumResults)
+    {
+      it = results.erase(it);
+      continue;
+    }
+
+    ++count;
+    ++it;
+  }
+
+  return results;
+}
+
+/*!
+  \brief Marks the index as out of date, so that it is rebuilt on the next \l pick.
+ */
+void MessagesPickIndex::invalidate()
+{
+  m_dirty = true;
+  m_movedGraphics.clear();
+}
+
+/*!
+  \brief Returns the number of picks answered by the index.
+ */
+quint64 MessagesPickIndex::pickCount() const
+{
+  return m_pickCount;
+}
+
+/*!
+  \brief Returns the number of times the index has been rebuilt.
+ */
+quint64 MessagesPickIndex::rebuildCount() const
+{
+  return m_rebuildCount;
+}
+
+/*!
+  \internal
+
+  Invalidates the index whenever the viewpoint or size of \a geoView changes.
+ */
+void MessagesPickIndex::connectView(GeoView* geoView)
+{
+  QQuickItem* item = dynamic_cast<QQuickItem*>(geoView);
+  if (!item || m_connectedViews.contains(item))
+    return;
+
+  m_connectedViews.insert(item);
+
+  if (SceneQuickView* sceneView = dynamic_cast<SceneQuickView*>(geoView))
+    connect(sceneView, &SceneQuickView::viewpointChanged, this, &MessagesPickIndex::invalidate);
+  else if (MapQuickView* mapView = dynamic_cast<MapQuickView*>(geoView))
+    connect(mapView, &MapQuickView::viewpointChanged, this, &MessagesPickIndex::invalidate);
+
+  connect(item, &QQuickItem::widthChanged, this, &MessagesPickIndex::invalidate);
+  connect(item, &QQuickItem::heightChanged, this, &MessagesPickIndex::invalidate);
+  connect(item, &QObject::destroyed, this, [this, item]()
+  {
+    m_connectedViews.remove(item);
+    invalidate();
+  });
+}
+
+/*!
+  \internal
+
+  Brings the index up to date: rebuilds it if it is dirty, or otherwise places
+  the graphics which have moved since it was last used.
+ */
+void MessagesPickIndex::refresh()
+{
+  if (m_dirty)
+    rebuild();
+  else if (!m_movedGraphics.isEmpty())
+    updateMovedGraphics();
+}
+
+/*!
+  \internal
+
+  Recomputes the screen position of every graphic in the covered overlays.
+ */
+void MessagesPickIndex::rebuild()
+{
+  m_entries.clear();
+  m_grid.clear();
+  m_entryIndexes.clear();
+  m_movedGraphics.clear();
+  m_approximateViews.clear();
+  m_maximumHalfSize = 0.0;
+
+  // requests which fail never complete, so do not let them block new ones forever
+  if (m_elevationTasks.size() >= s_maximumElevationRequests)
+    m_elevationTasks.clear();
+
+  for (const QPointer<MessagesOverlay>& overlay : qAsConst(m_overlays))
+  {
+    // clustered overlays do not show their individual graphics
+    if (overlay && overlay->isVisible() && !overlay->isClustered())
+      indexOverlay(overlay.data());
+  }
+
+  m_dirty = false;
+  ++m_rebuildCount;
+}
+
+/*!
+  \internal
+
+  Adds the visible point graphics of \a overlay which are on screen to the grid.
+ */
+void MessagesPickIndex::indexOverlay(MessagesOverlay* overlay)
+{
+  const double halfSize = symbolHalfSize(overlay);
+  m_maximumHalfSize = std::max(m_maximumHalfSize, halfSize);
+
+  GraphicListModel* graphics = overlay->graphicsOverlay()->graphics();
+  for (int i = 0; i < graphics->size(); ++i)
+  {
+    Graphic* graphic = graphics->at(i);
+    QPointF screenPoint;
+    if (placeGraphic(overlay, graphic, screenPoint))
+      addEntry(overlay, graphic, screenPoint, halfSize);
+  }
+}
+
+/*!
+  \internal
+
+  Places the graphics which have moved since the index was last used again,
+  without visiting the graphics which have not.
+
+  Adding or removing graphics marks the whole index dirty, so every moved
+  graphic is still held by its overlay.
+ */
+void MessagesPickIndex::updateMovedGraphics()
+{
+  for (auto it = m_movedGraphics.cbegin(); it != m_movedGraphics.cend(); ++it)
+  {
+    Graphic* graphic = it.key();
+    MessagesOverlay* overlay = it.value();
+
+    auto findIt = m_entryIndexes.constFind(graphic);
+    if (findIt != m_entryIndexes.constEnd())
+      removeEntry(findIt.value());
+
+    // clustered and hidden overlays are not indexed
+    if (!overlay->isVisible() || overlay->isClustered())
+      continue;
+
+    QPointF screenPoint;
+    if (placeGraphic(overlay, graphic, screenPoint))
+    {
+      const double halfSize = symbolHalfSize(overlay);
+      m_maximumHalfSize = std::max(m_maximumHalfSize, halfSize);
+      addEntry(overlay, graphic, screenPoint, halfSize);
+    }
+  }
+
+  m_movedGraphics.clear();
+}
+
+/*!
+  \internal
+
+  Writes the screen position of \a graphic of \a overlay to \a screenPoint.
+  Returns \c false if the graphic is not a visible point on or near the screen.
+
+  In a scene, draped and relative graphics are placed on the surface using the
+  elevation held by the \l ElevationCache. If none is held, the elevation is
+  requested and the graphic is placed approximately in the meantime.
+ */
+bool MessagesPickIndex::placeGraphic(MessagesOverlay* overlay, Graphic* graphic, QPointF& screenPoint)
+{
+  if (!graphic || !graphic->isVisible())
+    return false;
+
+  const Geometry geometry = graphic->geometry();
+  if (geometry.isEmpty() || geometry.geometryType() != GeometryType::Point)
+    return false;
+
+  GeoView* geoView = overlay->geoView();
+  QQuickItem* item = dynamic_cast<QQuickItem*>(geoView);
+  if (!item)
+    return false;
+
+  Point location(geometry);
+  if (SceneView* sceneView = dynamic_cast<SceneView*>(geoView))
+  {
+    const SurfacePlacement surfacePlacement = overlay->surfacePlacement();
+    if (surfacePlacement != SurfacePlacement::Absolute)
+    {
+      // the index samples every graphic, so it must not skew the cache's hit rate
+      double elevation = 0.0;
+      if (ElevationCache::instance()->peekElevation(location, elevation))
+      {
+        const double z = surfacePlacement == SurfacePlacement::Relative ? location.z() + elevation : elevation;
+        location = Point(location.x(), location.y(), z, location.spatialReference());
+      }
+      else
+      {
+        m_approximateViews.insert(geoView);
+        if (m_elevationTasks.size() < s_maximumElevationRequests)
+        {
+          const QUuid taskId = ElevationCache::instance()->requestElevation(location);
+          if (!taskId.isNull())
+            m_elevationTasks.insert(taskId);
+        }
+      }
+    }
+
+    const LocationToScreenResult screenResult = sceneView->locationToScreen(location);
+    if (screenResult.visibility() != SceneLocationVisibility::Visible)
+      return false;
+
+    screenPoint = screenResult.screenPoint();
+  }
+  else if (MapView* mapView = dynamic_cast<MapView*>(geoView))
+  {
+    screenPoint = mapView->locationToScreen(location);
+  }
+  else
+  {
+    return false;
+  }
+
+  const QRectF bounds(-s_cellSize, -s_cellSize, item->width() + 2.0 * s_cellSize, item->height() + 2.0 * s_cellSize);
+  return bounds.contains(screenPoint);
+}
+
+/*!
+  \internal
+
+  Adds \a graphic of \a overlay at \a screenPoint to the grid.
+ */
+void MessagesPickIndex::addEntry(MessagesOverlay* overlay, Graphic* graphic, const QPointF& screenPoint, double halfSize)
+{
+  Entry entry;
+  entry.graphic = graphic;
+  entry.graphicsOverlay = overlay->graphicsOverlay();
+  entry.geoView = overlay->geoView();
+  entry.screenPoint = screenPoint;
+  entry.halfSize = halfSize;
+  m_entries.append(entry);
+  m_entryIndexes.insert(graphic, m_entries.size() - 1);
+
+  const int column = static_cast<int>(std::floor(screenPoint.x() / s_cellSize));
+  const int row = static_cast<int>(std::floor(screenPoint.y() / s_cellSize));
+  m_grid[cellKey(column, row)].append(m_entries.size() - 1);
+}
+
+/*!
+  \internal
+
+  Removes the entry at \a index from the grid. The slot is left empty, so that
+  the indexes of the other entries do not change.
+ */
+void MessagesPickIndex::removeEntry(int index)
+{
+  Entry& entry = m_entries[index];
+  m_entryIndexes.remove(entry.graphic);
+
+  const int column = static_cast<int>(std::floor(entry.screenPoint.x() / s_cellSize));
+  const int row = static_cast<int>(std::floor(entry.screenPoint.y() / s_cellSize));
+  auto cellIt = m_grid.find(cellKey(column, row));
+  if (cellIt != m_grid.end())
+  {
+    cellIt.value().removeOne(index);
+    if (cellIt.value().isEmpty())
+      m_grid.erase(cellIt);
+  }
+
+  entry.graphic = nullptr;
+}
+
+/*!
+  \internal
+
+  Places the graphics again once an elevation requested by the index with \a taskId
+  has arrived.
+ */
+void MessagesPickIndex::onElevationCompleted(const QUuid& taskId)
+{
+  if (m_elevationTasks.remove(taskId))
+    invalidate();
+}
+
+/*!
+  \internal
+
+  Returns half the size, in device independent pixels, at which the renderer of
+  \a overlay draws its symbols.
+ */
+double MessagesPickIndex::symbolHalfSize(MessagesOverlay* overlay)
+{
+  SimpleRenderer* simpleRenderer = dynamic_cast<SimpleRenderer*>(overlay->renderer());
+  if (simpleRenderer)
+  {
+    if (PictureMarkerSymbol* pictureSymbol = dynamic_cast<PictureMarkerSymbol*>(simpleRenderer->symbol()))
+      return std::max(pictureSymbol->width(), pictureSymbol->height()) / 2.0;
+
+    if (SimpleMarkerSymbol* markerSymbol = dynamic_cast<SimpleMarkerSymbol*>(simpleRenderer->symbol()))
+      return markerSymbol->size() / 2.0;
+  }
+
+  // dictionary symbols, and any other renderer, are drawn at about the mil2525 size
+  return s_dictionarySymbolHalfSize;
+}
+
+/*!
+  \internal
+
+  Returns the key of the grid cell at \a column and \a row.
+ */
+quint64 MessagesPickIndex::cellKey(int column, int row)
+{
+  return (static_cast<quint64>(static_cast<quint32>(column)) << 32) | static_cast<quint32>(row);
+}
+
+} // Dsa
@@ -0,0 +1,115 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef MESSAGESPICKINDEX_H
+#define MESSAGESPICKINDEX_H
+
+// Qt headers
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPointF>
+#include <QPointer>
+#include <QSet>
+#include <QUuid>
+#include <QVector>
+
+namespace Esri {
+namespace ArcGISRuntime {
+class GeoView;
+class Graphic;
+class GraphicsOverlay;
+}
+}
+
+namespace Dsa {
+
+class MessagesOverlay;
+
+class MessagesPickIndex : public QObject
+{
+  Q_OBJECT
+
+public:
+  struct PickResult
+  {
+    Esri::ArcGISRuntime::Graphic* graphic = nullptr;
+    Esri::ArcGISRuntime::GraphicsOverlay* graphicsOverlay = nullptr;
+    double distance = 0.0;
+  };
+
+  static MessagesPickIndex* instance();
+
+  ~MessagesPickIndex();
+
+  void addOverlay(MessagesOverlay* overlay);
+  void removeOverlay(MessagesOverlay* overlay);
+
+  bool covers(Esri::ArcGISRuntime::GraphicsOverlay* graphicsOverlay) const;
+  bool hasUncoveredGraphics(Esri::ArcGISRuntime::GeoView* geoView) const;
+  bool hasApproximatePlacement(Esri::ArcGISRuntime::GeoView* geoView);
+
+  QList<PickResult> pick(Esri::ArcGISRuntime::GeoView* geoView, const QPointF& screenPoint,
+                         double tolerance, int maximumResults);
+
+  void invalidate();
+
+  quint64 pickCount() const;
+  quint64 rebuildCount() const;
+
+private:
+  struct Entry
+  {
+    // a null graphic marks an entry which has moved off screen
+    Esri::ArcGISRuntime::Graphic* graphic = nullptr;
+    Esri::ArcGISRuntime::GraphicsOverlay* graphicsOverlay = nullptr;
+    Esri::ArcGISRuntime::GeoView* geoView = nullptr;
+    QPointF screenPoint;
+    double halfSize = 0.0;
+  };
+
+  MessagesPickIndex(QObject* parent = nullptr);
+
+  void connectView(Esri::ArcGISRuntime::GeoView* geoView);
+  void refresh();
+  void rebuild();
+  void indexOverlay(MessagesOverlay* overlay);
+  void updateMovedGraphics();
+  bool placeGraphic(MessagesOverlay* overlay, Esri::ArcGISRuntime::Graphic* graphic, QPointF& screenPoint);
+  void addEntry(MessagesOverlay* overlay, Esri::ArcGISRuntime::Graphic* graphic, const QPointF& screenPoint, double halfSize);
+  void removeEntry(int index);
+  void onElevationCompleted(const QUuid& taskId);
+  static double symbolHalfSize(MessagesOverlay* overlay);
+  static quint64 cellKey(int column, int row);
+
+  QList<QPointer<MessagesOverlay>> m_overlays;
+  QSet<Esri::ArcGISRuntime::GraphicsOverlay*> m_graphicsOverlays;
+  QSet<QObject*> m_connectedViews;
+  QVector<Entry> m_entries;
+  QHash<quint64, QVector<int>> m_grid;
+  QHash<Esri::ArcGISRuntime::Graphic*, int> m_entryIndexes;
+  QHash<Esri::ArcGISRuntime::Graphic*, MessagesOverlay*> m_movedGraphics;
+  QSet<QUuid> m_elevationTasks;
+  QSet<Esri::ArcGISRuntime::GeoView*> m_approximateViews;
+  double m_maximumHalfSize = 0.0;
+  bool m_dirty = true;
+  quint64 m_pickCount = 0;
+  quint64 m_rebuildCount = 0;
+};
+
+} // Dsa
+
+#endif // MESSAGESPICKINDEX_H
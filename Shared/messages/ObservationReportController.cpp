@@ -96,7 +96,8 @@ QString ObservationReportController::toolName() const
  *
  * \list
  *  \li \c ObservationReportConfig. A JSON object describing options for the observation report including
- * the \c port.
+ * the \c port, an optional \c multicastGroup to send reports to instead of broadcasting them,
+ * and the optional message \c encoding (\c "geomessage" or \c "binary").
  *  \li \c UserName. The user name (observed by) for observation reports.
  * \endlist
  */
@@ -115,6 +116,14 @@ void ObservationReportController::setProperties(const QVariantMap& properties)
     if (ok)
       setUdpPort(newPort);
   }
+
+  auto findMulticastGroupIt = observationReportConfig.find(MessageFeedConstants::OBSERVATION_REPORT_CONFIG_MULTICAST_GROUP);
+  if (findMulticastGroupIt != observationReportConfig.end())
+    setMulticastGroup(QHostAddress(findMulticastGroupIt.value().toString()));
+
+  auto findEncodingIt = observationReportConfig.find(MessageFeedConstants::OBSERVATION_REPORT_CONFIG_ENCODING);
+  if (findEncodingIt != observationReportConfig.end())
+    setMessageEncoding(Message::toMessageEncoding(findEncodingIt.value().toString()));
 }
 
 /*!
@@ -297,11 +306,12 @@ void ObservationReportController::broadcastReport(const QString& size,
     m_dataSender = new DataSender(this);
 
     QUdpSocket* udpSocket = new QUdpSocket(m_dataSender);
-    udpSocket->connectToHost(QHostAddress::Broadcast, m_udpPort, QIODevice::WriteOnly);
+    const QHostAddress destination = m_multicastGroup.isNull() ? QHostAddress(QHostAddress::Broadcast) : m_multicastGroup;
+    udpSocket->connectToHost(destination, m_udpPort, QIODevice::WriteOnly);
     m_dataSender->setDevice(udpSocket);
   }
 
-  m_dataSender->sendData(observationReport.toGeoMessage());
+  m_dataSender->sendData(observationReport.encode(m_messageEncoding));
 }
 
 /*!
@@ -334,6 +344,43 @@ void ObservationReportController::setUdpPort(int port)
   m_udpPort = port;
 }
 
+/*!
+  \brief Returns the multicast group observation reports are sent to, or a
+  null address if they are broadcast.
+ */
+QHostAddress ObservationReportController::multicastGroup() const
+{
+  return m_multicastGroup;
+}
+
+/*!
+  \brief Sets the multicast group observation reports are sent to to \a multicastGroup.
+
+  Only multicast addresses are accepted. Any other address broadcasts the reports.
+ */
+void ObservationReportController::setMulticastGroup(const QHostAddress& multicastGroup)
+{
+  m_multicastGroup = multicastGroup.isMulticast() ? multicastGroup : QHostAddress();
+}
+
+/*!
+  \brief Returns the encoding in which observation reports are broadcast.
+
+  The default is Message::MessageEncoding::GeoMessage.
+ */
+Message::MessageEncoding ObservationReportController::messageEncoding() const
+{
+  return m_messageEncoding;
+}
+
+/*!
+  \brief Sets the encoding in which observation reports are broadcast to \a messageEncoding.
+ */
+void ObservationReportController::setMessageEncoding(Message::MessageEncoding messageEncoding)
+{
+  m_messageEncoding = messageEncoding;
+}
+
 /*!
   \brief Sets the geoView to be used by the tool to \a geoView.
  */
@@ -17,12 +17,18 @@
 #ifndef OBSERVATIONREPORTCONTROLLER_H
 #define OBSERVATIONREPORTCONTROLLER_H
 
+// example app headers
+#include "Message.h"
+
 // toolkit headers
 #include "AbstractTool.h"
 
 // C++ API headers
 #include "Point.h"
 
+// Qt headers
+#include <QHostAddress>
+
 class QDateTime;
 class QMouseEvent;
 
@@ -81,6 +87,12 @@ public:
   int udpPort() const;
   void setUdpPort(int port);
 
+  QHostAddress multicastGroup() const;
+  void setMulticastGroup(const QHostAddress& multicastGroup);
+
+  Message::MessageEncoding messageEncoding() const;
+  void setMessageEncoding(Message::MessageEncoding messageEncoding);
+
 signals:
   void observedByChanged();
   void controlPointChanged();
@@ -102,6 +114,8 @@ private:
   PointHighlighter* m_highlighter = nullptr;
   bool m_controlPointSet = false;
   int m_udpPort = -1;
+  QHostAddress m_multicastGroup;
+  Message::MessageEncoding m_messageEncoding = Message::MessageEncoding::GeoMessage;
   bool m_pickMode = false;
 
   QMetaObject::Connection m_mouseClickConnection;
@@ -0,0 +1,136 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "DataCapture.h"
+
+// Qt headers
+#include <QDateTime>
+
+namespace Dsa {
+
+const QByteArray DataCapture::FILE_TAG = QByteArrayLiteral("DSAC");
+const quint8 DataCapture::FILE_VERSION = 1;
+const QString DataCapture::FILE_EXTENSION = QStringLiteral("dsacap");
+
+/*!
+  \class Dsa::DataCapture
+  \inmodule Dsa
+  \inherits QObject
+  \brief Utility class for recording received datagrams to a file.
+
+  The file starts with \l FILE_TAG, \l FILE_VERSION and the capture start
+  time in milliseconds since the epoch. Each datagram follows as its arrival
+  time in microseconds since the start, the port it was received on, its
+  size and its bytes, all big-endian.
+
+  Capture files are conventionally named with the \l FILE_EXTENSION suffix
+  (\c .dsacap), which the message simulator accepts alongside message files.
+  The file can be replayed with \l DataCaptureReader.
+ */
+
+/*!
+  \brief Constructor taking an optional \a parent.
+ */
+DataCapture::DataCapture(QObject* parent) :
+  QObject(parent)
+{
+}
+
+/*!
+  \brief Destructor.
+ */
+DataCapture::~DataCapture()
+{
+  stop();
+}
+
+/*!
+  \brief Starts a new capture in the file at \a filePath, replacing any
+  existing file.
+
+  Returns \c false if the file could not be opened.
+ */
+bool DataCapture::start(const QString& filePath)
+{
+  stop();
+
+  m_file.setFileName(filePath);
+  if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    return false;
+
+  m_stream.setDevice(&m_file);
+  m_stream.writeRawData(FILE_TAG.constData(), FILE_TAG.size());
+  m_stream << FILE_VERSION << static_cast<qint64>(QDateTime::currentMSecsSinceEpoch());
+
+  m_capturedCount = 0;
+  m_clock.start();
+
+  return true;
+}
+
+/*!
+  \brief Stops the current capture and closes its file.
+ */
+void DataCapture::stop()
+{
+  if (!m_file.isOpen())
+    return;
+
+  m_stream.setDevice(nullptr);
+  m_file.close();
+}
+
+/*!
+  \brief Returns whether a capture is in progress.
+ */
+bool DataCapture::isCapturing() const
+{
+  return m_file.isOpen();
+}
+
+/*!
+  \brief Returns the path of the current or last capture file.
+ */
+QString DataCapture::filePath() const
+{
+  return m_file.fileName();
+}
+
+/*!
+  \brief Records \a data received on \a port with the current time.
+
+  Does nothing if no capture is in progress.
+ */
+void DataCapture::capture(const QByteArray& data, quint16 port)
+{
+  if (!m_file.isOpen())
+    return;
+
+  m_stream << static_cast<qint64>(m_clock.nsecsElapsed() / 1000) << port << static_cast<quint32>(data.size());
+  m_stream.writeRawData(data.constData(), data.size());
+
+  ++m_capturedCount;
+}
+
+/*!
+  \brief Returns the number of datagrams recorded by the current or last capture.
+ */
+quint64 DataCapture::capturedCount() const
+{
+  return m_capturedCount;
+}
+
+} // Dsa
@@ -0,0 +1,61 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef DATACAPTURE_H
+#define DATACAPTURE_H
+
+// Qt headers
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QObject>
+
+namespace Dsa {
+
+class DataCapture : public QObject
+{
+  Q_OBJECT
+
+public:
+  static const QByteArray FILE_TAG;
+  static const quint8 FILE_VERSION;
+  static const QString FILE_EXTENSION;
+
+  explicit DataCapture(QObject* parent = nullptr);
+  ~DataCapture();
+
+  bool start(const QString& filePath);
+  void stop();
+  bool isCapturing() const;
+
+  QString filePath() const;
+
+  void capture(const QByteArray& data, quint16 port);
+
+  quint64 capturedCount() const;
+
+private:
+  Q_DISABLE_COPY(DataCapture)
+
+  QFile m_file;
+  QDataStream m_stream;
+  QElapsedTimer m_clock;
+  quint64 m_capturedCount = 0;
+};
+
+} // Dsa
+
+#endif // DATACAPTURE_H
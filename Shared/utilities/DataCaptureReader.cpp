@@ -0,0 +1,195 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "DataCaptureReader.h"
+
+// example app headers
+#include "DataCapture.h"
+
+namespace Dsa {
+
+// datagrams larger than this can not have been received over UDP
+static const quint32 s_maximumDatagramSize = 65536;
+
+/*!
+  \class Dsa::DataCaptureReader
+  \inmodule Dsa
+  \inherits QObject
+  \brief Utility class for reading the datagrams recorded by \l DataCapture.
+ */
+
+/*!
+  \brief Constructor taking an optional \a parent.
+ */
+DataCaptureReader::DataCaptureReader(QObject* parent) :
+  QObject(parent)
+{
+}
+
+/*!
+  \brief Destructor.
+ */
+DataCaptureReader::~DataCaptureReader()
+{
+  close();
+}
+
+/*!
+  \brief Returns whether the file at \a filePath starts with the capture file tag.
+ */
+bool DataCaptureReader::isCaptureFile(const QString& filePath)
+{
+  QFile file(filePath);
+  if (!file.open(QIODevice::ReadOnly))
+    return false;
+
+  return file.read(DataCapture::FILE_TAG.size()) == DataCapture::FILE_TAG;
+}
+
+/*!
+  \brief Opens the capture file at \a filePath.
+
+  Returns \c false if the file could not be opened or is not a capture
+  file of a known version.
+ */
+bool DataCaptureReader::open(const QString& filePath)
+{
+  close();
+
+  m_file.setFileName(filePath);
+  if (!m_file.open(QIODevice::ReadOnly))
+    return false;
+
+  m_stream.setDevice(&m_file);
+  if (!readHeader())
+  {
+    close();
+    return false;
+  }
+
+  return true;
+}
+
+/*!
+  \brief Closes the capture file.
+ */
+void DataCaptureReader::close()
+{
+  if (!m_file.isOpen())
+    return;
+
+  m_stream.setDevice(nullptr);
+  m_file.close();
+  m_data.clear();
+}
+
+/*!
+  \brief Reads the next datagram, returning \c false at the end of the file
+  or if the file is truncated.
+ */
+bool DataCaptureReader::readNext()
+{
+  if (atEnd())
+    return false;
+
+  qint64 timestamp = 0;
+  quint16 port = 0;
+  quint32 size = 0;
+  m_stream >> timestamp >> port >> size;
+  if (m_stream.status() != QDataStream::Ok || size > s_maximumDatagramSize)
+    return false;
+
+  QByteArray data(static_cast<int>(size), Qt::Uninitialized);
+  if (m_stream.readRawData(data.data(), data.size()) != data.size())
+    return false;
+
+  m_timestamp = timestamp;
+  m_port = port;
+  m_data = data;
+
+  return true;
+}
+
+/*!
+  \brief Returns whether all datagrams have been read.
+ */
+bool DataCaptureReader::atEnd() const
+{
+  return !m_file.isOpen() || m_stream.atEnd() || m_stream.status() != QDataStream::Ok;
+}
+
+/*!
+  \brief Rewinds to the first datagram.
+ */
+void DataCaptureReader::reset()
+{
+  if (!m_file.isOpen())
+    return;
+
+  m_file.seek(0);
+  m_stream.resetStatus();
+  readHeader();
+}
+
+/*!
+  \brief Returns the capture start time in milliseconds since the epoch.
+ */
+qint64 DataCaptureReader::startTime() const
+{
+  return m_startTime;
+}
+
+/*!
+  \brief Returns the arrival time of the current datagram in microseconds
+  since the capture started.
+ */
+qint64 DataCaptureReader::timestamp() const
+{
+  return m_timestamp;
+}
+
+/*!
+  \brief Returns the port the current datagram was received on.
+ */
+quint16 DataCaptureReader::port() const
+{
+  return m_port;
+}
+
+/*!
+  \brief Returns the bytes of the current datagram.
+ */
+QByteArray DataCaptureReader::data() const
+{
+  return m_data;
+}
+
+/*!
+  \internal
+ */
+bool DataCaptureReader::readHeader()
+{
+  QByteArray tag(DataCapture::FILE_TAG.size(), Qt::Uninitialized);
+  if (m_stream.readRawData(tag.data(), tag.size()) != tag.size() || tag != DataCapture::FILE_TAG)
+    return false;
+
+  quint8 version = 0;
+  m_stream >> version >> m_startTime;
+
+  return m_stream.status() == QDataStream::Ok && version == DataCapture::FILE_VERSION;
+}
+
+} // Dsa
@@ -0,0 +1,65 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef DATACAPTUREREADER_H
+#define DATACAPTUREREADER_H
+
+// Qt headers
+#include <QDataStream>
+#include <QFile>
+#include <QObject>
+
+namespace Dsa {
+
+class DataCaptureReader : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit DataCaptureReader(QObject* parent = nullptr);
+  ~DataCaptureReader();
+
+  static bool isCaptureFile(const QString& filePath);
+
+  bool open(const QString& filePath);
+  void close();
+
+  bool readNext();
+  bool atEnd() const;
+  void reset();
+
+  qint64 startTime() const;
+
+  qint64 timestamp() const;
+  quint16 port() const;
+  QByteArray data() const;
+
+private:
+  Q_DISABLE_COPY(DataCaptureReader)
+
+  bool readHeader();
+
+  QFile m_file;
+  QDataStream m_stream;
+  qint64 m_startTime = 0;
+  qint64 m_timestamp = 0;
+  quint16 m_port = 0;
+  QByteArray m_data;
+};
+
+} // Dsa
+
+#endif // DATACAPTUREREADER_H
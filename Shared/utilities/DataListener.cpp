@@ -148,9 +148,14 @@ bool DataListener::processUdpDatagrams()
     while (udpSocket->hasPendingDatagrams())
     {
       QByteArray datagram;
-      datagram.resize(udpSocket->pendingDatagramSize());
-      udpSocket->readDatagram(datagram.data(), datagram.size());
-      emit dataReceived(datagram.data());
+      datagram.resize(static_cast<int>(udpSocket->pendingDatagramSize()));
+      const qint64 size = udpSocket->readDatagram(datagram.data(), datagram.size());
+      if (size < 0)
+        continue;
+
+      // emit the array itself, since binary datagrams may contain null bytes
+      datagram.resize(static_cast<int>(size));
+      emit dataReceived(datagram);
     }
 
     return true;